@@ -0,0 +1,22 @@
+#ifndef ASTRONODE_BOARD_H
+#define ASTRONODE_BOARD_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Astrocast
+#include "astronode_context.h"
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Return the physical layer of the Astronode wired to the board, for astronode_ctx_init().
+ * Apart from drivers.h, which the library includes for the logs and the systick.
+ */
+const astronode_uart_ops_t *get_astronode_uart_ops(void);
+
+
+#endif /* ASTRONODE_BOARD_H */
@@ -28,6 +28,15 @@
 #define PIN_RESET_GPIO      GPIO_PIN_11
 #define PORT_RESET_GPIO     GPIOA
 
+// Internal temperature sensor on ADC1, calibrated in factory at 30 and 110 degrees with VDDA at 3.0 V.
+#define ADC_CHANNEL_TEMPERATURE         17
+#define ADC_TEMPERATURE_CAL1            (*(const uint16_t *) 0x1FFF75A8)
+#define ADC_TEMPERATURE_CAL1_DEGREES    30
+#define ADC_TEMPERATURE_CAL2            (*(const uint16_t *) 0x1FFF75CA)
+#define ADC_TEMPERATURE_CAL2_DEGREES    110
+#define ADC_TEMPERATURE_CAL_VDDA_MV     3000
+#define ADC_VDDA_MV                     3300
+
 
 //------------------------------------------------------------------------------
 // Type definitions
@@ -53,9 +62,17 @@ bool is_evt_pin_high(void);
 
 void reset_astronode(void);
 
+int32_t read_sensor_value(void);
+
+uint32_t get_device_uid(void);
+
 
 uint32_t get_systick(void);
 
 bool is_systick_timeout_over(uint32_t starting_value, uint16_t duration);
 
+void enter_sleep_mode(uint32_t duration);
+
+void wait_in_sleep_mode(uint32_t duration);
+
 #endif /* DRIVERS_H */
@@ -10,6 +10,9 @@
 #include "stm32l4xx_hal.h"
 #include "drivers.h"
 
+// Astrocast
+#include "astronode_board.h"
+
 
 //------------------------------------------------------------------------------
 // Global variable definitions
@@ -26,8 +29,13 @@ uint8_t g_number_of_message_to_send = 0;
 static void MX_GPIO_Init(void);
 static void MX_USART1_UART_Init(void);
 static void MX_USART2_UART_Init(void);
+static void MX_ADC1_Init(void);
 void SystemClock_Config(void);
 void Error_Handler(void);
+static void send_astronode_request_on_port(void *p_port, uint8_t *p_tx_buffer, uint32_t length);
+static bool is_astronode_character_received_on_port(void *p_port, uint8_t *p_rx_char);
+static bool is_evt_pin_high_on_port(void *p_port);
+static void reset_astronode_on_port(void *p_port);
 
 
 //------------------------------------------------------------------------------
@@ -59,6 +67,29 @@ void reset_astronode(void)
     HAL_Delay(250);
 }
 
+int32_t read_sensor_value(void)
+{
+    // The example samples the internal temperature sensor of the MCU, in tenths of degree:
+    // replace with the acquisition of the asset sensor.
+    ADC1->ISR = ADC_ISR_EOC;
+    ADC1->CR |= ADC_CR_ADSTART;
+    while ((ADC1->ISR & ADC_ISR_EOC) == 0)
+    {
+    }
+
+    int32_t raw = (int32_t) (ADC1->DR * ADC_VDDA_MV / ADC_TEMPERATURE_CAL_VDDA_MV);
+
+    return ADC_TEMPERATURE_CAL1_DEGREES * 10
+           + (raw - ADC_TEMPERATURE_CAL1) * (ADC_TEMPERATURE_CAL2_DEGREES - ADC_TEMPERATURE_CAL1_DEGREES) * 10
+             / (ADC_TEMPERATURE_CAL2 - ADC_TEMPERATURE_CAL1);
+}
+
+uint32_t get_device_uid(void)
+{
+    // 96-bit unique ID of the MCU, folded.
+    return HAL_GetUIDw0() ^ HAL_GetUIDw1() ^ HAL_GetUIDw2();
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
@@ -104,6 +135,40 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_PIN)
     g_number_of_message_to_send++;
 }
 
+/**
+  * @brief ADC1 Initialization Function, single conversions of the temperature sensor.
+  * The HAL ADC driver is not part of the project, the registers are written directly.
+  * @param None
+  * @retval None
+  */
+static void MX_ADC1_Init(void)
+{
+    RCC->AHB2ENR |= RCC_AHB2ENR_ADCEN;
+
+    // Synchronous clock HCLK / 2, temperature sensor path enabled.
+    ADC123_COMMON->CCR |= ADC_CCR_CKMODE_1 | ADC_CCR_TSEN;
+
+    // Leave the deep power down and start the voltage regulator (20 us).
+    ADC1->CR &= ~ADC_CR_DEEPPWD;
+    ADC1->CR |= ADC_CR_ADVREGEN;
+    HAL_Delay(1);
+
+    ADC1->CR |= ADC_CR_ADCAL;
+    while (ADC1->CR & ADC_CR_ADCAL)
+    {
+    }
+
+    ADC1->ISR = ADC_ISR_ADRDY;
+    ADC1->CR |= ADC_CR_ADEN;
+    while ((ADC1->ISR & ADC_ISR_ADRDY) == 0)
+    {
+    }
+
+    // The sensor needs at least 5 us of sampling: longest sampling time, 640.5 cycles.
+    ADC1->SMPR2 |= ADC_SMPR2_SMP17;
+    ADC1->SQR1 = ADC_CHANNEL_TEMPERATURE << ADC_SQR1_SQ1_Pos;
+}
+
 /**
   * @brief USART1 Initialization Function
   * @param None
@@ -216,6 +281,7 @@ void init_drivers(void)
     MX_GPIO_Init();
     MX_USART1_UART_Init();
     MX_USART2_UART_Init();
+    MX_ADC1_Init();
 }
 
 void send_debug_logs(char *p_tx_buffer)
@@ -242,7 +308,57 @@ void send_astronode_request(uint8_t *p_tx_buffer, uint32_t length)
 
 bool is_astronode_character_received(uint8_t *p_rx_char)
 {
-    return (HAL_UART_Receive(&huart1, p_rx_char, 1, 100) == HAL_OK ? true : false);
+    // Polled without waiting: the transport times the answer and the gaps between its bytes.
+    // An overrun stops the reception until it is cleared, the answer then fails its checks.
+    if (__HAL_UART_GET_FLAG(&huart1, UART_FLAG_ORE))
+    {
+        __HAL_UART_CLEAR_OREFLAG(&huart1);
+    }
+    if (__HAL_UART_GET_FLAG(&huart1, UART_FLAG_RXNE) == RESET)
+    {
+        return false;
+    }
+
+    *p_rx_char = (uint8_t) huart1.Instance->RDR;
+    return true;
+}
+
+// This board drives a single Astronode on USART1, the port is not used.
+static void send_astronode_request_on_port(void *p_port, uint8_t *p_tx_buffer, uint32_t length)
+{
+    (void) p_port;
+    send_astronode_request(p_tx_buffer, length);
+}
+
+static bool is_astronode_character_received_on_port(void *p_port, uint8_t *p_rx_char)
+{
+    (void) p_port;
+    return is_astronode_character_received(p_rx_char);
+}
+
+static bool is_evt_pin_high_on_port(void *p_port)
+{
+    (void) p_port;
+    return is_evt_pin_high();
+}
+
+static void reset_astronode_on_port(void *p_port)
+{
+    (void) p_port;
+    reset_astronode();
+}
+
+const astronode_uart_ops_t *get_astronode_uart_ops(void)
+{
+    static const astronode_uart_ops_t uart_ops =
+    {
+        .send_request = send_astronode_request_on_port,
+        .is_character_received = is_astronode_character_received_on_port,
+        .is_evt_pin_high = is_evt_pin_high_on_port,
+        .reset = reset_astronode_on_port
+    };
+
+    return &uart_ops;
 }
 
 uint32_t get_systick(void)
@@ -253,4 +369,30 @@ uint32_t get_systick(void)
 bool is_systick_timeout_over(uint32_t starting_value, uint16_t duration)
 {
     return (get_systick() - starting_value > duration) ? true : false;
+}
+
+void enter_sleep_mode(uint32_t duration)
+{
+    uint32_t starting_value = get_systick();
+
+    // The core is woken up by the systick, the EXTI of the button or any other interrupt.
+    while (get_systick() - starting_value < duration)
+    {
+        if (is_evt_pin_high() || g_number_of_message_to_send > 0)
+        {
+            return;
+        }
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    }
+}
+
+void wait_in_sleep_mode(uint32_t duration)
+{
+    uint32_t starting_value = get_systick();
+
+    // Unlike enter_sleep_mode(), only the end of the duration ends the wait.
+    while (get_systick() - starting_value < duration)
+    {
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    }
 }
\ No newline at end of file
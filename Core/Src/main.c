@@ -9,15 +9,75 @@
 
 // Astrocast
 #include "main.h"
+#include "astronode_aggregator.h"
 #include "astronode_application.h"
+#include "astronode_board.h"
+#include "astronode_context.h"
 #include "astronode_definitions.h"
+#include "astronode_downlink.h"
+#include "astronode_downsampler.h"
+#include "astronode_event.h"
+#include "astronode_fragment.h"
+#include "astronode_geolocation.h"
+#include "astronode_packer.h"
+#include "astronode_payload_policy.h"
+#include "astronode_profile.h"
+#include "astronode_scheduler.h"
+#include "astronode_search_tuner.h"
+#include "astronode_trace.h"
+#include "astronode_uplink_queue.h"
 #include "drivers.h"
 
 
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define SENSOR_SAMPLING_PERIOD_MS     1000
+#define SENSOR_SAMPLING_PERIOD_MAX_MS 3600000
+#define SENSOR_TRACE_ERROR_BOUND      1       // Tenth of degree
+
+// Position of the asset in 1e-7 degree: replace with the fix of the asset GNSS receiver.
+#define ASSET_LATITUDE                465193000
+#define ASSET_LONGITUDE               66322000
+#define ASSET_MIN_DISTANCE_M          100
+#define ASSET_POSITION_MAX_AGE_MS     86400000
+
+
 //------------------------------------------------------------------------------
 // Global variable definitions
 //------------------------------------------------------------------------------
-uint16_t g_payload_id_counter = 0;
+astronode_ctx_t g_astronode_ctx;
+
+uint16_t g_button_press_counter = 0;
+uint16_t g_reported_button_press_counter = 0;
+uint32_t g_sensor_sampling_period_ms = SENSOR_SAMPLING_PERIOD_MS;
+
+// Uptime in seconds, advanced by the elapsed systick so that it keeps increasing when
+// the 32-bit millisecond systick wraps after 49.7 days.
+uint32_t g_uptime_s = 0;
+uint32_t g_uptime_timer = 0;
+
+astronode_downsampler_t g_sensor_downsampler;
+astronode_downsampler_point_t g_last_trace_point;
+uint8_t g_trace_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+uint16_t g_trace_length = 0;
+
+// Newest frames of the trace retained across the last reset, sent in fragments.
+uint8_t g_fault_report[ASTRONODE_FRAGMENT_RECORD_MAX_LEN_BYTES];
+uint16_t g_fault_report_length = 0;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void acknowledge_payload(uint16_t payload_id);
+static void prepare_uplink(void);
+static void send_sensor_summary(const uint8_t *p_record, uint16_t record_length);
+static void add_trace_point(const astronode_downsampler_point_t *p_point);
+static void flush_trace_payload(void);
+static void build_fault_report(void);
+static uint32_t get_uptime_s(void);
+astronode_downlink_result_t handle_sampling_period_command(const uint8_t *p_data, uint8_t length);
 
 
 //------------------------------------------------------------------------------
@@ -26,6 +86,14 @@ uint16_t g_payload_id_counter = 0;
 int main(void)
 {
     init_drivers();
+    astronode_profile_init();
+    if (astronode_trace_init())
+    {
+        // Frames exchanged before the warm reset, kept in SRAM2.
+        astronode_trace_dump();
+        build_fault_report();
+    }
+    astronode_ctx_init(&g_astronode_ctx, get_astronode_uart_ops(), NULL);
 
     send_debug_logs("\nStart the application...");
 
@@ -36,66 +104,248 @@ int main(void)
     char ssid[ASTRONODE_WLAN_SSID_MAX_LENGTH] = "my_wifi_ssid";
     char wlan_key[ASTRONODE_WLAN_KEY_MAX_LENGTH] = "my_wifi_password";
     char api_token[ASTRONODE_AUTH_TOKEN_MAX_LENGTH] = "6nxGR4eWYb4R8fEsXx2h1hGoR6nvku2TvGvTuFzxiGYPpICAAroZKttHnzXTQSLEilvCTT7r7E7urZ7iEW42fdibmXG4ROQz";
-    astronode_send_wif_wr(ssid, wlan_key, api_token);
+    astronode_send_wif_wr(&g_astronode_ctx, ssid, wlan_key, api_token);
     // WIFI DEV KIT: end of section.
 
     uint32_t print_housekeeping_timer = get_systick();
+    uint32_t sensor_sampling_timer = get_systick();
 
     // Send config write with:
     // EVT pin shows sat ack
-    // No geolocation
+    // Geolocation of the asset, written with GEO_WR
     // Ephemeris Enable
-    // Deep Sleep not used
+    // Deep Sleep used, the Astronode sleeps between passes
     // EVT pin shows Message Ack
     // EVT pin shows Reset
     // EVT pin shows downlink command available
     // EVT pin did not show tx message pending (keep it to false in this example)
-    astronode_send_cfg_wr(true, false, true, false, true, true, true, false);
+    astronode_send_cfg_wr(&g_astronode_ctx, true, true, true, true, true, true, true, false);
 
     // Store current configuration in NVM.
-    astronode_send_cfg_sr();
+    astronode_send_cfg_sr(&g_astronode_ctx);
+
+    // The reset event of the boot is cleared: a later one means the queue was lost.
+    astronode_send_res_cr(&g_astronode_ctx);
+
+    // Button presses are aggregated and enqueued right before the next pass.
+    astronode_scheduler_init(&g_astronode_ctx, prepare_uplink);
+    astronode_payload_policy_init(&g_astronode_ctx);
+    astronode_uplink_queue_init();
+    // Only the latest button press counter is worth sending.
+    astronode_payload_policy_set_class(ASTRONODE_UPLINK_PRIORITY_PERIODIC, ASTRONODE_PAYLOAD_POLICY_NO_TTL, true);
+    astronode_search_tuner_init(&g_astronode_ctx);
+    astronode_geolocation_init(&g_astronode_ctx, ASSET_MIN_DISTANCE_M, ASSET_POSITION_MAX_AGE_MS);
+    astronode_downlink_init(&g_astronode_ctx);
+    astronode_event_init(&g_astronode_ctx, acknowledge_payload);
+    astronode_aggregator_init(send_sensor_summary);
+    if (g_fault_report_length > 0)
+    {
+        astronode_fragment_send(g_fault_report, g_fault_report_length);
+    }
+    // The raw sensor trace is also sent, reduced to the samples needed to rebuild it within the error bound.
+    astronode_downsampler_init(&g_sensor_downsampler, ASTRONODE_DOWNSAMPLER_MODE_SWINGING_DOOR, SENSOR_TRACE_ERROR_BOUND);
 
     while (1)
     {
-        if (is_evt_pin_high())
+        // While a fetched command waits for its handler the EVT pin stays high.
+        if (is_evt_pin_high() && astronode_downlink_is_pending() == false)
         {
             send_debug_logs("Evt pin is high.");
-            astronode_send_evt_rr();
-            if (is_sak_available())
-            {
-                astronode_send_sak_rr();
-                astronode_send_sak_cr();
-                send_debug_logs("Message has been acknowledged.");
-                astronode_send_per_rr();
-            }
-            if (is_astronode_reset())
-            {
-                send_debug_logs("Terminal has been reset.");
-                astronode_send_res_cr();
-            }
-            if (is_command_available())
-            {
-                send_debug_logs("Unicast command is available");
-                astronode_send_cmd_rr();
-                astronode_send_cmd_cr();
-            }
+            astronode_event_process();
         }
         else if (is_message_available())
         {
             send_debug_logs("The button is pressed.");
 
-            g_payload_id_counter++;
-            char payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES] = {0};
+            g_button_press_counter++;
+        }
+        else if (astronode_downlink_is_pending())
+        {
+            astronode_downlink_process();
+        }
+        else if (get_systick() - sensor_sampling_timer >= g_sensor_sampling_period_ms)
+        {
+            int32_t sensor_value = read_sensor_value();
+            astronode_downsampler_point_t trace_point = {0};
 
-            sprintf(payload, "Test message %d", g_payload_id_counter);
+            astronode_aggregator_add_sample(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, sensor_value);
+            if (astronode_downsampler_add_sample(&g_sensor_downsampler,
+                                                 get_uptime_s(),
+                                                 sensor_value,
+                                                 &trace_point))
+            {
+                add_trace_point(&trace_point);
+            }
+            sensor_sampling_timer += g_sensor_sampling_period_ms;
+        }
+        else
+        {
+            // The systick may pass the sampling time between the check above and here.
+            uint32_t elapsed_ms = get_systick() - sensor_sampling_timer;
 
-            astronode_send_pld_er(g_payload_id_counter, payload, strlen(payload));
+            astronode_scheduler_run(g_sensor_sampling_period_ms > elapsed_ms ? g_sensor_sampling_period_ms - elapsed_ms : 0);
         }
 
         if (get_systick() - print_housekeeping_timer > 60000)
         {
-            astronode_send_per_rr();
+            astronode_send_per_rr(&g_astronode_ctx);
+            // Pending button presses are sent as a single payload.
+            astronode_search_tuner_run(astronode_uplink_queue_get_count()
+                                       + (g_button_press_counter != g_reported_button_press_counter ? 1 : 0));
             print_housekeeping_timer = get_systick();
         }
     }
+}
+
+static void acknowledge_payload(uint16_t payload_id)
+{
+    astronode_payload_policy_acknowledge(payload_id);
+    astronode_fragment_acknowledge(payload_id);
+    send_debug_logs("Message has been acknowledged.");
+}
+
+static void prepare_uplink(void)
+{
+    astronode_downsampler_point_t trace_point = {0};
+
+    // Fragments dropped from the Astronode queue before their acknowledgment are sent again.
+    astronode_fragment_service();
+
+    // Written only when the asset moved or the last position is a day old.
+    astronode_geolocation_update(ASSET_LATITUDE, ASSET_LONGITUDE);
+
+    // One summary per pass: the window of the sensor covers the interval since the previous
+    // pass, so the uplink queue holds a single summary along with the trace payloads.
+    astronode_aggregator_flush(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR);
+
+    // The trace is closed on its last sample and sent with this pass, not only once its payload is full.
+    if (astronode_downsampler_flush(&g_sensor_downsampler, &trace_point))
+    {
+        add_trace_point(&trace_point);
+    }
+    flush_trace_payload();
+
+    if (g_button_press_counter != g_reported_button_press_counter)
+    {
+        uint8_t payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+        astronode_packer_t packer;
+        astronode_packer_header_t header = { .channel_count = 1, .base_timestamp = get_uptime_s(), .sample_interval = 0 };
+        int32_t counter = g_button_press_counter;
+
+        // One sample time series: uptime in seconds and the button press counter.
+        // Replaces the previous counter if it is still waiting in the Astronode queue.
+        if (astronode_packer_init(&packer, payload, sizeof(payload), &header) == RS_SUCCESS
+            && astronode_packer_add_sample(&packer, &counter) == RS_SUCCESS
+            && astronode_uplink_queue_push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, (const char *) payload, packer.length) == RS_SUCCESS)
+        {
+            g_reported_button_press_counter = g_button_press_counter;
+        }
+    }
+
+    astronode_uplink_queue_service();
+}
+
+static void send_sensor_summary(const uint8_t *p_record, uint16_t record_length)
+{
+    // Every window summary has to reach the backend, they are not replaced like the counter.
+    astronode_uplink_queue_push(ASTRONODE_UPLINK_PRIORITY_EVENT, (const char *) p_record, record_length);
+}
+
+static void add_trace_point(const astronode_downsampler_point_t *p_point)
+{
+    if (g_trace_length + ASTRONODE_DOWNSAMPLER_POINT_MAX_LEN_BYTES > ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES)
+    {
+        flush_trace_payload();
+    }
+
+    if (g_trace_length == 0)
+    {
+        g_trace_payload[g_trace_length++] = ASTRONODE_DOWNSAMPLER_FORMAT_POINTS;
+        g_trace_length += astronode_downsampler_encode_point(NULL, p_point, &g_trace_payload[g_trace_length]);
+    }
+    else
+    {
+        g_trace_length += astronode_downsampler_encode_point(&g_last_trace_point, p_point, &g_trace_payload[g_trace_length]);
+    }
+
+    g_last_trace_point = *p_point;
+}
+
+static void flush_trace_payload(void)
+{
+    char str[64];
+
+    if (g_trace_length == 0)
+    {
+        return;
+    }
+
+    sprintf(str, "Sensor trace reduced by %d per mille.", astronode_downsampler_get_reduction_ratio(&g_sensor_downsampler));
+    send_debug_logs(str);
+    astronode_uplink_queue_push(ASTRONODE_UPLINK_PRIORITY_EVENT, (const char *) g_trace_payload, g_trace_length);
+    g_trace_length = 0;
+}
+
+static void build_fault_report(void)
+{
+    uint32_t cursor = 0;
+    uint32_t trace_length = 0;
+
+    // The records follow each other as read from the ring, each one giving its frame length.
+    // Only the newest ones fit: measure the trace, then skip the oldest records.
+    while (astronode_trace_read(&trace_length, g_fault_report, sizeof(g_fault_report)) > 0)
+    {
+        // Each read moves the cursor past one record.
+    }
+    while (trace_length - cursor > sizeof(g_fault_report)
+           && astronode_trace_read(&cursor, g_fault_report, sizeof(g_fault_report)) > 0)
+    {
+        // Skip the oldest record.
+    }
+
+    g_fault_report_length = 0;
+    while (cursor < trace_length)
+    {
+        uint16_t length = astronode_trace_read(&cursor,
+                                               &g_fault_report[g_fault_report_length],
+                                               sizeof(g_fault_report) - g_fault_report_length);
+
+        if (length == 0)
+        {
+            break;
+        }
+        g_fault_report_length += length;
+    }
+}
+
+// Called at least once per sampling period, far below the wrap of the systick.
+static uint32_t get_uptime_s(void)
+{
+    uint32_t elapsed_ms = get_systick() - g_uptime_timer;
+
+    g_uptime_s += elapsed_ms / 1000;
+    g_uptime_timer += elapsed_ms - elapsed_ms % 1000;
+    return g_uptime_s;
+}
+
+// Command 0x01: sensor sampling period in milliseconds (uint32, little endian).
+astronode_downlink_result_t handle_sampling_period_command(const uint8_t *p_data, uint8_t length)
+{
+    if (length < 4)
+    {
+        return ASTRONODE_DOWNLINK_REJECTED;
+    }
+
+    uint32_t period_ms = p_data[0]
+                         + (p_data[1] << 8)
+                         + (p_data[2] << 16)
+                         + ((uint32_t) p_data[3] << 24);
+
+    if (period_ms < SENSOR_SAMPLING_PERIOD_MS || period_ms > SENSOR_SAMPLING_PERIOD_MAX_MS)
+    {
+        return ASTRONODE_DOWNLINK_REJECTED;
+    }
+
+    g_sensor_sampling_period_ms = period_ms;
+    return ASTRONODE_DOWNLINK_ACCEPTED;
 }
\ No newline at end of file
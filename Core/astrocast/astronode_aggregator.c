@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_aggregator.h"
+#include "astronode_packer.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define AGGREGATOR_WINDOW_SIZE(name, window_size) window_size,
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// Running statistics of a window (Welford), constant memory whatever the window size.
+typedef struct aggregator_window_t
+{
+    uint16_t    count;
+    int32_t     min;
+    int32_t     max;
+    float       mean;
+    float       m2;
+} aggregator_window_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const uint16_t g_window_sizes[ASTRONODE_AGGREGATOR_CHANNEL_COUNT] =
+{
+    ASTRONODE_AGGREGATOR_CHANNELS(AGGREGATOR_WINDOW_SIZE)
+};
+
+static aggregator_window_t g_windows[ASTRONODE_AGGREGATOR_CHANNEL_COUNT];
+static astronode_aggregator_emit_t g_emit = NULL;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_aggregator_init(astronode_aggregator_emit_t emit)
+{
+    g_emit = emit;
+    memset(g_windows, 0, sizeof(g_windows));
+}
+
+void astronode_aggregator_add_sample(astronode_aggregator_channel_t channel, int32_t value)
+{
+    if (channel >= ASTRONODE_AGGREGATOR_CHANNEL_COUNT)
+    {
+        return;
+    }
+
+    aggregator_window_t *p_window = &g_windows[channel];
+
+    if (p_window->count == 0 || value < p_window->min)
+    {
+        p_window->min = value;
+    }
+    if (p_window->count == 0 || value > p_window->max)
+    {
+        p_window->max = value;
+    }
+
+    p_window->count++;
+
+    float delta = (float) value - p_window->mean;
+    p_window->mean += delta / p_window->count;
+    p_window->m2 += delta * ((float) value - p_window->mean);
+
+    if (p_window->count >= g_window_sizes[channel])
+    {
+        astronode_aggregator_flush(channel);
+    }
+}
+
+void astronode_aggregator_get_summary(astronode_aggregator_channel_t channel, astronode_aggregator_summary_t *p_summary)
+{
+    const aggregator_window_t *p_window = &g_windows[channel];
+    float variance = p_window->count > 1 ? p_window->m2 / (p_window->count - 1) : 0.0f;
+    float mean = p_window->mean;
+
+    p_summary->count = p_window->count;
+    p_summary->min = p_window->min;
+    p_summary->max = p_window->max;
+    p_summary->mean = (int32_t) (mean >= 0.0f ? mean + 0.5f : mean - 0.5f);
+    p_summary->variance = variance < 4294967295.0f ? (uint32_t) (variance + 0.5f) : UINT32_MAX;
+}
+
+void astronode_aggregator_flush(astronode_aggregator_channel_t channel)
+{
+    if (channel >= ASTRONODE_AGGREGATOR_CHANNEL_COUNT || g_windows[channel].count == 0)
+    {
+        return;
+    }
+
+    astronode_aggregator_summary_t summary = {0};
+    uint8_t p_record[ASTRONODE_AGGREGATOR_RECORD_MAX_LEN_BYTES];
+
+    astronode_aggregator_get_summary(channel, &summary);
+    memset(&g_windows[channel], 0, sizeof(aggregator_window_t));
+
+    if (g_emit != NULL)
+    {
+        g_emit(p_record, astronode_aggregator_encode(channel, &summary, p_record));
+    }
+}
+
+uint16_t astronode_aggregator_encode(uint8_t channel_id, const astronode_aggregator_summary_t *p_summary, uint8_t *p_record)
+{
+    uint16_t length = 0;
+
+    p_record[length++] = ASTRONODE_AGGREGATOR_FORMAT_SUMMARY;
+    p_record[length++] = channel_id;
+    length += astronode_varint_encode(p_summary->count, &p_record[length]);
+    length += astronode_varint_encode(astronode_zigzag_encode(p_summary->min), &p_record[length]);
+    length += astronode_varint_encode(astronode_zigzag_encode(p_summary->max), &p_record[length]);
+    length += astronode_varint_encode(astronode_zigzag_encode(p_summary->mean), &p_record[length]);
+    length += astronode_varint_encode(p_summary->variance, &p_record[length]);
+
+    return length;
+}
@@ -0,0 +1,88 @@
+#ifndef ASTRONODE_AGGREGATOR_H
+#define ASTRONODE_AGGREGATOR_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Channels aggregated by the asset: X(name, number of samples per window).
+// Define ASTRONODE_AGGREGATOR_CHANNELS in the build to use your own channels. The example
+// closes the SENSOR window before each pass with astronode_aggregator_flush(), its size
+// only bounds a window when no pass comes (18 h at one sample per second).
+#ifndef ASTRONODE_AGGREGATOR_CHANNELS
+#define ASTRONODE_AGGREGATOR_CHANNELS(X) \
+    X(SENSOR, UINT16_MAX)
+#endif
+
+// Summary record: format | channel ID | varint count | zigzag varint min, max and mean | varint variance
+#define ASTRONODE_AGGREGATOR_FORMAT_SUMMARY       ASTRONODE_UPLINK_FORMAT_SUMMARY
+#define ASTRONODE_AGGREGATOR_RECORD_MAX_LEN_BYTES (2 + 5 * 5)
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+#define ASTRONODE_AGGREGATOR_CHANNEL_ENUM(name, window_size) ASTRONODE_AGGREGATOR_CHANNEL_##name,
+
+typedef enum astronode_aggregator_channel_t
+{
+    ASTRONODE_AGGREGATOR_CHANNELS(ASTRONODE_AGGREGATOR_CHANNEL_ENUM)
+    ASTRONODE_AGGREGATOR_CHANNEL_COUNT
+} astronode_aggregator_channel_t;
+
+typedef struct astronode_aggregator_summary_t
+{
+    uint16_t    count;
+    int32_t     min;
+    int32_t     max;
+    int32_t     mean;
+    uint32_t    variance;
+} astronode_aggregator_summary_t;
+
+/**
+ * @brief Called with the encoded summary record of each completed window.
+ */
+typedef void (*astronode_aggregator_emit_t)(const uint8_t *p_record, uint16_t record_length);
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Reset all the windows and register the callback receiving the summary records.
+ */
+void astronode_aggregator_init(astronode_aggregator_emit_t emit);
+
+/**
+ * @brief Add a sample to the window of a channel, the summary is emitted when the window is full.
+ */
+void astronode_aggregator_add_sample(astronode_aggregator_channel_t channel, int32_t value);
+
+/**
+ * @brief Return the summary of the current window of a channel.
+ */
+void astronode_aggregator_get_summary(astronode_aggregator_channel_t channel, astronode_aggregator_summary_t *p_summary);
+
+/**
+ * @brief Emit the summary of a partial window and start a new one.
+ */
+void astronode_aggregator_flush(astronode_aggregator_channel_t channel);
+
+/**
+ * @brief Encode a summary record, return its length.
+ */
+uint16_t astronode_aggregator_encode(uint8_t channel_id, const astronode_aggregator_summary_t *p_summary, uint8_t *p_record);
+
+
+#endif /* ASTRONODE_AGGREGATOR_H */
@@ -2,15 +2,17 @@
 // Includes
 //------------------------------------------------------------------------------
 // Standard
+#include <inttypes.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
-#include <ctype.h>      // for isprint function
 
 // Astrocast
 #include "astronode_definitions.h"
 #include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_pool.h"
 #include "astronode_transport.h"
 #include "drivers.h"
 
@@ -24,6 +26,8 @@
 #define ASTRONODE_BIT_OFFSET_ENABLE_EPH         2
 #define ASTRONODE_BIT_OFFSET_DEEP_SLEEP_MODE    3
 
+#define ASTRONODE_BYTE_OFFSET_CFG_WR_RESERVED       1
+
 #define ASTRONODE_BYTE_OFFSET_CFG_WR_EVT_PIN_MASK   2
 #define ASTRONODE_BIT_OFFSET_MSG_ACK_EVT_PIN_MASK   0
 #define ASTRONODE_BIT_OFFSET_RST_NTF_EVT_PIN_MASK   1
@@ -39,10 +43,6 @@
 #define ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK   7
 
 #define ASTRONODE_BYTE_OFFSET_EVT_RR_EVENT  0
-#define ASTRONODE_BIT_OFFSET_ACK            0
-#define ASTRONODE_BIT_OFFSET_RST            1
-#define ASTRONODE_BIT_OFFSET_CMD            2
-#define ASTRONODE_BIT_OFFEST_MSG_TX         3
 
 #define ASTRONODE_BYTE_OFFSET_SSC_WR_PERIOD_ENUM    0
 #define ASTRONODE_BYTE_OFFSET_SSC_WR_ENA_SEARCH     1
@@ -77,33 +77,32 @@
 #define PC_COUNTER_ID_LAST_SEARCH_TIME                  0x63
 
 
-//------------------------------------------------------------------------------
-// Global variable definitions
-//------------------------------------------------------------------------------
-static bool g_is_sak_available = false;
-static bool g_is_astronode_reset = false;
-static bool g_is_command_available = false;
-static bool g_is_tx_msg_pending = false;
-
 //------------------------------------------------------------------------------
 // Function declaration
 //------------------------------------------------------------------------------
+static bool acquire_messages(astronode_ctx_t *p_ctx, astronode_op_code op_code, astronode_app_msg_t **pp_request, astronode_app_msg_t **pp_answer);
 void append_multiple_data_size_to_string(char * const p_str, uint32_t * const p_data, uint8_t size);
+static uint32_t get_tlv_value(const char *p_data, uint8_t size);
+static bool is_tlv_in_payload(const astronode_app_msg_t *p_answer, uint16_t tlv_index);
+static void release_messages(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer);
 
 
 //------------------------------------------------------------------------------
 // Function definitions
 //------------------------------------------------------------------------------
-void astronode_send_cfg_fr(void)
+void astronode_send_cfg_fr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_CFG_FR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CFG_FR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_CFG_FA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_CFG_FA)
         {
             send_debug_logs("Astronode settings reverted to default values.");
         }
@@ -112,24 +111,29 @@ void astronode_send_cfg_fr(void)
             send_debug_logs("Failed to process the factory reset.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_cfg_rr(void)
+void astronode_send_cfg_rr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_CFG_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CFG_RR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_CFG_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_CFG_RA)
         {
             char str[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
 
             send_debug_logs("Astronode settings read successfully:");
 
-            switch (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_DEV_TYPE_ID])
+            switch (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_DEV_TYPE_ID])
             {
                 case 3:
                     send_debug_logs("Device Type ID : Commercial Satellite Astronode.");
@@ -145,14 +149,14 @@ void astronode_send_cfg_rr(void)
             }
 
             sprintf(str, "Hardware revision : %d, Firmware version : %d.%d.%d",
-                    answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_HW_REV],
-                    answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_FW_MAJOR_VER],
-                    answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_FW_MINOR_VER],
-                    answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_FW_REV]);
+                    p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_HW_REV],
+                    p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_FW_MAJOR_VER],
+                    p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_FW_MINOR_VER],
+                    p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_FW_REV]);
 
             send_debug_logs(str);
 
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_PAYLOAD_ACK))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_PAYLOAD_ACK))
             {
                 send_debug_logs("Asset is informed of payload acks.");
             }
@@ -160,7 +164,7 @@ void astronode_send_cfg_rr(void)
             {
                 send_debug_logs("Asset is not informed of payload acks.");
             }
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_ADD_GEO))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_ADD_GEO))
             {
                 send_debug_logs("Geolocation is on.");
             }
@@ -168,7 +172,7 @@ void astronode_send_cfg_rr(void)
             {
                 send_debug_logs("No geolocation.");
             }
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_ENABLE_EPH))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_ENABLE_EPH))
             {
                 send_debug_logs("Ephemeris is enabled.");
             }
@@ -176,7 +180,7 @@ void astronode_send_cfg_rr(void)
             {
                 send_debug_logs("Ephemeris is disabled.");
             }
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_DEEP_SLEEP_MODE))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_CONFIG] & (1 << ASTRONODE_BIT_OFFSET_DEEP_SLEEP_MODE))
             {
                 send_debug_logs("Deep sleep mode is used.");
             }
@@ -185,7 +189,7 @@ void astronode_send_cfg_rr(void)
                 send_debug_logs("Deep sleep mode not used.");
             }
 
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_MSG_ACK_EVT_PIN_MASK))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_MSG_ACK_EVT_PIN_MASK))
             {
                 send_debug_logs("EVT pin shows EVT register Message Ack bit state.");
             }
@@ -193,7 +197,7 @@ void astronode_send_cfg_rr(void)
             {
                 send_debug_logs("EVT pin does not show EVT register Message Ack bit state.");
             }
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_RST_NTF_EVT_PIN_MASK))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_RST_NTF_EVT_PIN_MASK))
             {
                 send_debug_logs("EVT pin shows EVT register Reset Event Notification bit state.");
             }
@@ -201,7 +205,7 @@ void astronode_send_cfg_rr(void)
             {
                 send_debug_logs("EVT pin does not show EVT register Reset Event Notification bit state.");
             }
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_CMD_AVA_EVT_PIN_MASK))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_CMD_AVA_EVT_PIN_MASK))
             {
                 send_debug_logs("EVT pin shows EVT register Command Available bit state.");
             }
@@ -209,7 +213,7 @@ void astronode_send_cfg_rr(void)
             {
                 send_debug_logs("EVT pin does not show EVT register Command Available bit state.");
             }
-            if (answer.p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_MSG_TXP_EVT_PIN_MASK))
+            if (p_answer->p_payload[ASTRONODE_BYTE_OFFSET_CFG_RR_EVT_PIN_MASK] & (1 << ASTRONODE_BIT_OFFSET_MSG_TXP_EVT_PIN_MASK))
             {
                 send_debug_logs("EVT pin shows EVT register Message Transmission pending bit state.");
             }
@@ -224,18 +228,23 @@ void astronode_send_cfg_rr(void)
             send_debug_logs("Failed to process the factory reset.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_cfg_sr(void)
+void astronode_send_cfg_sr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_CFG_SR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CFG_SR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    astronode_transport_send_receive(&request, &answer);
+    astronode_transport_send_receive(p_ctx, p_request, p_answer);
 
-    if (answer.op_code == ASTRONODE_OP_CODE_CFG_SA)
+    if (p_answer->op_code == ASTRONODE_OP_CODE_CFG_SA)
     {
         send_debug_logs("Astronode configuration successfully saved in NVM.");
     }
@@ -243,9 +252,12 @@ void astronode_send_cfg_sr(void)
     {
         send_debug_logs("Failed to save the Astronode configuration in NVM.");
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_cfg_wr(bool payload_acknowledgment,
+void astronode_send_cfg_wr(astronode_ctx_t *p_ctx,
+                            bool payload_acknowledgment,
                             bool add_geolocation,
                             bool enable_ephemeris,
                             bool deep_sleep_mode,
@@ -254,26 +266,31 @@ void astronode_send_cfg_wr(bool payload_acknowledgment,
 							bool command_available_event_pin_mask,
 							bool message_tx_event_pin_mask)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_CFG_WR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CFG_WR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    request.p_payload[ASTRONODE_BYTE_OFFSET_CFG_WR_CONFIG] = payload_acknowledgment << ASTRONODE_BIT_OFFSET_PAYLOAD_ACK
+    p_request->p_payload[ASTRONODE_BYTE_OFFSET_CFG_WR_CONFIG] = payload_acknowledgment << ASTRONODE_BIT_OFFSET_PAYLOAD_ACK
         | add_geolocation << ASTRONODE_BIT_OFFSET_ADD_GEO
         | enable_ephemeris << ASTRONODE_BIT_OFFSET_ENABLE_EPH
         | deep_sleep_mode << ASTRONODE_BIT_OFFSET_DEEP_SLEEP_MODE;
 
-    request.p_payload[ASTRONODE_BYTE_OFFSET_CFG_WR_EVT_PIN_MASK] = message_ack_event_pin_mask << ASTRONODE_BIT_OFFSET_MSG_ACK_EVT_PIN_MASK
+    p_request->p_payload[ASTRONODE_BYTE_OFFSET_CFG_WR_RESERVED] = 0;
+
+    p_request->p_payload[ASTRONODE_BYTE_OFFSET_CFG_WR_EVT_PIN_MASK] = message_ack_event_pin_mask << ASTRONODE_BIT_OFFSET_MSG_ACK_EVT_PIN_MASK
         | reset_notification_event_pin_mask << ASTRONODE_BIT_OFFSET_RST_NTF_EVT_PIN_MASK
         | command_available_event_pin_mask << ASTRONODE_BIT_OFFSET_CMD_AVA_EVT_PIN_MASK
         | message_tx_event_pin_mask << ASTRONODE_BIT_OFFSET_MSG_TXP_EVT_PIN_MASK;
 
-    request.payload_len = 3;
+    p_request->payload_len = 3;
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_CFG_WA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_CFG_WA)
         {
             send_debug_logs("Astronode configuration successfully set.");
         }
@@ -282,18 +299,23 @@ void astronode_send_cfg_wr(bool payload_acknowledgment,
             send_debug_logs("Failed to set the Astronode configuration.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_ctx_sr(void)
+void astronode_send_ctx_sr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_CTX_SR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CTX_SR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    astronode_transport_send_receive(&request, &answer);
+    astronode_transport_send_receive(p_ctx, p_request, p_answer);
 
-    if (answer.op_code == ASTRONODE_OP_CODE_CTX_SA)
+    if (p_answer->op_code == ASTRONODE_OP_CODE_CTX_SA)
     {
         send_debug_logs("Astronode context successfully saved in NVM.");
     }
@@ -301,22 +323,27 @@ void astronode_send_ctx_sr(void)
     {
         send_debug_logs("Failed to save the Astronode context in NVM.");
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_mgi_rr(void)
+void astronode_send_mgi_rr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_MGI_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_MGI_RR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_MGI_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_MGI_RA)
         {
-            char guid[answer.payload_len];
+            char guid[p_answer->payload_len];
             send_debug_logs("Module GUID is:");
-            snprintf(guid, answer.payload_len, "%s", answer.p_payload);
+            snprintf(guid, p_answer->payload_len, "%.*s", p_answer->payload_len, p_answer->p_payload);
             send_debug_logs(guid);
         }
         else
@@ -324,22 +351,27 @@ void astronode_send_mgi_rr(void)
             send_debug_logs("Failed to read module GUID.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_msn_rr(void)
+void astronode_send_msn_rr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_MSN_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_MSN_RR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_MSN_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_MSN_RA)
         {
-            char serial_number[answer.payload_len];
+            char serial_number[p_answer->payload_len];
             send_debug_logs("Module's Serial Number is:");
-            snprintf(serial_number, answer.payload_len, "%s", answer.p_payload);
+            snprintf(serial_number, p_answer->payload_len, "%.*s", p_answer->payload_len, p_answer->p_payload);
             send_debug_logs(serial_number);
         }
         else
@@ -347,181 +379,234 @@ void astronode_send_msn_rr(void)
             send_debug_logs("Failed to read module Serial Number.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_nco_rr(void)
+return_status_t astronode_send_nco_rr(astronode_ctx_t *p_ctx, uint32_t *p_time_to_next_pass)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_NCO_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_NCO_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_NCO_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_NCO_RA)
         {
-            uint32_t time_to_next_pass = answer.p_payload[0]
-                                        + (answer.p_payload[1] << 8)
-                                        + (answer.p_payload[2] << 16)
-                                        + (answer.p_payload[3] << 24);
+            uint32_t time_to_next_pass = get_tlv_value(&p_answer->p_payload[0], 4);
             char str[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
-            sprintf(str, "Next opportunity for communication with the Astrocast Network: %lds.", time_to_next_pass);
+            sprintf(str, "Next opportunity for communication with the Astrocast Network: %" PRIu32 "s.", time_to_next_pass);
             send_debug_logs(str);
+            *p_time_to_next_pass = time_to_next_pass;
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Failed to read satellite constellation ephemeris data.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_evt_rr(void)
+return_status_t astronode_send_evt_rr(astronode_ctx_t *p_ctx, uint8_t *p_event_bitmask)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_EVT_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_EVT_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_EVT_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_EVT_RA)
         {
-            if ((answer.p_payload[ASTRONODE_BYTE_OFFSET_EVT_RR_EVENT]) & (1 << ASTRONODE_BIT_OFFSET_ACK))
+            *p_event_bitmask = p_answer->p_payload[ASTRONODE_BYTE_OFFSET_EVT_RR_EVENT];
+
+            if (*p_event_bitmask & ASTRONODE_EVENT_MSG_ACK)
             {
-                g_is_sak_available = true;
+                p_ctx->is_sak_available = true;
                 send_debug_logs("Message acknowledgment available.");
             }
-            if ((answer.p_payload[ASTRONODE_BYTE_OFFSET_EVT_RR_EVENT]) & (1 << ASTRONODE_BIT_OFFSET_RST))
+            if (*p_event_bitmask & ASTRONODE_EVENT_RESET)
             {
-                g_is_astronode_reset = true;
+                p_ctx->is_astronode_reset = true;
                 send_debug_logs("Astronode has reset.");
             }
-            if ((answer.p_payload[ASTRONODE_BYTE_OFFSET_EVT_RR_EVENT]) & (1 << ASTRONODE_BIT_OFFSET_CMD))
+            if (*p_event_bitmask & ASTRONODE_EVENT_CMD_AVAILABLE)
             {
-                g_is_command_available = true;
+                p_ctx->is_command_available = true;
                 send_debug_logs("Command available.");
             }
-            if ((answer.p_payload[ASTRONODE_BYTE_OFFSET_EVT_RR_EVENT]) & (1 << ASTRONODE_BIT_OFFEST_MSG_TX))
+            p_ctx->is_tx_msg_pending = (*p_event_bitmask & ASTRONODE_EVENT_MSG_TX_PENDING) != 0;
+            if (p_ctx->is_tx_msg_pending)
             {
-                g_is_tx_msg_pending = true;
                 send_debug_logs("TX message pending.");
             }
-
+            status = RS_SUCCESS;
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_geo_wr(int32_t latitude, int32_t longitude)
+return_status_t astronode_send_geo_wr(astronode_ctx_t *p_ctx, int32_t latitude, int32_t longitude)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_GEO_WR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_GEO_WR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    request.p_payload[request.payload_len++] = (uint8_t) latitude;
-    request.p_payload[request.payload_len++] = (uint8_t) (latitude >> 8);
-    request.p_payload[request.payload_len++] = (uint8_t) (latitude >> 16);
-    request.p_payload[request.payload_len++] = (uint8_t) (latitude >> 24);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) latitude;
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (latitude >> 8);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (latitude >> 16);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (latitude >> 24);
 
-    request.p_payload[request.payload_len++] = (uint8_t) longitude;
-    request.p_payload[request.payload_len++] = (uint8_t) (longitude >> 8);
-    request.p_payload[request.payload_len++] = (uint8_t) (longitude >> 16);
-    request.p_payload[request.payload_len++] = (uint8_t) (longitude >> 24);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) longitude;
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (longitude >> 8);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (longitude >> 16);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (longitude >> 24);
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_GEO_WA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_GEO_WA)
         {
             send_debug_logs("Geolocation values were set successfully.");
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Failed to set the geolocation information.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_pld_dr(void)
+return_status_t astronode_send_pld_dr(astronode_ctx_t *p_ctx, uint16_t *p_payload_id)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_PLD_DR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_PLD_DR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_PLD_EA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_PLD_DA)
         {
-            uint16_t payload_id = answer.p_payload[0] + (answer.p_payload[1] << 8);
+            uint16_t payload_id = (uint8_t) p_answer->p_payload[0] + ((uint8_t) p_answer->p_payload[1] << 8);
             char str[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
             sprintf(str, "Payload %d was successfully dequeued.", payload_id);
             send_debug_logs(str);
+            *p_payload_id = payload_id;
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Failed to dequeue oldest payload.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_pld_er(uint16_t payload_id, char *p_payload, uint16_t payload_length)
+return_status_t astronode_send_pld_er(astronode_ctx_t *p_ctx, uint16_t payload_id, const char *p_payload, uint16_t payload_length)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_PLD_ER;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_PLD_ER, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    request.p_payload[request.payload_len++] = (uint8_t) payload_id;
-    request.p_payload[request.payload_len++] = (uint8_t) (payload_id >> 8);
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) payload_id;
+    p_request->p_payload[p_request->payload_len++] = (uint8_t) (payload_id >> 8);
 
-    memcpy(&request.p_payload[request.payload_len], p_payload, payload_length);
-    request.payload_len = 2 + payload_length;
+    memcpy(&p_request->p_payload[p_request->payload_len], p_payload, payload_length);
+    p_request->payload_len = 2 + payload_length;
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_PLD_EA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_PLD_EA)
         {
             send_debug_logs("Payload was successfully queued.");
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Payload failed to be queued.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_pld_fr(void)
+return_status_t astronode_send_pld_fr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_PLD_FR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_PLD_FR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_PLD_FA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_PLD_FA)
         {
             send_debug_logs("Entire payload queue has been cleared.");
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Failed to clear the payload queue.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_res_cr(void)
+void astronode_send_res_cr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_RES_CR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_RES_CR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_RES_CA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_RES_CA)
         {
-            g_is_astronode_reset = false;
+            p_ctx->is_astronode_reset = false;
             send_debug_logs("The reset has been cleared.");
         }
         else
@@ -529,25 +614,30 @@ void astronode_send_res_cr(void)
             send_debug_logs("No reset to clear.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_rtc_rr(void)
+void astronode_send_rtc_rr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_RTC_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_RTC_RR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_RTC_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_RTC_RA)
         {
-            uint32_t rtc_time = answer.p_payload[0]
-                                        + (answer.p_payload[1] << 8)
-                                        + (answer.p_payload[2] << 16)
-                                        + (answer.p_payload[3] << 24);
+            uint32_t rtc_time = p_answer->p_payload[0]
+                                        + (p_answer->p_payload[1] << 8)
+                                        + (p_answer->p_payload[2] << 16)
+                                        + (p_answer->p_payload[3] << 24);
             char str[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
-            sprintf(str, "RTC time since Astrocast Epoch (2018-01-01 00:00:00 UTC): %lds.", rtc_time);
+            sprintf(str, "RTC time since Astrocast Epoch (2018-01-01 00:00:00 UTC): %" PRIu32 "s.", rtc_time);
             send_debug_logs(str);
         }
         else
@@ -555,43 +645,57 @@ void astronode_send_rtc_rr(void)
             send_debug_logs("Failed to read rtc time.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_sak_rr(void)
+return_status_t astronode_send_sak_rr(astronode_ctx_t *p_ctx, uint16_t *p_payload_id)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_SAK_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_SAK_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_SAK_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_SAK_RA)
         {
-            uint16_t payload_id = answer.p_payload[0] + (answer.p_payload[1] << 8);
+            uint16_t payload_id = (uint8_t) p_answer->p_payload[0] + ((uint8_t) p_answer->p_payload[1] << 8);
             char str[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
             sprintf(str, "Acknowledgment for payload %d is available.", payload_id);
             send_debug_logs(str);
+            *p_payload_id = payload_id;
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("No acknowledgment available.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_sak_cr(void)
+void astronode_send_sak_cr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_SAK_CR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_SAK_CR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_SAK_CA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_SAK_CA)
         {
-            g_is_sak_available = false;
+            p_ctx->is_sak_available = false;
             send_debug_logs("The acknowledgment has been cleared.");
         }
         else
@@ -599,52 +703,65 @@ void astronode_send_sak_cr(void)
             send_debug_logs("No acknowledgment available.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_ssc_wr(uint8_t search_period_enum, bool enable_search_without_msg_queued)
+return_status_t astronode_send_ssc_wr(astronode_ctx_t *p_ctx, uint8_t search_period_enum, bool enable_search_without_msg_queued)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_SSC_WR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_SSC_WR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    request.p_payload[ASTRONODE_BYTE_OFFSET_SSC_WR_PERIOD_ENUM] = search_period_enum;
-    request.p_payload[ASTRONODE_BYTE_OFFSET_SSC_WR_ENA_SEARCH] = enable_search_without_msg_queued << ASTRONODE_BIT_OFFSET_ENA_SEARCH;
+    p_request->p_payload[ASTRONODE_BYTE_OFFSET_SSC_WR_PERIOD_ENUM] = search_period_enum;
+    p_request->p_payload[ASTRONODE_BYTE_OFFSET_SSC_WR_ENA_SEARCH] = enable_search_without_msg_queued << ASTRONODE_BIT_OFFSET_ENA_SEARCH;
 
-    request.payload_len = 2;
+    p_request->payload_len = 2;
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_SSC_WA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_SSC_WA)
         {
             send_debug_logs("Astronode satellite config successfully set.");
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Failed to set the Astronode satellite configuration.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_wif_wr(char *p_wlan_ssid, char *p_wlan_key, char *p_auth_token)
+void astronode_send_wif_wr(astronode_ctx_t *p_ctx, char *p_wlan_ssid, char *p_wlan_key, char *p_auth_token)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_WIF_WR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_WIF_WR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    memcpy(&request.p_payload[request.payload_len], p_wlan_ssid, ASTRONODE_WLAN_SSID_MAX_LENGTH);
-    request.payload_len += ASTRONODE_WLAN_SSID_MAX_LENGTH;
+    memcpy(&p_request->p_payload[p_request->payload_len], p_wlan_ssid, ASTRONODE_WLAN_SSID_MAX_LENGTH);
+    p_request->payload_len += ASTRONODE_WLAN_SSID_MAX_LENGTH;
 
-    memcpy(&request.p_payload[request.payload_len], p_wlan_key, ASTRONODE_WLAN_KEY_MAX_LENGTH);
-    request.payload_len += ASTRONODE_WLAN_KEY_MAX_LENGTH;
+    memcpy(&p_request->p_payload[p_request->payload_len], p_wlan_key, ASTRONODE_WLAN_KEY_MAX_LENGTH);
+    p_request->payload_len += ASTRONODE_WLAN_KEY_MAX_LENGTH;
 
-    memcpy(&request.p_payload[request.payload_len], p_auth_token, ASTRONODE_AUTH_TOKEN_MAX_LENGTH);
-    request.payload_len += ASTRONODE_AUTH_TOKEN_MAX_LENGTH;
+    memcpy(&p_request->p_payload[p_request->payload_len], p_auth_token, ASTRONODE_AUTH_TOKEN_MAX_LENGTH);
+    p_request->payload_len += ASTRONODE_AUTH_TOKEN_MAX_LENGTH;
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_WIF_WA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_WIF_WA)
         {
             send_debug_logs("WiFi settings successfully set.");
         }
@@ -653,22 +770,27 @@ void astronode_send_wif_wr(char *p_wlan_ssid, char *p_wlan_key, char *p_auth_tok
             send_debug_logs("WiFi settings failed to be set.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_mpn_rr(void)
+void astronode_send_mpn_rr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_MPN_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_MPN_RR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_MPN_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_MPN_RA)
         {
-            char product_number[answer.payload_len];
+            char product_number[p_answer->payload_len];
             send_debug_logs("Module's product number is:");
-            snprintf(product_number, answer.payload_len, "%s", answer.p_payload);
+            snprintf(product_number, p_answer->payload_len, "%.*s", p_answer->payload_len, p_answer->p_payload);
             send_debug_logs(product_number);
         }
         else
@@ -676,6 +798,8 @@ void astronode_send_mpn_rr(void)
             send_debug_logs("Failed to read module Serial Number.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
 void append_multiple_data_size_to_string(char * const p_str, uint32_t * const p_data, uint8_t size)
@@ -689,32 +813,53 @@ void append_multiple_data_size_to_string(char * const p_str, uint32_t * const p_
             sprintf(p_str, "%u", (uint16_t) *p_data);
             break;
         case 4:
-            sprintf(p_str, "%lu", *p_data);
+            sprintf(p_str, "%" PRIu32, *p_data);
             break;
         default:
             sprintf(p_str, "tlv size error %u", size);
     }
 }
 
-void astronode_send_per_rr(void)
+static uint32_t get_tlv_value(const char *p_data, uint8_t size)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    uint32_t value = 0;
 
-    request.op_code = ASTRONODE_OP_CODE_PER_RR;
+    for (uint8_t i = 0; i < size && i < 4; i++)
+    {
+        value |= (uint32_t) (uint8_t) p_data[i] << (8 * i);
+    }
+    return value;
+}
+
+// The type, the size and the value of the TLV all lie within the received payload.
+static bool is_tlv_in_payload(const astronode_app_msg_t *p_answer, uint16_t tlv_index)
+{
+    return tlv_index + 2 <= p_answer->payload_len
+           && tlv_index + 2 + (uint8_t) p_answer->p_payload[tlv_index + 1] <= p_answer->payload_len;
+}
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+void astronode_send_per_rr(astronode_ctx_t *p_ctx)
+{
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_PER_RR, &p_request, &p_answer) == false)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_PER_RA)
+        return;
+    }
+
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
+    {
+        if (p_answer->op_code == ASTRONODE_OP_CODE_PER_RA)
         {
             uint16_t tlv_index = 0; // size 16bits to fit to payload_len
             char log_text[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
             uint8_t tlv_size = 0;
-            while (tlv_index < answer.payload_len)
+            while (is_tlv_in_payload(p_answer, tlv_index))
             {
-                uint32_t *p_data = (uint32_t *) &answer.p_payload[tlv_index + 2];
-                tlv_size = answer.p_payload[tlv_index + 1];
-                switch (answer.p_payload[tlv_index])
+                uint32_t *p_data = (uint32_t *) &p_answer->p_payload[tlv_index + 2];
+                tlv_size = p_answer->p_payload[tlv_index + 1];
+                switch (p_answer->p_payload[tlv_index])
                 {
                     case PC_COUNTER_ID_SAT_DET_PHASE_COUNT:
                         send_debug_logs("PC sat det phase count is: ");
@@ -773,18 +918,23 @@ void astronode_send_per_rr(void)
             send_debug_logs("Failed to get performance counters.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_per_cr(void)
+void astronode_send_per_cr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
 
-    request.op_code = ASTRONODE_OP_CODE_PER_CR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_PER_CR, &p_request, &p_answer) == false)
+    {
+        return;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_PER_CA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_PER_CA)
         {
             send_debug_logs("The performance counters have been cleared.");
         }
@@ -793,39 +943,49 @@ void astronode_send_per_cr(void)
             send_debug_logs("Failed to clear performance counters.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
 }
 
-void astronode_send_mst_rr(void)
+return_status_t astronode_send_mst_rr(astronode_ctx_t *p_ctx, astronode_module_state_t *p_module_state)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_MST_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_MST_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_MST_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_MST_RA)
         {
             uint16_t tlv_index = 0; // size 16bits to fit to payload_len
             char log_text[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
             uint8_t tlv_size = 0;
-            while (tlv_index < answer.payload_len)
+            while (is_tlv_in_payload(p_answer, tlv_index))
             {
-                uint32_t *p_data = (uint32_t *) &answer.p_payload[tlv_index + 2];
-                tlv_size = answer.p_payload[tlv_index + 1];
-                switch (answer.p_payload[tlv_index])
+                uint32_t *p_data = (uint32_t *) &p_answer->p_payload[tlv_index + 2];
+                tlv_size = p_answer->p_payload[tlv_index + 1];
+                switch (p_answer->p_payload[tlv_index])
                 {
                     case PC_COUNTER_ID_MSGS_IN_QUEUE:
                         send_debug_logs("MS messages in queue is: ");
+                        p_module_state->msg_in_queue = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_ACKED_MSGS_IN_QUEUE:
                         send_debug_logs("MS acked messages in queue is: ");
+                        p_module_state->ack_msg_in_queue = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_LAST_RESET_REASON:
                         send_debug_logs("MS last reset reason is: ");
+                        p_module_state->last_reset_reason = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_UPTIME_COUNTER:
                         send_debug_logs("MS uptime counter is: ");
+                        p_module_state->uptime = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     default:
                         send_debug_logs("Module state error, type unknown");
@@ -836,45 +996,57 @@ void astronode_send_mst_rr(void)
                 log_text[0] = '\0';
                 tlv_index += tlv_size + 2;
             }
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("Failed to get module state.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_lcd_rr(void)
+return_status_t astronode_send_lcd_rr(astronode_ctx_t *p_ctx, astronode_last_contact_t *p_last_contact)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_LCD_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_LCD_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_LCD_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_LCD_RA)
         {
             uint16_t tlv_index = 0; // size 16bits to fit to payload_len
             char log_text[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
             uint8_t tlv_size = 0;
-            while (tlv_index < answer.payload_len)
+            while (is_tlv_in_payload(p_answer, tlv_index))
             {
-                uint32_t *p_data = (uint32_t *) &answer.p_payload[tlv_index + 2];
-                tlv_size = answer.p_payload[tlv_index + 1];
-                switch (answer.p_payload[tlv_index])
+                uint32_t *p_data = (uint32_t *) &p_answer->p_payload[tlv_index + 2];
+                tlv_size = p_answer->p_payload[tlv_index + 1];
+                switch (p_answer->p_payload[tlv_index])
                 {
                     case PC_COUNTER_ID_START_OF_LAST_PASS:
                         send_debug_logs("Time of start of last pass contact is: ");
+                        p_last_contact->start_of_last_pass = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_END_OF_LAST_PASS:
                         send_debug_logs("Time of end of last pass contact is: ");
+                        p_last_contact->end_of_last_pass = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_PEAK_POWER_OF_LAST_PASS:
                         send_debug_logs("Peak RSSI of last pass is: ");
+                        p_last_contact->peak_rssi_of_last_pass = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_TIME_PEAK_POWER_OF_LAST_PASS:
                         send_debug_logs("Time of peak RSSI in last pass contact is: ");
+                        p_last_contact->time_of_peak_rssi_of_last_pass = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     default:
                         send_debug_logs("Module state error, type unknown");
@@ -885,42 +1057,53 @@ void astronode_send_lcd_rr(void)
                 log_text[0] = '\0';
                 tlv_index += tlv_size + 2;
             }
+            status = RS_SUCCESS;
         }
         else
         {
-            send_debug_logs("Failed to get module state.");
+            send_debug_logs("Failed to get last contact details.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_end_rr(void)
+return_status_t astronode_send_end_rr(astronode_ctx_t *p_ctx, astronode_environment_details_t *p_environment_details)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_END_RR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_END_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_END_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_END_RA)
         {
             uint16_t tlv_index = 0; // size 16bits to fit to payload_len
             char log_text[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
             uint8_t tlv_size = 0;
-            while (tlv_index < answer.payload_len)
+            while (is_tlv_in_payload(p_answer, tlv_index))
             {
-                uint32_t *p_data = (uint32_t *) &answer.p_payload[tlv_index + 2];
-                tlv_size = answer.p_payload[tlv_index + 1];
-                switch (answer.p_payload[tlv_index])
+                uint32_t *p_data = (uint32_t *) &p_answer->p_payload[tlv_index + 2];
+                tlv_size = p_answer->p_payload[tlv_index + 1];
+                switch (p_answer->p_payload[tlv_index])
                 {
                     case PC_COUNTER_ID_LAST_MAC_RESULT:
                         send_debug_logs("PC Last MAC Result is: ");
+                        p_environment_details->last_mac_result = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_LAST_SEARCH_POWER:
                         send_debug_logs("PC Last satellite search peak RSSI is: ");
+                        p_environment_details->last_sat_search_peak_rssi = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     case PC_COUNTER_ID_LAST_SEARCH_TIME:
                         send_debug_logs("PC Time since last satellite search is: ");
+                        p_environment_details->time_since_last_sat_search = get_tlv_value(&p_answer->p_payload[tlv_index + 2], tlv_size);
                         break;
                     default:
                         send_debug_logs("Module state error, type unknown");
@@ -931,98 +1114,135 @@ void astronode_send_end_rr(void)
                 log_text[0] = '\0';
                 tlv_index += tlv_size + 2;
             }
+            status = RS_SUCCESS;
         }
         else
         {
-            send_debug_logs("Failed to get module state.");
+            send_debug_logs("Failed to get environment details.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_cmd_cr(void)
+return_status_t astronode_send_cmd_cr(astronode_ctx_t *p_ctx)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_CMD_CR;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CMD_CR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_CMD_CA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_CMD_CA)
         {
-            g_is_command_available = false;
+            p_ctx->is_command_available = false;
             send_debug_logs("The command ack has been cleared.");
+            status = RS_SUCCESS;
         }
         else
         {
             send_debug_logs("No command to clear.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
 }
 
-void astronode_send_cmd_rr(void)
+return_status_t astronode_send_cmd_rr(astronode_ctx_t *p_ctx, astronode_command_t *p_command)
 {
-    astronode_app_msg_t request = {0};
-    astronode_app_msg_t answer = {0};
+    astronode_app_msg_t *p_request = NULL;
+    astronode_app_msg_t *p_answer = NULL;
+    return_status_t status = RS_FAILURE;
 
-    request.op_code = ASTRONODE_OP_CODE_CMD_RR;
+    p_command->is_malformed = false;
+    if (acquire_messages(p_ctx, ASTRONODE_OP_CODE_CMD_RR, &p_request, &p_answer) == false)
+    {
+        return RS_FAILURE;
+    }
 
-    if (astronode_transport_send_receive(&request, &answer) == RS_SUCCESS)
+    if (astronode_transport_send_receive(p_ctx, p_request, p_answer) == RS_SUCCESS)
     {
-        if (answer.op_code == ASTRONODE_OP_CODE_CMD_RA)
+        if (p_answer->op_code == ASTRONODE_OP_CODE_CMD_RA && p_answer->payload_len < 4)
+        {
+            send_debug_logs("Command size error");
+            p_command->is_malformed = true;
+        }
+        else if (p_answer->op_code == ASTRONODE_OP_CODE_CMD_RA)
         {
             send_debug_logs("Received downlink command");
-            uint32_t rtc_time = answer.p_payload[0]
-                                + (answer.p_payload[1] << 8)
-                                + (answer.p_payload[2] << 16)
-                                + (answer.p_payload[3] << 24);
+            p_command->created_date = get_tlv_value(&p_answer->p_payload[0], 4);
             char str[ASTRONODE_UART_DEBUG_BUFFER_LENGTH];
-            sprintf(str, "Command created date, Ref is astrocast Epoch (2018-01-01 00:00:00 UTC): %lds.", rtc_time);
+            sprintf(str, "Command created date, Ref is astrocast Epoch (2018-01-01 00:00:00 UTC): %" PRIu32 "s.", p_command->created_date);
             send_debug_logs(str);
 
-            if (((answer.payload_len - 4) != 40) && ((answer.payload_len - 4) != 8))
+            // Commands are binary, 8 or 40 bytes long.
+            p_command->length = p_answer->payload_len - 4;
+            if (p_command->length != ASTRONODE_APP_COMMAND_SHORT_LEN_BYTES
+                && p_command->length != ASTRONODE_APP_COMMAND_MAX_LEN_BYTES)
             {
                 send_debug_logs("Command size error");
-                return;
+                p_command->is_malformed = true;
             }
-
-            char command_content[answer.payload_len];
-            uint16_t command_content_size = snprintf(command_content, (answer.payload_len - 4) + 1, "%s", &answer.p_payload[4]);
-            for (uint8_t index = 0; index < command_content_size; index++)
+            else
             {
-            	if (isprint((unsigned char)command_content[index]) == 0)
-                {
-                    send_debug_logs("Command contains non printable characters");
-                    return;
-                }
+                memcpy(p_command->p_data, &p_answer->p_payload[4], p_command->length);
+                status = RS_SUCCESS;
             }
-            send_debug_logs("Command content is: ");
-            sprintf(command_content, "%s ", &answer.p_payload[4]);
-            send_debug_logs(command_content);
         }
         else
         {
             send_debug_logs("No command available.");
         }
     }
+
+    release_messages(p_ctx, p_request, p_answer);
+    return status;
+}
+
+bool is_sak_available(const astronode_ctx_t *p_ctx)
+{
+    return p_ctx->is_sak_available;
 }
 
-bool is_sak_available()
+bool is_astronode_reset(const astronode_ctx_t *p_ctx)
 {
-    return g_is_sak_available;
+    return p_ctx->is_astronode_reset;
 }
 
-bool is_astronode_reset()
+bool is_command_available(const astronode_ctx_t *p_ctx)
 {
-    return g_is_astronode_reset;
+    return p_ctx->is_command_available;
 }
 
-bool is_command_available()
+bool is_tx_msg_pending(const astronode_ctx_t *p_ctx)
 {
-    return g_is_command_available;
+    return p_ctx->is_tx_msg_pending;
+}
+
+static bool acquire_messages(astronode_ctx_t *p_ctx, astronode_op_code op_code, astronode_app_msg_t **pp_request, astronode_app_msg_t **pp_answer)
+{
+    *pp_request = astronode_pool_acquire_msg(p_ctx);
+    *pp_answer = astronode_pool_acquire_msg(p_ctx);
+
+    if (*pp_request == NULL || *pp_answer == NULL)
+    {
+        release_messages(p_ctx, *pp_request, *pp_answer);
+        return false;
+    }
+
+    (*pp_request)->op_code = op_code;
+    return true;
 }
 
-bool is_tx_msg_pending()
+static void release_messages(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer)
 {
-    return g_is_tx_msg_pending;
+    astronode_pool_release_msg(p_ctx, p_answer);
+    astronode_pool_release_msg(p_ctx, p_request);
 }
\ No newline at end of file
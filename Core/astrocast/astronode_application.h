@@ -19,6 +19,14 @@
 //------------------------------------------------------------------------------
 #define ASTRONODE_APP_MSG_MAX_LEN_BYTES     194 // Wi-Fi write is 194 bytes
 #define ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES 160 // 152 if geolocation is used
+#define ASTRONODE_APP_COMMAND_SHORT_LEN_BYTES 8
+#define ASTRONODE_APP_COMMAND_MAX_LEN_BYTES 40
+
+// EVT_RA event bitmask
+#define ASTRONODE_EVENT_MSG_ACK             (1 << 0)
+#define ASTRONODE_EVENT_RESET               (1 << 1)
+#define ASTRONODE_EVENT_CMD_AVAILABLE       (1 << 2)
+#define ASTRONODE_EVENT_MSG_TX_PENDING      (1 << 3)
 
 
 //------------------------------------------------------------------------------
@@ -31,17 +39,49 @@ typedef struct astronode_app_msg_t
     uint16_t            payload_len;
 } astronode_app_msg_t;
 
+typedef struct astronode_last_contact_t
+{
+    uint32_t    start_of_last_pass;
+    uint32_t    end_of_last_pass;
+    uint8_t     peak_rssi_of_last_pass;
+    uint32_t    time_of_peak_rssi_of_last_pass;
+} astronode_last_contact_t;
+
+typedef struct astronode_module_state_t
+{
+    uint8_t     msg_in_queue;
+    uint8_t     ack_msg_in_queue;
+    uint8_t     last_reset_reason;
+    uint32_t    uptime;
+} astronode_module_state_t;
+
+typedef struct astronode_environment_details_t
+{
+    uint8_t     last_mac_result;
+    uint8_t     last_sat_search_peak_rssi;
+    uint32_t    time_since_last_sat_search;
+} astronode_environment_details_t;
+
+typedef struct astronode_command_t
+{
+    uint32_t    created_date;
+    uint8_t     p_data[ASTRONODE_APP_COMMAND_MAX_LEN_BYTES];
+    uint8_t     length;
+    bool        is_malformed;   // CMD_RA of invalid length, the command cannot be dispatched.
+} astronode_command_t;
+
 
 //------------------------------------------------------------------------------
 // Function declarations
 //------------------------------------------------------------------------------
-void astronode_send_cfg_fr(void);
+void astronode_send_cfg_fr(astronode_ctx_t *p_ctx);
 
-void astronode_send_cfg_rr(void);
+void astronode_send_cfg_rr(astronode_ctx_t *p_ctx);
 
-void astronode_send_cfg_sr(void);
+void astronode_send_cfg_sr(astronode_ctx_t *p_ctx);
 
-void astronode_send_cfg_wr( bool payload_acknowledgment,
+void astronode_send_cfg_wr(astronode_ctx_t *p_ctx,
+                            bool payload_acknowledgment,
                             bool add_geolocation,
                             bool enable_ephemeris,
                             bool deep_sleep_mode,
@@ -50,71 +90,71 @@ void astronode_send_cfg_wr( bool payload_acknowledgment,
                             bool command_available_event_pin_mask,
                             bool message_tx_event_pin_mask);
 
-void astronode_send_ctx_sr(void);                            
+void astronode_send_ctx_sr(astronode_ctx_t *p_ctx);                            
 
-void astronode_send_mgi_rr(void);
+void astronode_send_mgi_rr(astronode_ctx_t *p_ctx);
 
-void astronode_send_msn_rr(void);
+void astronode_send_msn_rr(astronode_ctx_t *p_ctx);
 
-void astronode_send_nco_rr(void);
+return_status_t astronode_send_nco_rr(astronode_ctx_t *p_ctx, uint32_t *p_time_to_next_pass);
 
-void astronode_send_evt_rr(void);
+return_status_t astronode_send_evt_rr(astronode_ctx_t *p_ctx, uint8_t *p_event_bitmask);
 
-void astronode_send_geo_wr(int32_t latitude, int32_t longitude);
+return_status_t astronode_send_geo_wr(astronode_ctx_t *p_ctx, int32_t latitude, int32_t longitude);
 
-void astronode_send_pld_dr(void);
+return_status_t astronode_send_pld_dr(astronode_ctx_t *p_ctx, uint16_t *p_payload_id);
 
-void astronode_send_pld_er(uint16_t payload_id, char *p_payload, uint16_t payload_length);
+return_status_t astronode_send_pld_er(astronode_ctx_t *p_ctx, uint16_t payload_id, const char *p_payload, uint16_t payload_length);
 
-void astronode_send_pld_fr(void);
+return_status_t astronode_send_pld_fr(astronode_ctx_t *p_ctx);
 
-void astronode_send_res_cr(void);
+void astronode_send_res_cr(astronode_ctx_t *p_ctx);
 
-void astronode_send_rtc_rr(void);
+void astronode_send_rtc_rr(astronode_ctx_t *p_ctx);
 
-void astronode_send_sak_cr(void);
+void astronode_send_sak_cr(astronode_ctx_t *p_ctx);
 
-void astronode_send_sak_rr(void);
+return_status_t astronode_send_sak_rr(astronode_ctx_t *p_ctx, uint16_t *p_payload_id);
 
-void astronode_send_ssc_wr(uint8_t search_period_enum, bool enable_search_without_msg_queued);
+return_status_t astronode_send_ssc_wr(astronode_ctx_t *p_ctx, uint8_t search_period_enum, bool enable_search_without_msg_queued);
 
-void astronode_send_wif_wr(char *p_wlan_ssid, char *p_wlan_key, char *p_auth_token);
+void astronode_send_wif_wr(astronode_ctx_t *p_ctx, char *p_wlan_ssid, char *p_wlan_key, char *p_auth_token);
 
-void astronode_send_mpn_rr(void);
+void astronode_send_mpn_rr(astronode_ctx_t *p_ctx);
 
-void astronode_send_per_cr(void);
+void astronode_send_per_cr(astronode_ctx_t *p_ctx);
 
-void astronode_send_per_rr(void);
+void astronode_send_per_rr(astronode_ctx_t *p_ctx);
 
-void astronode_send_mst_rr(void);
+return_status_t astronode_send_mst_rr(astronode_ctx_t *p_ctx, astronode_module_state_t *p_module_state);
 
-void astronode_send_lcd_rr(void);
+return_status_t astronode_send_lcd_rr(astronode_ctx_t *p_ctx, astronode_last_contact_t *p_last_contact);
 
-void astronode_send_end_rr(void);
+return_status_t astronode_send_end_rr(astronode_ctx_t *p_ctx, astronode_environment_details_t *p_environment_details);
 
-void astronode_send_cmd_cr(void);
+return_status_t astronode_send_cmd_cr(astronode_ctx_t *p_ctx);
 
-void astronode_send_cmd_rr(void);
+return_status_t astronode_send_cmd_rr(astronode_ctx_t *p_ctx, astronode_command_t *p_command);
 
 /**
  * @brief Check is an acknowledgment has been read.
  */
-bool is_sak_available(void);
+bool is_sak_available(const astronode_ctx_t *p_ctx);
 
 /**
  * @brief Check is the Astronode reset has been read.
  */
-bool is_astronode_reset(void);
+bool is_astronode_reset(const astronode_ctx_t *p_ctx);
 
 /**
  * @brief Check is a unicast command available.
  */
-bool is_command_available(void);
+bool is_command_available(const astronode_ctx_t *p_ctx);
 
 /**
  * @brief Check is TX message pending.
  */
-bool is_tx_msg_pending(void);
+bool is_tx_msg_pending(const astronode_ctx_t *p_ctx);
 
 
 #endif /* ASTRONODE_APPLICATION_H */
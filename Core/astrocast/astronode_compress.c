@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_compress.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define COMPRESS_WINDOW_LENGTH  (1 << ASTRONODE_COMPRESS_WINDOW_BITS)
+#define COMPRESS_MIN_MATCH      2
+#define COMPRESS_MAX_MATCH      (COMPRESS_MIN_MATCH + (1 << ASTRONODE_COMPRESS_LENGTH_BITS) - 1)
+
+#define COMPRESS_DICTIONARY_LENGTH ((uint16_t) (sizeof(g_dictionary) - 1))
+
+_Static_assert(sizeof(ASTRONODE_COMPRESS_DICTIONARY) - 1 <= COMPRESS_WINDOW_LENGTH,
+               "The compression dictionary must fit in the window.");
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct bit_stream_t
+{
+    uint8_t    *p_buffer;
+    uint16_t    length;
+    uint16_t    index;
+    uint8_t     bit;
+} bit_stream_t;
+
+// Window seen by the back-references: the dictionary (if used) followed by the data.
+typedef struct history_t
+{
+    uint16_t        dictionary_length;
+    const uint8_t  *p_data;
+} history_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const uint8_t g_dictionary[] = ASTRONODE_COMPRESS_DICTIONARY;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint8_t get_history_byte(const history_t *p_history, uint16_t position);
+static bool read_bits(bit_stream_t *p_stream, uint8_t count, uint16_t *p_value);
+static uint32_t remaining_bits(const bit_stream_t *p_stream);
+static bool write_bits(bit_stream_t *p_stream, uint16_t value, uint8_t count);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+static uint8_t get_history_byte(const history_t *p_history, uint16_t position)
+{
+    if (position < p_history->dictionary_length)
+    {
+        return g_dictionary[COMPRESS_DICTIONARY_LENGTH - p_history->dictionary_length + position];
+    }
+    return p_history->p_data[position - p_history->dictionary_length];
+}
+
+static bool read_bits(bit_stream_t *p_stream, uint8_t count, uint16_t *p_value)
+{
+    uint16_t value = 0;
+
+    if (remaining_bits(p_stream) < count)
+    {
+        return false;
+    }
+
+    while (count--)
+    {
+        value = (value << 1) | ((p_stream->p_buffer[p_stream->index] >> (7 - p_stream->bit)) & 1);
+
+        if (++p_stream->bit == 8)
+        {
+            p_stream->bit = 0;
+            p_stream->index++;
+        }
+    }
+
+    *p_value = value;
+    return true;
+}
+
+static uint32_t remaining_bits(const bit_stream_t *p_stream)
+{
+    return (uint32_t) (p_stream->length - p_stream->index) * 8 - p_stream->bit;
+}
+
+static bool write_bits(bit_stream_t *p_stream, uint16_t value, uint8_t count)
+{
+    if (remaining_bits(p_stream) < count)
+    {
+        return false;
+    }
+
+    while (count--)
+    {
+        if (p_stream->bit == 0)
+        {
+            p_stream->p_buffer[p_stream->index] = 0;
+        }
+
+        p_stream->p_buffer[p_stream->index] |= ((value >> count) & 1) << (7 - p_stream->bit);
+
+        if (++p_stream->bit == 8)
+        {
+            p_stream->bit = 0;
+            p_stream->index++;
+        }
+    }
+
+    return true;
+}
+
+return_status_t astronode_compress(const uint8_t *p_input,
+                                   uint16_t input_length,
+                                   bool use_dictionary,
+                                   uint8_t *p_output,
+                                   uint16_t output_capacity,
+                                   uint16_t *p_output_length)
+{
+    history_t history = { use_dictionary ? COMPRESS_DICTIONARY_LENGTH : 0, p_input };
+    bit_stream_t stream = { &p_output[1], output_capacity - 1, 0, 0 };
+    bool is_compressed = true;
+    uint16_t position = 0;
+
+    if (output_capacity < input_length + 1)
+    {
+        return RS_FAILURE;
+    }
+
+    // Compressed output is never allowed to grow past the raw size.
+    if (stream.length > input_length)
+    {
+        stream.length = input_length;
+    }
+
+    while (position < input_length && is_compressed)
+    {
+        uint16_t current = history.dictionary_length + position;
+        uint16_t candidate = current > COMPRESS_WINDOW_LENGTH ? current - COMPRESS_WINDOW_LENGTH : 0;
+        uint16_t best_length = 0;
+        uint16_t best_distance = 0;
+
+        // Greedy longest match, the match may overlap the current position.
+        for (; candidate < current; candidate++)
+        {
+            uint16_t length = 0;
+
+            while (length < COMPRESS_MAX_MATCH
+                   && position + length < input_length
+                   && get_history_byte(&history, candidate + length) == p_input[position + length])
+            {
+                length++;
+            }
+
+            if (length > best_length)
+            {
+                best_length = length;
+                best_distance = current - candidate;
+            }
+        }
+
+        if (best_length >= COMPRESS_MIN_MATCH)
+        {
+            is_compressed = write_bits(&stream, 0, 1)
+                            && write_bits(&stream, best_distance - 1, ASTRONODE_COMPRESS_WINDOW_BITS)
+                            && write_bits(&stream, best_length - COMPRESS_MIN_MATCH, ASTRONODE_COMPRESS_LENGTH_BITS);
+            position += best_length;
+        }
+        else
+        {
+            is_compressed = write_bits(&stream, 1, 1) && write_bits(&stream, p_input[position], 8);
+            position++;
+        }
+    }
+
+    uint16_t compressed_length = stream.index + (stream.bit > 0 ? 1 : 0);
+
+    if (is_compressed && compressed_length < input_length)
+    {
+        p_output[0] = ASTRONODE_COMPRESS_FLAG_COMPRESSED | (use_dictionary ? ASTRONODE_COMPRESS_FLAG_DICTIONARY : 0);
+        *p_output_length = 1 + compressed_length;
+    }
+    else
+    {
+        p_output[0] = 0;
+        memcpy(&p_output[1], p_input, input_length);
+        *p_output_length = 1 + input_length;
+    }
+
+    return RS_SUCCESS;
+}
+
+return_status_t astronode_decompress(const uint8_t *p_input,
+                                     uint16_t input_length,
+                                     uint8_t *p_output,
+                                     uint16_t output_capacity,
+                                     uint16_t *p_output_length)
+{
+    if (input_length == 0)
+    {
+        return RS_FAILURE;
+    }
+
+    if ((p_input[0] & ASTRONODE_COMPRESS_FLAG_COMPRESSED) == 0)
+    {
+        if (input_length - 1 > output_capacity)
+        {
+            return RS_FAILURE;
+        }
+        memcpy(p_output, &p_input[1], input_length - 1);
+        *p_output_length = input_length - 1;
+        return RS_SUCCESS;
+    }
+
+    history_t history = { (p_input[0] & ASTRONODE_COMPRESS_FLAG_DICTIONARY) ? COMPRESS_DICTIONARY_LENGTH : 0, p_output };
+    bit_stream_t stream = { (uint8_t *) &p_input[1], input_length - 1, 0, 0 };
+    uint16_t length = 0;
+
+    // The padding of the last byte is shorter than a literal (9 bits).
+    while (remaining_bits(&stream) >= 9)
+    {
+        uint16_t is_literal = 0;
+        uint16_t value = 0;
+
+        read_bits(&stream, 1, &is_literal);
+
+        if (is_literal)
+        {
+            read_bits(&stream, 8, &value);
+
+            if (length >= output_capacity)
+            {
+                return RS_FAILURE;
+            }
+            p_output[length++] = (uint8_t) value;
+        }
+        else
+        {
+            uint16_t distance = 0;
+            uint16_t match_length = 0;
+
+            if (read_bits(&stream, ASTRONODE_COMPRESS_WINDOW_BITS, &distance) == false
+                || read_bits(&stream, ASTRONODE_COMPRESS_LENGTH_BITS, &match_length) == false)
+            {
+                return RS_FAILURE;
+            }
+
+            distance += 1;
+            match_length += COMPRESS_MIN_MATCH;
+
+            if (history.dictionary_length + length < distance || length + match_length > output_capacity)
+            {
+                return RS_FAILURE;
+            }
+
+            uint16_t source = history.dictionary_length + length - distance;
+
+            for (uint16_t i = 0; i < match_length; i++)
+            {
+                p_output[length] = get_history_byte(&history, source + i);
+                length++;
+            }
+        }
+    }
+
+    *p_output_length = length;
+    return RS_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#ifndef ASTRONODE_COMPRESS_H
+#define ASTRONODE_COMPRESS_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// First byte of a compressed payload.
+#define ASTRONODE_COMPRESS_FLAG_COMPRESSED  0x01
+#define ASTRONODE_COMPRESS_FLAG_DICTIONARY  0x02
+
+// LZSS parameters: back-references reach 2^WINDOW_BITS bytes behind and copy
+// 2 to 2^LENGTH_BITS + 1 bytes.
+#define ASTRONODE_COMPRESS_WINDOW_BITS      7
+#define ASTRONODE_COMPRESS_LENGTH_BITS      4
+
+// Tokens shared by the asset and the backend, primed in the window when the
+// dictionary is used. At most 2^WINDOW_BITS bytes are reachable.
+#ifndef ASTRONODE_COMPRESS_DICTIONARY
+#define ASTRONODE_COMPRESS_DICTIONARY       "status:ok,error:,alarm:,event:,temperature:,battery:,latitude:,longitude:,time:"
+#endif
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Compress the input behind a flag byte. When compression does not reduce the
+ * size the input is copied raw, so the output capacity must be at least input_length + 1.
+ */
+return_status_t astronode_compress(const uint8_t *p_input,
+                                   uint16_t input_length,
+                                   bool use_dictionary,
+                                   uint8_t *p_output,
+                                   uint16_t output_capacity,
+                                   uint16_t *p_output_length);
+
+/**
+ * @brief Restore a buffer produced by astronode_compress().
+ */
+return_status_t astronode_decompress(const uint8_t *p_input,
+                                     uint16_t input_length,
+                                     uint8_t *p_output,
+                                     uint16_t output_capacity,
+                                     uint16_t *p_output_length);
+
+
+#endif /* ASTRONODE_COMPRESS_H */
@@ -0,0 +1,33 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_context.h"
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_ctx_init(astronode_ctx_t *p_ctx, const astronode_uart_ops_t *p_uart_ops, void *p_port)
+{
+    memset(p_ctx, 0, sizeof(astronode_ctx_t));
+    p_ctx->p_uart_ops = p_uart_ops;
+    p_ctx->p_port = p_port;
+}
+
+uint16_t astronode_ctx_allocate_payload_id(astronode_ctx_t *p_ctx)
+{
+    return ++p_ctx->payload_id_counter;
+}
+
+void astronode_ctx_set_phase_hook(astronode_ctx_t *p_ctx, astronode_phase_hook_t phase_hook, void *p_user)
+{
+    p_ctx->phase_hook = phase_hook;
+    p_ctx->p_phase_hook_user = p_user;
+}
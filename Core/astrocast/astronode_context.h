@@ -0,0 +1,109 @@
+#ifndef ASTRONODE_CONTEXT_H
+#define ASTRONODE_CONTEXT_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_metrics.h"
+#include "astronode_pool.h"
+#include "astronode_retry.h"
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// Dense index of the requests of ASTRONODE_OP_CODE_DESCRIPTORS, for the per op code state.
+typedef enum astronode_op_code_index_t
+{
+#define ASTRONODE_OP_CODE_INDEX_ENUM(request, answer, min_length, max_length, timeout_ms) \
+    ASTRONODE_OP_CODE_INDEX_##request,
+    ASTRONODE_OP_CODE_DESCRIPTORS(ASTRONODE_OP_CODE_INDEX_ENUM)
+#undef ASTRONODE_OP_CODE_INDEX_ENUM
+    ASTRONODE_OP_CODE_INDEX_COUNT
+} astronode_op_code_index_t;
+
+// First byte latency of the answers to a request, smoothed and mean deviation in 1/8 ms.
+typedef struct astronode_latency_estimate_t
+{
+    uint16_t    smoothed;
+    uint16_t    deviation;
+    bool        is_learned;
+} astronode_latency_estimate_t;
+
+// Phases of a transaction, reported to the phase hook when they begin.
+typedef enum astronode_transport_phase_t
+{
+    ASTRONODE_TRANSPORT_PHASE_ENCODE,   // Request encoded in the request buffer
+    ASTRONODE_TRANSPORT_PHASE_TX,       // Request sent
+    ASTRONODE_TRANSPORT_PHASE_WAIT,     // Waiting for the first character of the answer
+    ASTRONODE_TRANSPORT_PHASE_RX,       // Answer received up to its ETX
+    ASTRONODE_TRANSPORT_PHASE_DECODE,   // Answer decoded and checked
+    ASTRONODE_TRANSPORT_PHASE_END,      // Transaction over, status is its result
+    ASTRONODE_TRANSPORT_PHASE_COUNT
+} astronode_transport_phase_t;
+
+/**
+ * @brief Called at each phase of the transactions of an Astronode, for profiling.
+ */
+typedef void (*astronode_phase_hook_t)(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status);
+
+/**
+ * @brief Physical layer of one Astronode, p_port is the port given to astronode_ctx_init().
+ */
+typedef struct astronode_uart_ops_t
+{
+    void (*send_request)(void *p_port, uint8_t *p_data, uint32_t length);
+    bool (*is_character_received)(void *p_port, uint8_t *p_rx_char);
+    bool (*is_evt_pin_high)(void *p_port);
+    void (*reset)(void *p_port);
+} astronode_uart_ops_t;
+
+// One per Astronode driven by the asset.
+struct astronode_ctx_t
+{
+    const astronode_uart_ops_t *p_uart_ops;
+    void                       *p_port;
+    bool                        is_sak_available;
+    bool                        is_astronode_reset;
+    bool                        is_command_available;
+    bool                        is_tx_msg_pending;
+    uint16_t                    last_error_code;
+    uint32_t                    round_trip_count;
+    uint16_t                    payload_id_counter;
+    astronode_phase_hook_t      phase_hook;
+    void                       *p_phase_hook_user;
+    astronode_retry_state_t     retry_state;
+    astronode_latency_estimate_t p_latency_estimates[ASTRONODE_OP_CODE_INDEX_COUNT];
+    astronode_pool_t            pool;
+    astronode_metrics_registry_t metrics;
+};
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Prepare the context of an Astronode reached through p_uart_ops on p_port.
+ */
+void astronode_ctx_init(astronode_ctx_t *p_ctx, const astronode_uart_ops_t *p_uart_ops, void *p_port);
+
+/**
+ * @brief Return the next payload ID of this Astronode.
+ */
+uint16_t astronode_ctx_allocate_payload_id(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Register the hook called at each transaction phase, NULL to remove it.
+ */
+void astronode_ctx_set_phase_hook(astronode_ctx_t *p_ctx, astronode_phase_hook_t phase_hook, void *p_user);
+
+
+#endif /* ASTRONODE_CONTEXT_H */
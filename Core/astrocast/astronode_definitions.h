@@ -14,12 +14,68 @@
 
 #define ASTRONODE_MAX_LENGTH_RESPONSE 178
 
-#define ASTRONODE_ANSWER_TIMEOUT_MS 1500
+// Answer timeout of the specification, the ceiling of the learned timeouts of the transport.
+#define ASTRONODE_ANSWER_TIMEOUT_MS     1500
+
+// Requests sent by the library:
+// X(request op code, answer op code, answer payload min length, max length, answer timeout)
+#define ASTRONODE_OP_CODE_DESCRIPTORS(X) \
+    X(ASTRONODE_OP_CODE_CFG_WR, ASTRONODE_OP_CODE_CFG_WA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_CFG_SR, ASTRONODE_OP_CODE_CFG_SA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_CFG_FR, ASTRONODE_OP_CODE_CFG_FA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_CFG_RR, ASTRONODE_OP_CODE_CFG_RA, 8, 8, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_CTX_SR, ASTRONODE_OP_CODE_CTX_SA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_WIF_WR, ASTRONODE_OP_CODE_WIF_WA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_SSC_WR, ASTRONODE_OP_CODE_SSC_WA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_MGI_RR, ASTRONODE_OP_CODE_MGI_RA, 1, 64, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_MSN_RR, ASTRONODE_OP_CODE_MSN_RA, 1, 64, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_MPN_RR, ASTRONODE_OP_CODE_MPN_RA, 1, 64, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_NCO_RR, ASTRONODE_OP_CODE_NCO_RA, 4, 4, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_RTC_RR, ASTRONODE_OP_CODE_RTC_RA, 4, 4, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_EVT_RR, ASTRONODE_OP_CODE_EVT_RA, 1, 1, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_GEO_WR, ASTRONODE_OP_CODE_GEO_WA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_PLD_ER, ASTRONODE_OP_CODE_PLD_EA, 2, 2, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_PLD_DR, ASTRONODE_OP_CODE_PLD_DA, 2, 2, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_PLD_FR, ASTRONODE_OP_CODE_PLD_FA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_SAK_RR, ASTRONODE_OP_CODE_SAK_RA, 2, 2, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_SAK_CR, ASTRONODE_OP_CODE_SAK_CA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_RES_CR, ASTRONODE_OP_CODE_RES_CA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_PER_RR, ASTRONODE_OP_CODE_PER_RA, 0, 85, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_PER_CR, ASTRONODE_OP_CODE_PER_CA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_MST_RR, ASTRONODE_OP_CODE_MST_RA, 0, 24, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_LCD_RR, ASTRONODE_OP_CODE_LCD_RA, 0, 24, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_END_RR, ASTRONODE_OP_CODE_END_RA, 0, 18, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_CMD_RR, ASTRONODE_OP_CODE_CMD_RA, 12, 44, ASTRONODE_ANSWER_TIMEOUT_MS) \
+    X(ASTRONODE_OP_CODE_CMD_CR, ASTRONODE_OP_CODE_CMD_CA, 0, 0, ASTRONODE_ANSWER_TIMEOUT_MS)
+
+// Error answer: 16 bits error code.
+#define ASTRONODE_ERROR_PAYLOAD_LEN_BYTES 2
 
 
 //------------------------------------------------------------------------------
 // Type definitions
 //------------------------------------------------------------------------------
+typedef enum return_status_t
+{
+    RS_FAILURE,
+    RS_SUCCESS
+} return_status_t;
+
+// Defined in astronode_context.h
+typedef struct astronode_ctx_t astronode_ctx_t;
+
+// First byte of the uplink payloads written by the library, telling the backend how to
+// decode them. Listed here only, so that two layouts never share a value.
+typedef enum astronode_uplink_format_t
+{
+    ASTRONODE_UPLINK_FORMAT_TIME_SERIES = 0x01,     // astronode_packer
+    ASTRONODE_UPLINK_FORMAT_TRACE_POINTS = 0x02,    // astronode_downsampler
+    ASTRONODE_UPLINK_FORMAT_METRICS = 0x03,         // astronode_metrics
+    ASTRONODE_UPLINK_FORMAT_PROFILE = 0x04,         // astronode_profile
+    ASTRONODE_UPLINK_FORMAT_FRAGMENT = 0x05,        // astronode_fragment
+    ASTRONODE_UPLINK_FORMAT_SUMMARY = 0x06          // astronode_aggregator
+} astronode_uplink_format_t;
+
 typedef enum astronode_op_code
 {
     ASTRONODE_OP_CODE_CFG_FA = 0x91,
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_downlink.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define DOWNLINK_HANDLER_DECLARATION(type, handler) \
+    astronode_downlink_result_t handler(const uint8_t *p_data, uint8_t length);
+
+#define DOWNLINK_HANDLER_ENTRY(type, handler) [type] = handler,
+
+#define DOWNLINK_DEBUG_BUFFER_LENGTH 64
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+ASTRONODE_DOWNLINK_HANDLERS(DOWNLINK_HANDLER_DECLARATION)
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// Indexed by the command type, dispatching is a single lookup.
+static const astronode_downlink_handler_t g_handlers[256] =
+{
+    ASTRONODE_DOWNLINK_HANDLERS(DOWNLINK_HANDLER_ENTRY)
+};
+
+// The Astronode exposes the next command only once the current one is cleared, and
+// the current one is only cleared once handled: a single slot is enough to hold it.
+static astronode_ctx_t *g_p_ctx = NULL;
+static astronode_command_t g_pending_command;
+static bool g_is_pending = false;
+static bool g_is_handled = false;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_downlink_init(astronode_ctx_t *p_ctx)
+{
+    g_p_ctx = p_ctx;
+    g_is_pending = false;
+    g_is_handled = false;
+}
+
+void astronode_downlink_fetch(void)
+{
+    if (g_is_pending)
+    {
+        return;
+    }
+
+    if (astronode_send_cmd_rr(g_p_ctx, &g_pending_command) == RS_SUCCESS)
+    {
+        g_is_pending = true;
+        g_is_handled = false;
+    }
+    else if (g_pending_command.is_malformed)
+    {
+        // Malformed command: it cannot be dispatched, clear it to receive the next one.
+        // After a transport failure the command stays in place and is read again.
+        astronode_send_cmd_cr(g_p_ctx);
+    }
+}
+
+void astronode_downlink_process(void)
+{
+    if (g_is_pending == false)
+    {
+        return;
+    }
+
+    if (g_is_handled == false)
+    {
+        char str[DOWNLINK_DEBUG_BUFFER_LENGTH];
+        uint8_t type = g_pending_command.p_data[0];
+        astronode_downlink_handler_t handler = g_handlers[type];
+        astronode_downlink_result_t result = ASTRONODE_DOWNLINK_REJECTED;
+
+        if (handler != NULL)
+        {
+            result = handler(&g_pending_command.p_data[1], g_pending_command.length - 1);
+        }
+
+        if (result == ASTRONODE_DOWNLINK_BUSY)
+        {
+            return;
+        }
+
+        sprintf(str, "Command type 0x%02x %s.", type, result == ASTRONODE_DOWNLINK_ACCEPTED ? "accepted" : "rejected");
+        send_debug_logs(str);
+        g_is_handled = true;
+    }
+
+    // If the clear fails it is retried at the next processing, without running the handler again.
+    if (astronode_send_cmd_cr(g_p_ctx) == RS_SUCCESS
+        || astronode_get_last_error_code(g_p_ctx) == ASTRONODE_ERR_CODE_NO_CLEAR)
+    {
+        g_is_pending = false;
+    }
+}
+
+bool astronode_downlink_is_pending(void)
+{
+    return g_is_pending;
+}
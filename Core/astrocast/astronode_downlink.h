@@ -0,0 +1,72 @@
+#ifndef ASTRONODE_DOWNLINK_H
+#define ASTRONODE_DOWNLINK_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Handlers of the downlink commands: X(command type, handler). The command type is the
+// first byte of the command, the handler receives the bytes following it and is declared as
+// astronode_downlink_result_t handler(const uint8_t *p_data, uint8_t length).
+// Define ASTRONODE_DOWNLINK_HANDLERS in the build to use your own handlers.
+#ifndef ASTRONODE_DOWNLINK_HANDLERS
+#define ASTRONODE_DOWNLINK_HANDLERS(X) \
+    X(0x01, handle_sampling_period_command)
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_downlink_result_t
+{
+    // The command is applied, it is cleared from the Astronode.
+    ASTRONODE_DOWNLINK_ACCEPTED,
+    // The command is invalid, it is cleared from the Astronode without being applied.
+    ASTRONODE_DOWNLINK_REJECTED,
+    // The command cannot be applied now, it is dispatched again at the next processing.
+    ASTRONODE_DOWNLINK_BUSY
+} astronode_downlink_result_t;
+
+typedef astronode_downlink_result_t (*astronode_downlink_handler_t)(const uint8_t *p_data, uint8_t length);
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Bind the dispatcher to this Astronode and forget any pending command.
+ */
+void astronode_downlink_init(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Read the available command (CMD_RR) into the pending command slot, if it is free.
+ * Call it when the EVT pin signals a command, the handler is not run here.
+ */
+void astronode_downlink_fetch(void);
+
+/**
+ * @brief Dispatch the pending command to the handler of its type, then clear it
+ * from the Astronode (CMD_CR) unless the handler is busy.
+ */
+void astronode_downlink_process(void);
+
+/**
+ * @brief Check if a command is waiting to be dispatched or cleared.
+ */
+bool astronode_downlink_is_pending(void);
+
+
+#endif /* ASTRONODE_DOWNLINK_H */
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_downsampler.h"
+#include "astronode_packer.h"
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void keep_point(astronode_downsampler_t *p_downsampler,
+                       const astronode_downsampler_point_t *p_point,
+                       astronode_downsampler_point_t *p_output);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+static void keep_point(astronode_downsampler_t *p_downsampler,
+                       const astronode_downsampler_point_t *p_point,
+                       astronode_downsampler_point_t *p_output)
+{
+    p_downsampler->archived = *p_point;
+    p_downsampler->has_archived = true;
+    p_downsampler->has_pending = false;
+    p_downsampler->segment_count = 0;
+    p_downsampler->output_count++;
+    *p_output = *p_point;
+}
+
+void astronode_downsampler_init(astronode_downsampler_t *p_downsampler,
+                                astronode_downsampler_mode_t mode,
+                                uint32_t error_bound)
+{
+    memset(p_downsampler, 0, sizeof(astronode_downsampler_t));
+    p_downsampler->mode = mode;
+    p_downsampler->error_bound = error_bound;
+}
+
+bool astronode_downsampler_add_sample(astronode_downsampler_t *p_downsampler,
+                                      uint32_t timestamp,
+                                      int32_t value,
+                                      astronode_downsampler_point_t *p_output)
+{
+    astronode_downsampler_point_t point = { timestamp, value };
+    bool is_kept = false;
+
+    if (p_downsampler->has_archived == false)
+    {
+        p_downsampler->input_count++;
+        keep_point(p_downsampler, &point, p_output);
+        return true;
+    }
+
+    uint32_t last_timestamp = p_downsampler->has_pending ? p_downsampler->pending.timestamp
+                                                          : p_downsampler->archived.timestamp;
+    if (timestamp <= last_timestamp)
+    {
+        return false;
+    }
+
+    p_downsampler->input_count++;
+
+    if (p_downsampler->mode == ASTRONODE_DOWNSAMPLER_MODE_DEADBAND)
+    {
+        int64_t change = (int64_t) value - p_downsampler->archived.value;
+
+        if (change > p_downsampler->error_bound
+            || -change > p_downsampler->error_bound
+            || p_downsampler->segment_count + 1 >= ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES)
+        {
+            keep_point(p_downsampler, &point, p_output);
+            return true;
+        }
+
+        p_downsampler->pending = point;
+        p_downsampler->has_pending = true;
+        p_downsampler->segment_count++;
+        return false;
+    }
+
+    // The pending sample ends the segment as long as the line from the archived sample
+    // stays within the error bound of every sample in between: its slope must be inside
+    // the door formed by their windows. When the new sample falls outside, the pending
+    // sample is kept and a new segment starts from it.
+    float time_delta = (float) (timestamp - p_downsampler->archived.timestamp);
+    float slope = ((float) value - p_downsampler->archived.value) / time_delta;
+
+    if (p_downsampler->has_pending
+        && (slope < p_downsampler->lower_slope
+            || slope > p_downsampler->upper_slope
+            || p_downsampler->segment_count >= ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES))
+    {
+        astronode_downsampler_point_t pending = p_downsampler->pending;
+
+        keep_point(p_downsampler, &pending, p_output);
+        is_kept = true;
+        time_delta = (float) (timestamp - p_downsampler->archived.timestamp);
+    }
+
+    float offset = (float) value - p_downsampler->archived.value;
+    float lower_slope = (offset - p_downsampler->error_bound) / time_delta;
+    float upper_slope = (offset + p_downsampler->error_bound) / time_delta;
+
+    if (p_downsampler->has_pending == false || lower_slope > p_downsampler->lower_slope)
+    {
+        p_downsampler->lower_slope = lower_slope;
+    }
+    if (p_downsampler->has_pending == false || upper_slope < p_downsampler->upper_slope)
+    {
+        p_downsampler->upper_slope = upper_slope;
+    }
+
+    p_downsampler->pending = point;
+    p_downsampler->has_pending = true;
+    p_downsampler->segment_count++;
+
+    return is_kept;
+}
+
+bool astronode_downsampler_flush(astronode_downsampler_t *p_downsampler, astronode_downsampler_point_t *p_output)
+{
+    if (p_downsampler->has_pending == false)
+    {
+        return false;
+    }
+
+    astronode_downsampler_point_t pending = p_downsampler->pending;
+
+    keep_point(p_downsampler, &pending, p_output);
+    return true;
+}
+
+uint16_t astronode_downsampler_get_reduction_ratio(const astronode_downsampler_t *p_downsampler)
+{
+    if (p_downsampler->input_count == 0)
+    {
+        return 0;
+    }
+    return (uint16_t) ((uint64_t) (p_downsampler->input_count - p_downsampler->output_count) * 1000
+                       / p_downsampler->input_count);
+}
+
+uint8_t astronode_downsampler_encode_point(const astronode_downsampler_point_t *p_previous,
+                                           const astronode_downsampler_point_t *p_point,
+                                           uint8_t *p_buffer)
+{
+    uint8_t length = 0;
+
+    if (p_previous == NULL)
+    {
+        length += astronode_varint_encode(p_point->timestamp, &p_buffer[length]);
+        length += astronode_varint_encode(astronode_zigzag_encode(p_point->value), &p_buffer[length]);
+    }
+    else
+    {
+        length += astronode_varint_encode(p_point->timestamp - p_previous->timestamp, &p_buffer[length]);
+        length += astronode_varint_encode(astronode_zigzag_encode((int32_t) ((uint32_t) p_point->value - (uint32_t) p_previous->value)),
+                                          &p_buffer[length]);
+    }
+
+    return length;
+}
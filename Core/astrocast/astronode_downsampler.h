@@ -0,0 +1,106 @@
+#ifndef ASTRONODE_DOWNSAMPLER_H
+#define ASTRONODE_DOWNSAMPLER_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_packer.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Payload layout:
+// format | varint timestamp and zigzag varint value of the first point |
+// next points: varint timestamp delta and zigzag varint value delta to the previous point
+#define ASTRONODE_DOWNSAMPLER_FORMAT_POINTS         ASTRONODE_UPLINK_FORMAT_TRACE_POINTS
+#define ASTRONODE_DOWNSAMPLER_POINT_MAX_LEN_BYTES   (2 * ASTRONODE_VARINT_MAX_LEN_BYTES)
+
+// A point is kept at least every ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES samples.
+#ifndef ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES
+#define ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES   3600
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_downsampler_mode_t
+{
+    // Keep a sample when it moves more than the error bound from the last kept one.
+    // The signal is rebuilt by holding the last kept value.
+    ASTRONODE_DOWNSAMPLER_MODE_DEADBAND,
+    // Swinging door: keep the samples ending straight segments. The signal is rebuilt
+    // by linear interpolation between the kept samples.
+    ASTRONODE_DOWNSAMPLER_MODE_SWINGING_DOOR
+} astronode_downsampler_mode_t;
+
+typedef struct astronode_downsampler_point_t
+{
+    uint32_t    timestamp;
+    int32_t     value;
+} astronode_downsampler_point_t;
+
+typedef struct astronode_downsampler_t
+{
+    astronode_downsampler_mode_t    mode;
+    uint32_t                        error_bound;
+    bool                            has_archived;
+    bool                            has_pending;
+    astronode_downsampler_point_t   archived;
+    astronode_downsampler_point_t   pending;
+    float                           lower_slope;
+    float                           upper_slope;
+    uint16_t                        segment_count;
+    uint32_t                        input_count;
+    uint32_t                        output_count;
+} astronode_downsampler_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Prepare a downsampler. Every dropped sample stays within error_bound of
+ * the signal rebuilt from the kept samples.
+ */
+void astronode_downsampler_init(astronode_downsampler_t *p_downsampler,
+                                astronode_downsampler_mode_t mode,
+                                uint32_t error_bound);
+
+/**
+ * @brief Add a sample, timestamps must be strictly increasing. Return true if a point
+ * is kept, it is then written to p_output.
+ */
+bool astronode_downsampler_add_sample(astronode_downsampler_t *p_downsampler,
+                                      uint32_t timestamp,
+                                      int32_t value,
+                                      astronode_downsampler_point_t *p_output);
+
+/**
+ * @brief Keep the last sample if it is not kept yet, to close the trace.
+ */
+bool astronode_downsampler_flush(astronode_downsampler_t *p_downsampler, astronode_downsampler_point_t *p_output);
+
+/**
+ * @brief Return the ratio of dropped samples in per mille.
+ */
+uint16_t astronode_downsampler_get_reduction_ratio(const astronode_downsampler_t *p_downsampler);
+
+/**
+ * @brief Encode a point relative to the previous one (NULL for the first point of a
+ * payload), return the number of bytes written.
+ */
+uint8_t astronode_downsampler_encode_point(const astronode_downsampler_point_t *p_previous,
+                                           const astronode_downsampler_point_t *p_point,
+                                           uint8_t *p_buffer);
+
+
+#endif /* ASTRONODE_DOWNSAMPLER_H */
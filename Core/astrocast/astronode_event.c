@@ -0,0 +1,117 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_downlink.h"
+#include "astronode_event.h"
+#include "astronode_payload_policy.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define EVENT_DEBUG_BUFFER_LENGTH 64
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static astronode_ctx_t *g_p_ctx = NULL;
+static astronode_event_acknowledge_t g_acknowledge = NULL;
+static uint32_t g_last_round_trips = 0;
+static uint32_t g_max_round_trips = 0;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_event_init(astronode_ctx_t *p_ctx, astronode_event_acknowledge_t acknowledge)
+{
+    g_p_ctx = p_ctx;
+    g_acknowledge = acknowledge;
+    g_last_round_trips = 0;
+    g_max_round_trips = 0;
+}
+
+void astronode_event_process(void)
+{
+    char str[EVENT_DEBUG_BUFFER_LENGTH];
+    uint32_t round_trip_start = astronode_transport_get_round_trip_count(g_p_ctx);
+
+    for (uint8_t pass = 0; pass < ASTRONODE_EVENT_MAX_PASSES && g_p_ctx->p_uart_ops->is_evt_pin_high(g_p_ctx->p_port); pass++)
+    {
+        uint8_t events = 0;
+
+        if (astronode_send_evt_rr(g_p_ctx, &events) != RS_SUCCESS)
+        {
+            break;
+        }
+
+        // A fetched command keeps the EVT pin high until the downlink dispatcher clears it.
+        if (astronode_downlink_is_pending())
+        {
+            events &= ~ASTRONODE_EVENT_CMD_AVAILABLE;
+        }
+
+        if ((events & (ASTRONODE_EVENT_RESET | ASTRONODE_EVENT_MSG_ACK | ASTRONODE_EVENT_CMD_AVAILABLE)) == 0)
+        {
+            break;
+        }
+
+        if (events & ASTRONODE_EVENT_RESET)
+        {
+            astronode_send_res_cr(g_p_ctx);
+            astronode_payload_policy_forget(g_p_ctx);
+        }
+
+        if (events & ASTRONODE_EVENT_MSG_ACK)
+        {
+            uint16_t payload_id = 0;
+
+            // The acknowledgment is only cleared once read, otherwise it would be lost.
+            if (astronode_send_sak_rr(g_p_ctx, &payload_id) == RS_SUCCESS)
+            {
+                if (g_acknowledge != NULL)
+                {
+                    g_acknowledge(payload_id);
+                }
+                astronode_send_sak_cr(g_p_ctx);
+            }
+        }
+
+        if (events & ASTRONODE_EVENT_CMD_AVAILABLE)
+        {
+            astronode_downlink_fetch();
+        }
+    }
+
+    g_last_round_trips = astronode_transport_get_round_trip_count(g_p_ctx) - round_trip_start;
+    if (g_last_round_trips > g_max_round_trips)
+    {
+        g_max_round_trips = g_last_round_trips;
+    }
+
+    sprintf(str, "Events processed in %" PRIu32 " round trips.", g_last_round_trips);
+    send_debug_logs(str);
+}
+
+uint32_t astronode_event_get_last_round_trips(void)
+{
+    return g_last_round_trips;
+}
+
+uint32_t astronode_event_get_max_round_trips(void)
+{
+    return g_max_round_trips;
+}
@@ -0,0 +1,60 @@
+#ifndef ASTRONODE_EVENT_H
+#define ASTRONODE_EVENT_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Maximum number of EVT_RR read while the EVT pin stays high.
+#ifndef ASTRONODE_EVENT_MAX_PASSES
+#define ASTRONODE_EVENT_MAX_PASSES 4
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+/**
+ * @brief Called with the ID of each payload acknowledged by the satellite.
+ */
+typedef void (*astronode_event_acknowledge_t)(uint16_t payload_id);
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Bind the event processing to this Astronode and register the callback receiving the acknowledged payload IDs.
+ */
+void astronode_event_init(astronode_ctx_t *p_ctx, astronode_event_acknowledge_t acknowledge);
+
+/**
+ * @brief Read the events once per pass and send only the transactions they require:
+ * RES_CR on reset, SAK_RR/SAK_CR on acknowledgment, CMD_RR on command (cleared later by
+ * the downlink dispatcher). Repeat until the EVT pin is low.
+ */
+void astronode_event_process(void);
+
+/**
+ * @brief Return the number of round trips used by the last processing.
+ */
+uint32_t astronode_event_get_last_round_trips(void);
+
+/**
+ * @brief Return the maximum number of round trips used by a processing.
+ */
+uint32_t astronode_event_get_max_round_trips(void);
+
+
+#endif /* ASTRONODE_EVENT_H */
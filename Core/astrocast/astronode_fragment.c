@@ -0,0 +1,206 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_fragment.h"
+#include "astronode_payload_policy.h"
+#include "astronode_transport.h"
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct fragment_state_t
+{
+    bool        is_sent;
+    uint16_t    payload_id;
+} fragment_state_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const uint8_t *g_p_record = NULL;
+static uint16_t g_record_length = 0;
+static uint16_t g_record_crc = 0;
+static uint8_t g_message_id = 0;
+static uint8_t g_fragment_count = 0;
+static uint16_t g_acked_mask = 0;
+static fragment_state_t g_fragments[ASTRONODE_FRAGMENT_MAX_COUNT];
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+return_status_t astronode_fragment_send(const uint8_t *p_record, uint16_t record_length)
+{
+    if (astronode_fragment_is_complete() == false
+        || record_length == 0
+        || record_length > ASTRONODE_FRAGMENT_RECORD_MAX_LEN_BYTES)
+    {
+        return RS_FAILURE;
+    }
+
+    g_p_record = p_record;
+    g_record_length = record_length;
+    g_record_crc = astronode_transport_calculate_crc(p_record, record_length);
+    // Wraps from 255 to 0, the reassembler orders the IDs modulo 256.
+    g_message_id++;
+    g_fragment_count = (record_length + ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES - 1) / ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES;
+    g_acked_mask = 0;
+    memset(g_fragments, 0, sizeof(g_fragments));
+
+    astronode_fragment_service();
+
+    return RS_SUCCESS;
+}
+
+void astronode_fragment_service(void)
+{
+    for (uint8_t i = 0; i < g_fragment_count; i++)
+    {
+        if ((g_acked_mask & (1 << i))
+            || (g_fragments[i].is_sent && astronode_payload_policy_is_queued(g_fragments[i].payload_id)))
+        {
+            continue;
+        }
+
+        if (astronode_payload_policy_get_queue_count() >= ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH)
+        {
+            return;
+        }
+
+        char p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+        uint16_t offset = i * ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES;
+        uint16_t data_length = g_record_length - offset;
+
+        if (data_length > ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES)
+        {
+            data_length = ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES;
+        }
+
+        p_payload[0] = ASTRONODE_FRAGMENT_FORMAT;
+        p_payload[1] = g_message_id;
+        p_payload[2] = (i << 4) | (g_fragment_count - 1);
+        p_payload[3] = (uint8_t) g_record_crc;
+        p_payload[4] = (uint8_t) (g_record_crc >> 8);
+        memcpy(&p_payload[ASTRONODE_FRAGMENT_HEADER_LEN_BYTES], &g_p_record[offset], data_length);
+
+        if (astronode_payload_policy_enqueue(ASTRONODE_FRAGMENT_PAYLOAD_CLASS,
+                                             p_payload,
+                                             ASTRONODE_FRAGMENT_HEADER_LEN_BYTES + data_length) != RS_SUCCESS)
+        {
+            return;
+        }
+
+        g_fragments[i].is_sent = true;
+        g_fragments[i].payload_id = astronode_payload_policy_get_last_payload_id();
+    }
+}
+
+void astronode_fragment_acknowledge(uint16_t payload_id)
+{
+    for (uint8_t i = 0; i < g_fragment_count; i++)
+    {
+        if (g_fragments[i].is_sent && g_fragments[i].payload_id == payload_id)
+        {
+            g_acked_mask |= 1 << i;
+            return;
+        }
+    }
+}
+
+bool astronode_fragment_is_complete(void)
+{
+    return g_acked_mask == (uint16_t) ((1UL << g_fragment_count) - 1);
+}
+
+void astronode_reassembler_init(astronode_reassembler_t *p_reassembler, uint8_t *p_buffer, uint16_t capacity)
+{
+    memset(p_reassembler, 0, sizeof(astronode_reassembler_t));
+    p_reassembler->p_buffer = p_buffer;
+    p_reassembler->capacity = capacity;
+}
+
+return_status_t astronode_reassembler_add(astronode_reassembler_t *p_reassembler,
+                                          const uint8_t *p_payload,
+                                          uint16_t payload_length,
+                                          bool *p_is_complete)
+{
+    *p_is_complete = false;
+
+    if (payload_length <= ASTRONODE_FRAGMENT_HEADER_LEN_BYTES || p_payload[0] != ASTRONODE_FRAGMENT_FORMAT)
+    {
+        return RS_FAILURE;
+    }
+
+    uint8_t message_id = p_payload[1];
+    uint8_t index = p_payload[2] >> 4;
+    uint8_t fragment_count = (p_payload[2] & 0x0F) + 1;
+    uint16_t crc = p_payload[3] + (p_payload[4] << 8);
+    uint16_t data_length = payload_length - ASTRONODE_FRAGMENT_HEADER_LEN_BYTES;
+    uint16_t offset = index * ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES;
+
+    if (index >= fragment_count
+        || (index + 1 < fragment_count && data_length != ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES)
+        || offset + data_length > p_reassembler->capacity)
+    {
+        return RS_FAILURE;
+    }
+
+    if (p_reassembler->is_last_message_id_valid)
+    {
+        // Serial number arithmetic (RFC 1982): the 127 IDs behind the last one belong to
+        // older records, the 128 ahead of it to newer ones.
+        int8_t distance = (int8_t) (message_id - p_reassembler->last_message_id);
+
+        if (distance < 0 || (distance == 0 && p_reassembler->is_started == false))
+        {
+            // Late or repeated fragment of a record already completed or abandoned.
+            return RS_SUCCESS;
+        }
+    }
+    p_reassembler->is_last_message_id_valid = true;
+    p_reassembler->last_message_id = message_id;
+
+    if (p_reassembler->is_started == false
+        || p_reassembler->message_id != message_id
+        || p_reassembler->fragment_count != fragment_count
+        || p_reassembler->crc != crc)
+    {
+        p_reassembler->is_started = true;
+        p_reassembler->message_id = message_id;
+        p_reassembler->fragment_count = fragment_count;
+        p_reassembler->crc = crc;
+        p_reassembler->received_mask = 0;
+        p_reassembler->length = 0;
+    }
+
+    memcpy(&p_reassembler->p_buffer[offset], &p_payload[ASTRONODE_FRAGMENT_HEADER_LEN_BYTES], data_length);
+    p_reassembler->received_mask |= 1 << index;
+
+    if (index + 1 == fragment_count)
+    {
+        p_reassembler->length = offset + data_length;
+    }
+
+    if (p_reassembler->received_mask == (uint16_t) ((1UL << fragment_count) - 1))
+    {
+        if (astronode_transport_calculate_crc(p_reassembler->p_buffer, p_reassembler->length) != crc)
+        {
+            p_reassembler->is_started = false;
+            return RS_FAILURE;
+        }
+        *p_is_complete = true;
+        p_reassembler->is_started = false;
+    }
+
+    return RS_SUCCESS;
+}
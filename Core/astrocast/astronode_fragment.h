@@ -0,0 +1,93 @@
+#ifndef ASTRONODE_FRAGMENT_H
+#define ASTRONODE_FRAGMENT_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Fragment header: format | message ID | index (4 bits) and count - 1 (4 bits) | CRC-16 of the record
+#define ASTRONODE_FRAGMENT_FORMAT               ASTRONODE_UPLINK_FORMAT_FRAGMENT
+#define ASTRONODE_FRAGMENT_HEADER_LEN_BYTES     5
+#define ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES   (ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES - ASTRONODE_FRAGMENT_HEADER_LEN_BYTES)
+#define ASTRONODE_FRAGMENT_MAX_COUNT            16
+#define ASTRONODE_FRAGMENT_RECORD_MAX_LEN_BYTES (ASTRONODE_FRAGMENT_MAX_COUNT * ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES)
+
+// Payload policy class used to enqueue the fragments.
+#ifndef ASTRONODE_FRAGMENT_PAYLOAD_CLASS
+#define ASTRONODE_FRAGMENT_PAYLOAD_CLASS        1
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct astronode_reassembler_t
+{
+    uint8_t    *p_buffer;
+    uint16_t    capacity;
+    uint16_t    length;
+    bool        is_started;
+    uint8_t     message_id;
+    uint8_t     fragment_count;
+    uint16_t    received_mask;
+    uint16_t    crc;
+    bool        is_last_message_id_valid;
+    uint8_t     last_message_id;
+} astronode_reassembler_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Start sending a record split in fragments. The record is not copied and must
+ * stay valid until astronode_fragment_is_complete() returns true.
+ */
+return_status_t astronode_fragment_send(const uint8_t *p_record, uint16_t record_length);
+
+/**
+ * @brief Enqueue the fragments that are neither acknowledged nor in the Astronode queue:
+ * not sent yet, or dropped from the queue before being acknowledged.
+ */
+void astronode_fragment_service(void);
+
+/**
+ * @brief Mark the fragment sent with this payload ID as acknowledged (SAK_RR).
+ */
+void astronode_fragment_acknowledge(uint16_t payload_id);
+
+/**
+ * @brief Check if all the fragments of the current record are acknowledged.
+ */
+bool astronode_fragment_is_complete(void);
+
+/**
+ * @brief Prepare a reassembler writing the records in p_buffer.
+ */
+void astronode_reassembler_init(astronode_reassembler_t *p_reassembler, uint8_t *p_buffer, uint16_t capacity);
+
+/**
+ * @brief Add a received fragment. A fragment of a newer message restarts the reassembly,
+ * a late fragment of an older message or of the last completed one is ignored. The 8 bits
+ * message IDs are compared with serial number arithmetic, across their wrap from 255 to 0.
+ * p_is_complete is set once all fragments are received and the CRC of the record matches.
+ */
+return_status_t astronode_reassembler_add(astronode_reassembler_t *p_reassembler,
+                                          const uint8_t *p_payload,
+                                          uint16_t payload_length,
+                                          bool *p_is_complete);
+
+
+#endif /* ASTRONODE_FRAGMENT_H */
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_geolocation.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// One unit of 1e-7 degree of latitude is 1.1132 cm: 1 m is 89.83 units.
+#define GEOLOCATION_UNITS_PER_100_M     8983
+
+#define GEOLOCATION_UNITS_PER_DEGREE    10000000
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// cos(latitude) in Q15 for each degree from 0 to 90.
+static const uint16_t g_cos_q15[91] =
+{
+    32768, 32763, 32748, 32723, 32688, 32643, 32588, 32524, 32449, 32365,
+    32270, 32166, 32052, 31928, 31795, 31651, 31499, 31336, 31164, 30983,
+    30792, 30592, 30382, 30163, 29935, 29698, 29452, 29197, 28932, 28660,
+    28378, 28088, 27789, 27482, 27166, 26842, 26510, 26170, 25822, 25466,
+    25102, 24730, 24351, 23965, 23571, 23170, 22763, 22348, 21926, 21498,
+    21063, 20622, 20174, 19720, 19261, 18795, 18324, 17847, 17364, 16877,
+    16384, 15886, 15384, 14876, 14365, 13848, 13328, 12803, 12275, 11743,
+    11207, 10668, 10126, 9580, 9032, 8481, 7927, 7371, 6813, 6252,
+    5690, 5126, 4560, 3993, 3425, 2856, 2286, 1715, 1144, 572,
+    0
+};
+
+static astronode_ctx_t *g_p_ctx = NULL;
+static uint64_t g_min_distance_squared = 0;
+static uint32_t g_max_age_ms = ASTRONODE_GEOLOCATION_NO_MAX_AGE;
+static bool g_is_applied = false;
+static int32_t g_applied_latitude = 0;
+static int32_t g_applied_longitude = 0;
+static uint32_t g_applied_time_ms = 0;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_geolocation_init(astronode_ctx_t *p_ctx, uint32_t min_distance_m, uint32_t max_age_ms)
+{
+    uint64_t min_distance = (uint64_t) min_distance_m * GEOLOCATION_UNITS_PER_100_M / 100;
+
+    g_p_ctx = p_ctx;
+    g_min_distance_squared = min_distance * min_distance;
+    g_max_age_ms = max_age_ms;
+    g_is_applied = false;
+}
+
+bool astronode_geolocation_is_valid(int32_t latitude, int32_t longitude)
+{
+    return latitude >= -ASTRONODE_GEOLOCATION_LATITUDE_MAX
+           && latitude <= ASTRONODE_GEOLOCATION_LATITUDE_MAX
+           && longitude >= -ASTRONODE_GEOLOCATION_LONGITUDE_MAX
+           && longitude <= ASTRONODE_GEOLOCATION_LONGITUDE_MAX;
+}
+
+bool astronode_geolocation_is_update_needed(int32_t latitude, int32_t longitude, uint32_t now_ms)
+{
+    if (g_is_applied == false)
+    {
+        return true;
+    }
+
+    if (g_max_age_ms != ASTRONODE_GEOLOCATION_NO_MAX_AGE && now_ms - g_applied_time_ms >= g_max_age_ms)
+    {
+        return true;
+    }
+
+    // Equirectangular approximation: the longitude difference is scaled by the cosine
+    // of the mean latitude, good enough for thresholds up to hundreds of kilometers.
+    int64_t delta_latitude = (int64_t) latitude - g_applied_latitude;
+    int64_t delta_longitude = (int64_t) longitude - g_applied_longitude;
+
+    if (delta_longitude > ASTRONODE_GEOLOCATION_LONGITUDE_MAX)
+    {
+        delta_longitude -= 2LL * ASTRONODE_GEOLOCATION_LONGITUDE_MAX;
+    }
+    else if (delta_longitude < -ASTRONODE_GEOLOCATION_LONGITUDE_MAX)
+    {
+        delta_longitude += 2LL * ASTRONODE_GEOLOCATION_LONGITUDE_MAX;
+    }
+
+    int32_t mean_latitude = (int32_t) (((int64_t) latitude + g_applied_latitude) / 2);
+    uint32_t degree = (uint32_t) abs(mean_latitude) / GEOLOCATION_UNITS_PER_DEGREE;
+    int64_t x = delta_longitude * g_cos_q15[degree] / 32768;
+    uint64_t distance_squared = (uint64_t) (x * x) + (uint64_t) (delta_latitude * delta_latitude);
+
+    return distance_squared >= g_min_distance_squared;
+}
+
+return_status_t astronode_geolocation_update(int32_t latitude, int32_t longitude)
+{
+    if (astronode_geolocation_is_valid(latitude, longitude) == false)
+    {
+        send_debug_logs("Geolocation out of range, not written.");
+        return RS_FAILURE;
+    }
+
+    if (astronode_geolocation_is_update_needed(latitude, longitude, get_systick()) == false)
+    {
+        return RS_SUCCESS;
+    }
+
+    if (astronode_send_geo_wr(g_p_ctx, latitude, longitude) != RS_SUCCESS)
+    {
+        return RS_FAILURE;
+    }
+
+    g_is_applied = true;
+    g_applied_latitude = latitude;
+    g_applied_longitude = longitude;
+    g_applied_time_ms = get_systick();
+
+    return RS_SUCCESS;
+}
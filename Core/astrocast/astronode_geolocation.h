@@ -0,0 +1,52 @@
+#ifndef ASTRONODE_GEOLOCATION_H
+#define ASTRONODE_GEOLOCATION_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// GEO_WR latitude and longitude are in 1e-7 degree.
+#define ASTRONODE_GEOLOCATION_LATITUDE_MAX      900000000
+#define ASTRONODE_GEOLOCATION_LONGITUDE_MAX     1800000000
+
+#define ASTRONODE_GEOLOCATION_NO_MAX_AGE        0
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Forget the applied position and set the update thresholds: the position is
+ * written again when the asset moved by min_distance_m or when it is older than max_age_ms.
+ */
+void astronode_geolocation_init(astronode_ctx_t *p_ctx, uint32_t min_distance_m, uint32_t max_age_ms);
+
+/**
+ * @brief Check that the position is within the GEO_WR ranges.
+ */
+bool astronode_geolocation_is_valid(int32_t latitude, int32_t longitude);
+
+/**
+ * @brief Check if the position has to be written at now_ms (moved or expired).
+ */
+bool astronode_geolocation_is_update_needed(int32_t latitude, int32_t longitude, uint32_t now_ms);
+
+/**
+ * @brief Write the position with GEO_WR if needed. Invalid positions are rejected
+ * without any request sent to the Astronode.
+ */
+return_status_t astronode_geolocation_update(int32_t latitude, int32_t longitude);
+
+
+#endif /* ASTRONODE_GEOLOCATION_H */
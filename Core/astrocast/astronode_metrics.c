@@ -0,0 +1,348 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_metrics.h"
+#include "astronode_packer.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Read-modify-write without a lock: LDREX/STREX on Cortex-M4, so a counter is never
+// torn by an interrupt or a task reading a snapshot.
+#define METRICS_ADD(p_counter, value)   __atomic_fetch_add((p_counter), (value), __ATOMIC_RELAXED)
+#define METRICS_LOAD(p_counter)         __atomic_load_n((p_counter), __ATOMIC_RELAXED)
+#define METRICS_TAKE(p_counter)         __atomic_exchange_n((p_counter), 0, __ATOMIC_RELAXED)
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static astronode_metrics_error_code_index_t get_error_code_index(uint16_t error_code);
+static uint32_t read_counter(uint32_t *p_counter, bool is_reset);
+static bool write_varint(uint32_t value, uint8_t *p_buffer, uint16_t *p_length, uint16_t capacity);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const char *g_p_counter_names[ASTRONODE_METRICS_COUNTER_COUNT] =
+{
+#define ASTRONODE_METRICS_COUNTER_NAME(counter, name) name,
+    ASTRONODE_METRICS_COUNTERS(ASTRONODE_METRICS_COUNTER_NAME)
+#undef ASTRONODE_METRICS_COUNTER_NAME
+};
+
+static const char *g_p_failure_names[ASTRONODE_METRICS_FAILURE_COUNT] =
+{
+#define ASTRONODE_METRICS_FAILURE_NAME(failure, name) name,
+    ASTRONODE_METRICS_FAILURES(ASTRONODE_METRICS_FAILURE_NAME)
+#undef ASTRONODE_METRICS_FAILURE_NAME
+};
+
+static const char *g_p_error_code_names[ASTRONODE_METRICS_ERROR_CODE_COUNT] =
+{
+#define ASTRONODE_METRICS_ERROR_CODE_NAME(error_code, name) name,
+    ASTRONODE_METRICS_ERROR_CODES(ASTRONODE_METRICS_ERROR_CODE_NAME)
+#undef ASTRONODE_METRICS_ERROR_CODE_NAME
+    "other"
+};
+
+static const uint16_t g_p_error_codes[ASTRONODE_METRICS_ERROR_CODE_COUNT] =
+{
+#define ASTRONODE_METRICS_ERROR_CODE_VALUE(error_code, name) error_code,
+    ASTRONODE_METRICS_ERROR_CODES(ASTRONODE_METRICS_ERROR_CODE_VALUE)
+#undef ASTRONODE_METRICS_ERROR_CODE_VALUE
+    0
+};
+
+static const uint8_t g_p_request_op_codes[ASTRONODE_METRICS_OP_CODE_COUNT] =
+{
+#define ASTRONODE_METRICS_OP_CODE_VALUE(request, answer, min_length, max_length, timeout_ms) request,
+    ASTRONODE_OP_CODE_DESCRIPTORS(ASTRONODE_METRICS_OP_CODE_VALUE)
+#undef ASTRONODE_METRICS_OP_CODE_VALUE
+    ASTRONODE_METRICS_OTHER_OP_CODE
+};
+
+// Indexed by the request op code: table index + 1, 0 for the unlisted op codes.
+static const uint8_t g_p_op_code_indexes[0x80] =
+{
+#define ASTRONODE_METRICS_OP_CODE_INDEX(request, answer, min_length, max_length, timeout_ms) \
+    [request] = ASTRONODE_METRICS_OP_CODE_INDEX_##request + 1,
+    ASTRONODE_OP_CODE_DESCRIPTORS(ASTRONODE_METRICS_OP_CODE_INDEX)
+#undef ASTRONODE_METRICS_OP_CODE_INDEX
+};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_metrics_reset(astronode_ctx_t *p_ctx)
+{
+    astronode_metrics_snapshot_t snapshot;
+
+    astronode_metrics_snapshot(p_ctx, &snapshot, true);
+}
+
+void astronode_metrics_add(astronode_ctx_t *p_ctx, astronode_metrics_counter_t counter, uint32_t value)
+{
+    METRICS_ADD(&p_ctx->metrics.p_counters[counter], value);
+}
+
+void astronode_metrics_count_failure(astronode_ctx_t *p_ctx, astronode_metrics_failure_t failure)
+{
+    METRICS_ADD(&p_ctx->metrics.p_failures[failure], 1);
+}
+
+void astronode_metrics_count_error_code(astronode_ctx_t *p_ctx, uint16_t error_code)
+{
+    METRICS_ADD(&p_ctx->metrics.p_error_codes[get_error_code_index(error_code)], 1);
+}
+
+void astronode_metrics_count_transaction(astronode_ctx_t *p_ctx, uint8_t op_code, astronode_metrics_outcome_t outcome)
+{
+    uint8_t index = op_code < 0x80 ? g_p_op_code_indexes[op_code] : 0;
+
+    index = index > 0 ? index - 1 : ASTRONODE_METRICS_OP_CODE_INDEX_OTHER;
+    METRICS_ADD(&p_ctx->metrics.p_op_codes[index][outcome], 1);
+}
+
+void astronode_metrics_snapshot(astronode_ctx_t *p_ctx, astronode_metrics_snapshot_t *p_snapshot, bool is_reset)
+{
+    astronode_metrics_registry_t *p_registry = &p_ctx->metrics;
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_COUNTER_COUNT; i++)
+    {
+        p_snapshot->p_counters[i] = read_counter(&p_registry->p_counters[i], is_reset);
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_FAILURE_COUNT; i++)
+    {
+        p_snapshot->p_failures[i] = read_counter(&p_registry->p_failures[i], is_reset);
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_ERROR_CODE_COUNT; i++)
+    {
+        p_snapshot->p_error_codes[i] = read_counter(&p_registry->p_error_codes[i], is_reset);
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_OP_CODE_COUNT; i++)
+    {
+        p_snapshot->p_op_codes[i].op_code = g_p_request_op_codes[i];
+        for (uint8_t j = 0; j < ASTRONODE_METRICS_OUTCOME_COUNT; j++)
+        {
+            p_snapshot->p_op_codes[i].p_outcomes[j] = read_counter(&p_registry->p_op_codes[i][j], is_reset);
+        }
+    }
+}
+
+const char *astronode_metrics_get_counter_name(astronode_metrics_counter_t counter)
+{
+    return g_p_counter_names[counter];
+}
+
+const char *astronode_metrics_get_failure_name(astronode_metrics_failure_t failure)
+{
+    return g_p_failure_names[failure];
+}
+
+const char *astronode_metrics_get_error_code_name(astronode_metrics_error_code_index_t index)
+{
+    return g_p_error_code_names[index];
+}
+
+void astronode_metrics_dump(const astronode_metrics_snapshot_t *p_snapshot)
+{
+    char str[96];
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_COUNTER_COUNT; i++)
+    {
+        sprintf(str, "Metrics %s: %" PRIu32 ".", g_p_counter_names[i], p_snapshot->p_counters[i]);
+        send_debug_logs(str);
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_FAILURE_COUNT; i++)
+    {
+        if (p_snapshot->p_failures[i] > 0)
+        {
+            sprintf(str, "Metrics failure %s: %" PRIu32 ".", g_p_failure_names[i], p_snapshot->p_failures[i]);
+            send_debug_logs(str);
+        }
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_ERROR_CODE_COUNT; i++)
+    {
+        if (p_snapshot->p_error_codes[i] > 0)
+        {
+            sprintf(str, "Metrics error %s: %" PRIu32 ".", g_p_error_code_names[i], p_snapshot->p_error_codes[i]);
+            send_debug_logs(str);
+        }
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_OP_CODE_COUNT; i++)
+    {
+        const astronode_metrics_op_code_t *p_op_code = &p_snapshot->p_op_codes[i];
+
+        if (p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_SUCCESS] > 0
+            || p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_TIMEOUT] > 0
+            || p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_FAILURE] > 0)
+        {
+            sprintf(str, "Metrics op code 0x%02X: %" PRIu32 " successes, %" PRIu32 " timeouts, %" PRIu32 " failures.",
+                    p_op_code->op_code,
+                    p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_SUCCESS],
+                    p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_TIMEOUT],
+                    p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_FAILURE]);
+            send_debug_logs(str);
+        }
+    }
+}
+
+uint16_t astronode_metrics_serialize(const astronode_metrics_snapshot_t *p_snapshot, uint8_t *p_buffer, uint16_t capacity)
+{
+    uint16_t length = 0;
+    uint16_t count_index = 0;
+
+    if (capacity < 2)
+    {
+        return 0;
+    }
+    p_buffer[length++] = ASTRONODE_METRICS_FORMAT_COUNTERS;
+    p_buffer[length++] = ASTRONODE_METRICS_COUNTER_COUNT;
+
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_COUNTER_COUNT; i++)
+    {
+        if (write_varint(p_snapshot->p_counters[i], p_buffer, &length, capacity) == false)
+        {
+            return 0;
+        }
+    }
+
+    // Each table starts with the number of its non-zero entries, written once they are known.
+    if (length + 1 > capacity)
+    {
+        return 0;
+    }
+    count_index = length++;
+    p_buffer[count_index] = 0;
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_FAILURE_COUNT; i++)
+    {
+        if (p_snapshot->p_failures[i] == 0)
+        {
+            continue;
+        }
+        if (length + 1 > capacity)
+        {
+            return 0;
+        }
+        p_buffer[length++] = i;
+        if (write_varint(p_snapshot->p_failures[i], p_buffer, &length, capacity) == false)
+        {
+            return 0;
+        }
+        p_buffer[count_index]++;
+    }
+
+    if (length + 1 > capacity)
+    {
+        return 0;
+    }
+    count_index = length++;
+    p_buffer[count_index] = 0;
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_ERROR_CODE_COUNT; i++)
+    {
+        if (p_snapshot->p_error_codes[i] == 0)
+        {
+            continue;
+        }
+        if (length + 2 > capacity)
+        {
+            return 0;
+        }
+        p_buffer[length++] = (uint8_t) g_p_error_codes[i];
+        p_buffer[length++] = (uint8_t) (g_p_error_codes[i] >> 8);
+        if (write_varint(p_snapshot->p_error_codes[i], p_buffer, &length, capacity) == false)
+        {
+            return 0;
+        }
+        p_buffer[count_index]++;
+    }
+
+    if (length + 1 > capacity)
+    {
+        return 0;
+    }
+    count_index = length++;
+    p_buffer[count_index] = 0;
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_OP_CODE_COUNT; i++)
+    {
+        const astronode_metrics_op_code_t *p_op_code = &p_snapshot->p_op_codes[i];
+
+        if (p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_SUCCESS] == 0
+            && p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_TIMEOUT] == 0
+            && p_op_code->p_outcomes[ASTRONODE_METRICS_OUTCOME_FAILURE] == 0)
+        {
+            continue;
+        }
+        if (length + 1 > capacity)
+        {
+            return 0;
+        }
+        p_buffer[length++] = p_op_code->op_code;
+        for (uint8_t j = 0; j < ASTRONODE_METRICS_OUTCOME_COUNT; j++)
+        {
+            if (write_varint(p_op_code->p_outcomes[j], p_buffer, &length, capacity) == false)
+            {
+                return 0;
+            }
+        }
+        p_buffer[count_index]++;
+    }
+
+    return length;
+}
+
+static astronode_metrics_error_code_index_t get_error_code_index(uint16_t error_code)
+{
+    switch (error_code)
+    {
+#define ASTRONODE_METRICS_ERROR_CODE_CASE(code, name) \
+        case code: \
+            return ASTRONODE_METRICS_ERROR_CODE_INDEX_##code;
+        ASTRONODE_METRICS_ERROR_CODES(ASTRONODE_METRICS_ERROR_CODE_CASE)
+#undef ASTRONODE_METRICS_ERROR_CODE_CASE
+
+        default:
+            return ASTRONODE_METRICS_ERROR_CODE_INDEX_OTHER;
+    }
+}
+
+static uint32_t read_counter(uint32_t *p_counter, bool is_reset)
+{
+    return is_reset ? METRICS_TAKE(p_counter) : METRICS_LOAD(p_counter);
+}
+
+static bool write_varint(uint32_t value, uint8_t *p_buffer, uint16_t *p_length, uint16_t capacity)
+{
+    uint8_t p_varint[ASTRONODE_VARINT_MAX_LEN_BYTES];
+    uint8_t varint_length = astronode_varint_encode(value, p_varint);
+
+    if (*p_length + varint_length > capacity)
+    {
+        return false;
+    }
+    memcpy(&p_buffer[*p_length], p_varint, varint_length);
+    *p_length += varint_length;
+
+    return true;
+}
@@ -0,0 +1,186 @@
+#ifndef ASTRONODE_METRICS_H
+#define ASTRONODE_METRICS_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Link counters: X(counter, name)
+#define ASTRONODE_METRICS_COUNTERS(X) \
+    X(TX_BYTES, "tx_bytes") \
+    X(RX_BYTES, "rx_bytes") \
+    X(RETRIES, "retries") \
+    X(RETRIES_EXHAUSTED, "retries_exhausted") \
+    X(RETRIES_SKIPPED, "retries_skipped") \
+    X(RETRIES_RECOVERED, "retries_recovered") \
+    X(BACKOFF_MS, "backoff_ms") \
+    X(CIRCUIT_OPENED, "circuit_opened") \
+    X(CIRCUIT_REJECTED, "circuit_rejected") \
+    X(CIRCUIT_CLOSED, "circuit_closed") \
+    X(NOISE_BYTES, "noise_bytes")
+
+// Answers rejected by the transport: X(failure, name)
+#define ASTRONODE_METRICS_FAILURES(X) \
+    X(TIMEOUT, "timeout") \
+    X(MISSING_STX, "missing_stx") \
+    X(MISSING_ETX, "missing_etx") \
+    X(ODD_LENGTH, "odd_length") \
+    X(BAD_HEX, "bad_hex") \
+    X(CRC_MISMATCH, "crc_mismatch") \
+    X(OVERLENGTH, "overlength") \
+    X(UNDERLENGTH, "underlength") \
+    X(UNEXPECTED_OP_CODE, "unexpected_op_code") \
+    X(TRUNCATED, "truncated")
+
+// Error codes answered by the Astronode, the others are counted together: X(error code, name)
+#define ASTRONODE_METRICS_ERROR_CODES(X) \
+    X(ASTRONODE_ERR_CODE_CRC_NOT_VALID, "crc_not_valid") \
+    X(ASTRONODE_ERR_CODE_LENGTH_NOT_VALID, "length_not_valid") \
+    X(ASTRONODE_ERR_CODE_OPCODE_NOT_VALID, "opcode_not_valid") \
+    X(ASTRONODE_ERR_CODE_FORMAT_NOT_VALID, "format_not_valid") \
+    X(ASTRONODE_ERR_CODE_FLASH_WRITING_FAILED, "flash_writing_failed") \
+    X(ASTRONODE_ERR_CODE_BUFFER_FULL, "buffer_full") \
+    X(ASTRONODE_ERR_CODE_DUPLICATE_ID, "duplicate_id") \
+    X(ASTRONODE_ERR_CODE_BUFFER_EMPTY, "buffer_empty") \
+    X(ASTRONODE_ERR_CODE_INVALID_POS, "invalid_pos") \
+    X(ASTRONODE_ERR_CODE_NO_ACK, "no_ack") \
+    X(ASTRONODE_ERR_CODE_NO_CLEAR, "no_clear")
+
+// Per request op code counters, one for each request of ASTRONODE_OP_CODE_DESCRIPTORS
+// and one shared by the other op codes.
+#define ASTRONODE_METRICS_OTHER_OP_CODE     0x00
+
+// Uplink payload layout, only the non-zero entries of each table are written:
+// format | counter count | varint per counter |
+// failure count | for each failure: failure index | varint count |
+// error code count | for each error code: error code (16 bits, 0 for the others) | varint count |
+// op code count | for each op code: request op code | varint successes | varint timeouts | varint failures
+#define ASTRONODE_METRICS_FORMAT_COUNTERS   ASTRONODE_UPLINK_FORMAT_METRICS
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_metrics_counter_t
+{
+#define ASTRONODE_METRICS_COUNTER_ENUM(counter, name) ASTRONODE_METRICS_COUNTER_##counter,
+    ASTRONODE_METRICS_COUNTERS(ASTRONODE_METRICS_COUNTER_ENUM)
+#undef ASTRONODE_METRICS_COUNTER_ENUM
+    ASTRONODE_METRICS_COUNTER_COUNT
+} astronode_metrics_counter_t;
+
+typedef enum astronode_metrics_failure_t
+{
+#define ASTRONODE_METRICS_FAILURE_ENUM(failure, name) ASTRONODE_METRICS_FAILURE_##failure,
+    ASTRONODE_METRICS_FAILURES(ASTRONODE_METRICS_FAILURE_ENUM)
+#undef ASTRONODE_METRICS_FAILURE_ENUM
+    ASTRONODE_METRICS_FAILURE_COUNT
+} astronode_metrics_failure_t;
+
+// Index of an error code in the tables, the last one is for the unlisted codes.
+typedef enum astronode_metrics_error_code_index_t
+{
+#define ASTRONODE_METRICS_ERROR_CODE_ENUM(error_code, name) ASTRONODE_METRICS_ERROR_CODE_INDEX_##error_code,
+    ASTRONODE_METRICS_ERROR_CODES(ASTRONODE_METRICS_ERROR_CODE_ENUM)
+#undef ASTRONODE_METRICS_ERROR_CODE_ENUM
+    ASTRONODE_METRICS_ERROR_CODE_INDEX_OTHER,
+    ASTRONODE_METRICS_ERROR_CODE_COUNT
+} astronode_metrics_error_code_index_t;
+
+// Index of a request op code in the tables, the last one is for the unlisted op codes.
+typedef enum astronode_metrics_op_code_index_t
+{
+#define ASTRONODE_METRICS_OP_CODE_ENUM(request, answer, min_length, max_length, timeout_ms) \
+    ASTRONODE_METRICS_OP_CODE_INDEX_##request,
+    ASTRONODE_OP_CODE_DESCRIPTORS(ASTRONODE_METRICS_OP_CODE_ENUM)
+#undef ASTRONODE_METRICS_OP_CODE_ENUM
+    ASTRONODE_METRICS_OP_CODE_INDEX_OTHER,
+    ASTRONODE_METRICS_OP_CODE_COUNT
+} astronode_metrics_op_code_index_t;
+
+// Outcome of a transaction: valid answer (error answers included), no answer at all, or
+// answer rejected by the transport.
+typedef enum astronode_metrics_outcome_t
+{
+    ASTRONODE_METRICS_OUTCOME_SUCCESS,
+    ASTRONODE_METRICS_OUTCOME_TIMEOUT,
+    ASTRONODE_METRICS_OUTCOME_FAILURE,
+    ASTRONODE_METRICS_OUTCOME_COUNT
+} astronode_metrics_outcome_t;
+
+typedef struct astronode_metrics_op_code_t
+{
+    uint8_t     op_code;
+    uint32_t    p_outcomes[ASTRONODE_METRICS_OUTCOME_COUNT];
+} astronode_metrics_op_code_t;
+
+// Per Astronode counters, part of astronode_ctx_t.
+typedef struct astronode_metrics_registry_t
+{
+    uint32_t    p_counters[ASTRONODE_METRICS_COUNTER_COUNT];
+    uint32_t    p_failures[ASTRONODE_METRICS_FAILURE_COUNT];
+    uint32_t    p_error_codes[ASTRONODE_METRICS_ERROR_CODE_COUNT];
+    uint32_t    p_op_codes[ASTRONODE_METRICS_OP_CODE_COUNT][ASTRONODE_METRICS_OUTCOME_COUNT];
+} astronode_metrics_registry_t;
+
+typedef struct astronode_metrics_snapshot_t
+{
+    uint32_t                    p_counters[ASTRONODE_METRICS_COUNTER_COUNT];
+    uint32_t                    p_failures[ASTRONODE_METRICS_FAILURE_COUNT];
+    uint32_t                    p_error_codes[ASTRONODE_METRICS_ERROR_CODE_COUNT];
+    astronode_metrics_op_code_t p_op_codes[ASTRONODE_METRICS_OP_CODE_COUNT];
+} astronode_metrics_snapshot_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+void astronode_metrics_reset(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Each counter is updated atomically, they can be read from another context.
+ */
+void astronode_metrics_add(astronode_ctx_t *p_ctx, astronode_metrics_counter_t counter, uint32_t value);
+
+void astronode_metrics_count_failure(astronode_ctx_t *p_ctx, astronode_metrics_failure_t failure);
+
+void astronode_metrics_count_error_code(astronode_ctx_t *p_ctx, uint16_t error_code);
+
+void astronode_metrics_count_transaction(astronode_ctx_t *p_ctx, uint8_t op_code, astronode_metrics_outcome_t outcome);
+
+/**
+ * @brief Copy the counters of the Astronode of p_ctx in p_snapshot. With is_reset, each counter is cleared as it is
+ * read so that consecutive snapshots add up without losing any count.
+ */
+void astronode_metrics_snapshot(astronode_ctx_t *p_ctx, astronode_metrics_snapshot_t *p_snapshot, bool is_reset);
+
+const char *astronode_metrics_get_counter_name(astronode_metrics_counter_t counter);
+
+const char *astronode_metrics_get_failure_name(astronode_metrics_failure_t failure);
+
+const char *astronode_metrics_get_error_code_name(astronode_metrics_error_code_index_t index);
+
+/**
+ * @brief Write the link counters of p_snapshot with send_debug_logs(), then its non-zero
+ * failures, error codes and op code outcomes.
+ */
+void astronode_metrics_dump(const astronode_metrics_snapshot_t *p_snapshot);
+
+/**
+ * @brief Serialize p_snapshot in an uplink payload, return its length or 0 if it does not fit.
+ */
+uint16_t astronode_metrics_serialize(const astronode_metrics_snapshot_t *p_snapshot, uint8_t *p_buffer, uint16_t capacity);
+
+
+#endif /* ASTRONODE_METRICS_H */
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_packer.h"
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+uint8_t astronode_varint_encode(uint32_t value, uint8_t *p_buffer)
+{
+    uint8_t length = 0;
+
+    while (value >= 0x80)
+    {
+        p_buffer[length++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    p_buffer[length++] = (uint8_t) value;
+
+    return length;
+}
+
+uint8_t astronode_varint_decode(const uint8_t *p_buffer, uint16_t length, uint32_t *p_value)
+{
+    uint32_t value = 0;
+
+    for (uint8_t i = 0; i < length && i < ASTRONODE_VARINT_MAX_LEN_BYTES; i++)
+    {
+        value |= (uint32_t) (p_buffer[i] & 0x7F) << (7 * i);
+
+        if ((p_buffer[i] & 0x80) == 0)
+        {
+            *p_value = value;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+uint32_t astronode_zigzag_encode(int32_t value)
+{
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+int32_t astronode_zigzag_decode(uint32_t value)
+{
+    return (int32_t) ((value >> 1) ^ (0 - (value & 1)));
+}
+
+return_status_t astronode_packer_init(astronode_packer_t *p_packer,
+                                      uint8_t *p_buffer,
+                                      uint16_t capacity,
+                                      const astronode_packer_header_t *p_header)
+{
+    // Format, channel count and the two varints of the header.
+    if (p_header->channel_count == 0
+        || p_header->channel_count > ASTRONODE_PACKER_MAX_CHANNELS
+        || capacity < 2 + 2 * ASTRONODE_VARINT_MAX_LEN_BYTES)
+    {
+        return RS_FAILURE;
+    }
+
+    p_packer->p_buffer = p_buffer;
+    p_packer->capacity = capacity;
+    p_packer->channel_count = p_header->channel_count;
+    p_packer->sample_count = 0;
+    p_packer->length = 0;
+
+    p_buffer[p_packer->length++] = ASTRONODE_PACKER_FORMAT_TIME_SERIES;
+    p_buffer[p_packer->length++] = p_header->channel_count;
+    p_packer->length += astronode_varint_encode(p_header->base_timestamp, &p_buffer[p_packer->length]);
+    p_packer->length += astronode_varint_encode(p_header->sample_interval, &p_buffer[p_packer->length]);
+
+    return RS_SUCCESS;
+}
+
+return_status_t astronode_packer_add_sample(astronode_packer_t *p_packer, const int32_t *p_values)
+{
+    uint8_t p_encoded[ASTRONODE_PACKER_MAX_CHANNELS * ASTRONODE_VARINT_MAX_LEN_BYTES];
+    uint16_t encoded_length = 0;
+
+    for (uint8_t i = 0; i < p_packer->channel_count; i++)
+    {
+        // Deltas are computed modulo 2^32 so that any pair of values round trips.
+        uint32_t delta = (uint32_t) p_values[i];
+
+        if (p_packer->sample_count > 0)
+        {
+            delta -= (uint32_t) p_packer->p_previous_values[i];
+        }
+        encoded_length += astronode_varint_encode(astronode_zigzag_encode((int32_t) delta), &p_encoded[encoded_length]);
+    }
+
+    if (p_packer->length + encoded_length > p_packer->capacity)
+    {
+        return RS_FAILURE;
+    }
+
+    memcpy(&p_packer->p_buffer[p_packer->length], p_encoded, encoded_length);
+    memcpy(p_packer->p_previous_values, p_values, p_packer->channel_count * sizeof(int32_t));
+    p_packer->length += encoded_length;
+    p_packer->sample_count++;
+
+    return RS_SUCCESS;
+}
+
+uint16_t astronode_packer_get_fill_ratio(const astronode_packer_t *p_packer)
+{
+    return (uint32_t) p_packer->length * 1000 / p_packer->capacity;
+}
+
+return_status_t astronode_unpacker_init(astronode_unpacker_t *p_unpacker,
+                                        const uint8_t *p_buffer,
+                                        uint16_t length,
+                                        astronode_packer_header_t *p_header)
+{
+    uint8_t read = 0;
+
+    if (length < 2
+        || p_buffer[0] != ASTRONODE_PACKER_FORMAT_TIME_SERIES
+        || p_buffer[1] == 0
+        || p_buffer[1] > ASTRONODE_PACKER_MAX_CHANNELS)
+    {
+        return RS_FAILURE;
+    }
+
+    p_header->channel_count = p_buffer[1];
+    p_unpacker->index = 2;
+
+    read = astronode_varint_decode(&p_buffer[p_unpacker->index], length - p_unpacker->index, &p_header->base_timestamp);
+    if (read == 0)
+    {
+        return RS_FAILURE;
+    }
+    p_unpacker->index += read;
+
+    read = astronode_varint_decode(&p_buffer[p_unpacker->index], length - p_unpacker->index, &p_header->sample_interval);
+    if (read == 0)
+    {
+        return RS_FAILURE;
+    }
+    p_unpacker->index += read;
+
+    p_unpacker->p_buffer = p_buffer;
+    p_unpacker->length = length;
+    p_unpacker->channel_count = p_header->channel_count;
+    p_unpacker->sample_count = 0;
+
+    return RS_SUCCESS;
+}
+
+return_status_t astronode_unpacker_next_sample(astronode_unpacker_t *p_unpacker, int32_t *p_values)
+{
+    uint16_t index = p_unpacker->index;
+
+    for (uint8_t i = 0; i < p_unpacker->channel_count; i++)
+    {
+        uint32_t encoded = 0;
+        uint8_t read = astronode_varint_decode(&p_unpacker->p_buffer[index], p_unpacker->length - index, &encoded);
+
+        if (read == 0)
+        {
+            return RS_FAILURE;
+        }
+        index += read;
+
+        uint32_t value = (uint32_t) astronode_zigzag_decode(encoded);
+
+        if (p_unpacker->sample_count > 0)
+        {
+            value += (uint32_t) p_unpacker->p_previous_values[i];
+        }
+        p_values[i] = (int32_t) value;
+    }
+
+    memcpy(p_unpacker->p_previous_values, p_values, p_unpacker->channel_count * sizeof(int32_t));
+    p_unpacker->index = index;
+    p_unpacker->sample_count++;
+
+    return RS_SUCCESS;
+}
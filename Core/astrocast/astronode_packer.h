@@ -0,0 +1,116 @@
+#ifndef ASTRONODE_PACKER_H
+#define ASTRONODE_PACKER_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define ASTRONODE_PACKER_FORMAT_TIME_SERIES ASTRONODE_UPLINK_FORMAT_TIME_SERIES
+
+#ifndef ASTRONODE_PACKER_MAX_CHANNELS
+#define ASTRONODE_PACKER_MAX_CHANNELS       8
+#endif
+
+// LEB128 encoding of a 32 bits value.
+#define ASTRONODE_VARINT_MAX_LEN_BYTES      5
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// Payload layout:
+// format | channel count | varint base timestamp | varint sample interval |
+// first sample: zigzag varint value of each channel |
+// next samples: zigzag varint delta to the previous value of each channel
+typedef struct astronode_packer_header_t
+{
+    uint8_t     channel_count;
+    uint32_t    base_timestamp;
+    uint32_t    sample_interval;
+} astronode_packer_header_t;
+
+typedef struct astronode_packer_t
+{
+    uint8_t    *p_buffer;
+    uint16_t    capacity;
+    uint16_t    length;
+    uint8_t     channel_count;
+    uint16_t    sample_count;
+    int32_t     p_previous_values[ASTRONODE_PACKER_MAX_CHANNELS];
+} astronode_packer_t;
+
+typedef struct astronode_unpacker_t
+{
+    const uint8_t  *p_buffer;
+    uint16_t        length;
+    uint16_t        index;
+    uint8_t         channel_count;
+    uint16_t        sample_count;
+    int32_t         p_previous_values[ASTRONODE_PACKER_MAX_CHANNELS];
+} astronode_unpacker_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Encode value as LEB128 varint, return the number of bytes written.
+ */
+uint8_t astronode_varint_encode(uint32_t value, uint8_t *p_buffer);
+
+/**
+ * @brief Decode a LEB128 varint, return the number of bytes read or 0 if it is truncated.
+ */
+uint8_t astronode_varint_decode(const uint8_t *p_buffer, uint16_t length, uint32_t *p_value);
+
+/**
+ * @brief Map a signed value to an unsigned one, small magnitudes giving small values.
+ */
+uint32_t astronode_zigzag_encode(int32_t value);
+
+int32_t astronode_zigzag_decode(uint32_t value);
+
+/**
+ * @brief Start a time series payload in p_buffer and write its header.
+ */
+return_status_t astronode_packer_init(astronode_packer_t *p_packer,
+                                      uint8_t *p_buffer,
+                                      uint16_t capacity,
+                                      const astronode_packer_header_t *p_header);
+
+/**
+ * @brief Append one value per channel, fails without writing if the sample does not fit.
+ */
+return_status_t astronode_packer_add_sample(astronode_packer_t *p_packer, const int32_t *p_values);
+
+/**
+ * @brief Return the used part of the buffer in per mille.
+ */
+uint16_t astronode_packer_get_fill_ratio(const astronode_packer_t *p_packer);
+
+/**
+ * @brief Read the header of a time series payload.
+ */
+return_status_t astronode_unpacker_init(astronode_unpacker_t *p_unpacker,
+                                        const uint8_t *p_buffer,
+                                        uint16_t length,
+                                        astronode_packer_header_t *p_header);
+
+/**
+ * @brief Read the next sample, fails at the end of the payload.
+ */
+return_status_t astronode_unpacker_next_sample(astronode_unpacker_t *p_unpacker, int32_t *p_values);
+
+
+#endif /* ASTRONODE_PACKER_H */
@@ -0,0 +1,388 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_compress.h"
+#include "astronode_context.h"
+#include "astronode_payload_policy.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// The compressed payload is written in its entry, with room for the flag byte of a
+// payload that does not compress.
+#if ASTRONODE_PAYLOAD_POLICY_COMPRESSION != ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE
+#define PAYLOAD_POLICY_ENTRY_LEN_BYTES  (ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES + 1)
+#else
+#define PAYLOAD_POLICY_ENTRY_LEN_BYTES  ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct payload_policy_entry_t
+{
+    bool        is_used;
+    bool        is_dropped;
+    uint8_t     class_id;
+    uint16_t    payload_id;
+    uint32_t    enqueue_time_ms;
+    uint16_t    payload_length;
+    char        p_payload[PAYLOAD_POLICY_ENTRY_LEN_BYTES];
+} payload_policy_entry_t;
+
+typedef struct payload_policy_class_t
+{
+    uint32_t    ttl_ms;
+    bool        is_latest_wins;
+} payload_policy_class_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// Image of the Astronode queue: the entries are stored in a pool and g_queue_order
+// holds their index from the oldest to the newest payload.
+static astronode_ctx_t *g_p_ctx = NULL;
+static payload_policy_entry_t g_entries[ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH];
+static uint8_t g_queue_order[ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH];
+static uint8_t g_queue_count = 0;
+static payload_policy_class_t g_classes[ASTRONODE_PAYLOAD_POLICY_MAX_CLASSES];
+static uint16_t g_last_payload_id = 0;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint16_t allocate_payload_id(void);
+static void apply_drops(void);
+static void empty_queue(void);
+static bool is_payload_id_in_queue(uint16_t payload_id);
+static void mark_expired(uint32_t now_ms);
+static void resynchronize_queue(void);
+static return_status_t send_entry(payload_policy_entry_t *p_entry);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+static uint16_t allocate_payload_id(void)
+{
+    uint16_t payload_id = 0;
+
+    do
+    {
+        payload_id = astronode_ctx_allocate_payload_id(g_p_ctx);
+    } while (is_payload_id_in_queue(payload_id));
+
+    return payload_id;
+}
+
+static void apply_drops(void)
+{
+    int16_t last_dropped = -1;
+
+    for (uint8_t i = 0; i < g_queue_count; i++)
+    {
+        if (g_entries[g_queue_order[i]].is_dropped)
+        {
+            last_dropped = i;
+        }
+    }
+
+    if (last_dropped < 0)
+    {
+        return;
+    }
+
+    // PLD_DR only removes the oldest payload: dequeue up to the last dropped
+    // payload, then enqueue again the payloads that are kept.
+    for (int16_t i = 0; i <= last_dropped; i++)
+    {
+        uint16_t payload_id = 0;
+
+        if (astronode_send_pld_dr(g_p_ctx, &payload_id) != RS_SUCCESS
+            || payload_id != g_entries[g_queue_order[i]].payload_id)
+        {
+            send_debug_logs("Payload queue image is out of sync with the Astronode.");
+            resynchronize_queue();
+            return;
+        }
+    }
+
+    uint8_t p_dequeued[ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH];
+    uint8_t dequeued_count = last_dropped + 1;
+
+    memcpy(p_dequeued, g_queue_order, dequeued_count);
+    memmove(g_queue_order, &g_queue_order[dequeued_count], g_queue_count - dequeued_count);
+    g_queue_count -= dequeued_count;
+
+    for (uint8_t i = 0; i < dequeued_count; i++)
+    {
+        payload_policy_entry_t *p_entry = &g_entries[p_dequeued[i]];
+
+        if (p_entry->is_dropped == false && send_entry(p_entry) == RS_SUCCESS)
+        {
+            g_queue_order[g_queue_count++] = p_dequeued[i];
+        }
+        else
+        {
+            p_entry->is_used = false;
+        }
+    }
+}
+
+static void empty_queue(void)
+{
+    for (uint8_t i = 0; i < g_queue_count; i++)
+    {
+        g_entries[g_queue_order[i]].is_used = false;
+    }
+    g_queue_count = 0;
+}
+
+static bool is_payload_id_in_queue(uint16_t payload_id)
+{
+    for (uint8_t i = 0; i < g_queue_count; i++)
+    {
+        if (g_entries[g_queue_order[i]].payload_id == payload_id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void mark_expired(uint32_t now_ms)
+{
+    for (uint8_t i = 0; i < g_queue_count; i++)
+    {
+        payload_policy_entry_t *p_entry = &g_entries[g_queue_order[i]];
+        uint32_t ttl_ms = g_classes[p_entry->class_id].ttl_ms;
+
+        if (ttl_ms != ASTRONODE_PAYLOAD_POLICY_NO_TTL && now_ms - p_entry->enqueue_time_ms >= ttl_ms)
+        {
+            p_entry->is_dropped = true;
+        }
+    }
+}
+
+static void resynchronize_queue(void)
+{
+    uint8_t previous_count = g_queue_count;
+
+    astronode_send_pld_fr(g_p_ctx);
+    g_queue_count = 0;
+
+    for (uint8_t i = 0; i < previous_count; i++)
+    {
+        payload_policy_entry_t *p_entry = &g_entries[g_queue_order[i]];
+
+        if (p_entry->is_dropped == false && send_entry(p_entry) == RS_SUCCESS)
+        {
+            g_queue_order[g_queue_count++] = g_queue_order[i];
+        }
+        else
+        {
+            p_entry->is_used = false;
+        }
+    }
+}
+
+static return_status_t send_entry(payload_policy_entry_t *p_entry)
+{
+    if (astronode_send_pld_er(g_p_ctx, p_entry->payload_id, p_entry->p_payload, p_entry->payload_length) == RS_SUCCESS)
+    {
+        return RS_SUCCESS;
+    }
+
+    if (astronode_get_last_error_code(g_p_ctx) == ASTRONODE_ERR_CODE_DUPLICATE_ID)
+    {
+        // The ID is used by a payload unknown to the image, take another one.
+        p_entry->payload_id = allocate_payload_id();
+        return astronode_send_pld_er(g_p_ctx, p_entry->payload_id, p_entry->p_payload, p_entry->payload_length);
+    }
+    return RS_FAILURE;
+}
+
+void astronode_payload_policy_init(astronode_ctx_t *p_ctx)
+{
+    g_p_ctx = p_ctx;
+    memset(g_entries, 0, sizeof(g_entries));
+    memset(g_classes, 0, sizeof(g_classes));
+    g_queue_count = 0;
+}
+
+void astronode_payload_policy_set_class(uint8_t class_id, uint32_t ttl_ms, bool is_latest_wins)
+{
+    if (class_id < ASTRONODE_PAYLOAD_POLICY_MAX_CLASSES)
+    {
+        g_classes[class_id].ttl_ms = ttl_ms;
+        g_classes[class_id].is_latest_wins = is_latest_wins;
+    }
+}
+
+return_status_t astronode_payload_policy_enqueue(uint8_t class_id, const char *p_payload, uint16_t payload_length)
+{
+    if (class_id >= ASTRONODE_PAYLOAD_POLICY_MAX_CLASSES || payload_length > ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES)
+    {
+        send_debug_logs("Payload class or length not valid.");
+        return RS_FAILURE;
+    }
+
+    mark_expired(get_systick());
+
+    if (g_classes[class_id].is_latest_wins)
+    {
+        for (uint8_t i = 0; i < g_queue_count; i++)
+        {
+            if (g_entries[g_queue_order[i]].class_id == class_id)
+            {
+                g_entries[g_queue_order[i]].is_dropped = true;
+            }
+        }
+    }
+
+    apply_drops();
+
+    if (g_queue_count >= ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH)
+    {
+        send_debug_logs("Astronode queue is full, payload not enqueued.");
+        return RS_FAILURE;
+    }
+
+    uint8_t slot = 0;
+    while (g_entries[slot].is_used)
+    {
+        slot++;
+    }
+
+    payload_policy_entry_t *p_entry = &g_entries[slot];
+
+    p_entry->class_id = class_id;
+    p_entry->is_dropped = false;
+    p_entry->payload_id = allocate_payload_id();
+#if ASTRONODE_PAYLOAD_POLICY_COMPRESSION != ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE
+    if (astronode_compress((const uint8_t *) p_payload,
+                           payload_length,
+                           ASTRONODE_PAYLOAD_POLICY_COMPRESSION == ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS_DICTIONARY,
+                           (uint8_t *) p_entry->p_payload,
+                           sizeof(p_entry->p_payload),
+                           &p_entry->payload_length) != RS_SUCCESS
+        || p_entry->payload_length > ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES)
+    {
+        send_debug_logs("Payload too long once compressed, payload not enqueued.");
+        return RS_FAILURE;
+    }
+#else
+    p_entry->payload_length = payload_length;
+    memcpy(p_entry->p_payload, p_payload, payload_length);
+#endif
+
+    if (send_entry(p_entry) != RS_SUCCESS)
+    {
+        return RS_FAILURE;
+    }
+
+    p_entry->is_used = true;
+    p_entry->enqueue_time_ms = get_systick();
+    g_queue_order[g_queue_count++] = slot;
+    g_last_payload_id = p_entry->payload_id;
+
+    return RS_SUCCESS;
+}
+
+void astronode_payload_policy_purge_expired(void)
+{
+    mark_expired(get_systick());
+    apply_drops();
+}
+
+return_status_t astronode_payload_policy_preempt(uint8_t class_id)
+{
+    payload_policy_entry_t *p_victim = NULL;
+
+    for (uint8_t i = 0; i < g_queue_count; i++)
+    {
+        payload_policy_entry_t *p_entry = &g_entries[g_queue_order[i]];
+
+        if (p_entry->class_id > class_id && (p_victim == NULL || p_entry->class_id > p_victim->class_id))
+        {
+            p_victim = p_entry;
+        }
+    }
+
+    if (p_victim == NULL)
+    {
+        return RS_FAILURE;
+    }
+
+    uint8_t previous_count = g_queue_count;
+
+    send_debug_logs("Payload of lower priority preempted from the Astronode queue.");
+    p_victim->is_dropped = true;
+    apply_drops();
+
+    return g_queue_count < previous_count ? RS_SUCCESS : RS_FAILURE;
+}
+
+void astronode_payload_policy_acknowledge(uint16_t payload_id)
+{
+    for (uint8_t i = 0; i < g_queue_count; i++)
+    {
+        if (g_entries[g_queue_order[i]].payload_id == payload_id)
+        {
+            g_entries[g_queue_order[i]].is_used = false;
+            memmove(&g_queue_order[i], &g_queue_order[i + 1], g_queue_count - i - 1);
+            g_queue_count--;
+            return;
+        }
+    }
+}
+
+return_status_t astronode_payload_policy_clear(void)
+{
+    if (astronode_send_pld_fr(g_p_ctx) != RS_SUCCESS)
+    {
+        return RS_FAILURE;
+    }
+
+    empty_queue();
+
+    return RS_SUCCESS;
+}
+
+void astronode_payload_policy_forget(astronode_ctx_t *p_ctx)
+{
+    if (p_ctx != NULL && p_ctx == g_p_ctx)
+    {
+        send_debug_logs("Astronode reset, its queue is empty.");
+        empty_queue();
+    }
+}
+
+uint16_t astronode_payload_policy_get_last_payload_id(void)
+{
+    return g_last_payload_id;
+}
+
+bool astronode_payload_policy_is_queued(uint16_t payload_id)
+{
+    return is_payload_id_in_queue(payload_id);
+}
+
+uint8_t astronode_payload_policy_get_queue_count(void)
+{
+    return g_queue_count;
+}
@@ -0,0 +1,104 @@
+#ifndef ASTRONODE_PAYLOAD_POLICY_H
+#define ASTRONODE_PAYLOAD_POLICY_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Number of payloads the Astronode can hold in its sending queue.
+#ifndef ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH
+#define ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH 8
+#endif
+
+#ifndef ASTRONODE_PAYLOAD_POLICY_MAX_CLASSES
+#define ASTRONODE_PAYLOAD_POLICY_MAX_CLASSES        4
+#endif
+
+#define ASTRONODE_PAYLOAD_POLICY_NO_TTL             0
+
+// Optional LZSS stage of astronode_payload_policy_enqueue(): every payload is sent as the
+// output of astronode_compress(), flag byte included, and the backend restores it with
+// astronode_decompress(). A payload that does not fit in ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES
+// with its flag byte is rejected.
+#define ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE            0
+#define ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS            1
+#define ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS_DICTIONARY 2
+
+#ifndef ASTRONODE_PAYLOAD_POLICY_COMPRESSION
+#define ASTRONODE_PAYLOAD_POLICY_COMPRESSION        ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE
+#endif
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Reset the image of the queue of this Astronode, all classes keep every payload without TTL.
+ */
+void astronode_payload_policy_init(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Configure a payload class: time to live in the Astronode queue and latest-wins semantics.
+ */
+void astronode_payload_policy_set_class(uint8_t class_id, uint32_t ttl_ms, bool is_latest_wins);
+
+/**
+ * @brief Drop the superseded or expired payloads from the Astronode queue, then enqueue the new one.
+ */
+return_status_t astronode_payload_policy_enqueue(uint8_t class_id, const char *p_payload, uint16_t payload_length);
+
+/**
+ * @brief Drop the expired payloads from the Astronode queue.
+ */
+void astronode_payload_policy_purge_expired(void);
+
+/**
+ * @brief Drop the oldest payload of the lowest class above class_id (lower classes
+ * having the higher priority) to make room in the Astronode queue.
+ */
+return_status_t astronode_payload_policy_preempt(uint8_t class_id);
+
+/**
+ * @brief Forget a payload acknowledged by the satellite (SAK_RR).
+ */
+void astronode_payload_policy_acknowledge(uint16_t payload_id);
+
+/**
+ * @brief Clear the Astronode queue (PLD_FR) and its image.
+ */
+return_status_t astronode_payload_policy_clear(void);
+
+/**
+ * @brief Empty the image of the queue after a reset of the Astronode of p_ctx, which
+ * loses its queue: the payloads not acknowledged yet are no longer sent.
+ */
+void astronode_payload_policy_forget(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Return the payload ID given to the last payload enqueued.
+ */
+uint16_t astronode_payload_policy_get_last_payload_id(void);
+
+/**
+ * @brief Check if a payload is still waiting in the Astronode queue.
+ */
+bool astronode_payload_policy_is_queued(uint16_t payload_id);
+
+/**
+ * @brief Return the number of payloads in the Astronode queue.
+ */
+uint8_t astronode_payload_policy_get_queue_count(void);
+
+
+#endif /* ASTRONODE_PAYLOAD_POLICY_H */
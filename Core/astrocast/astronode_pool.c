@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_context.h"
+#include "astronode_pool.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+_Static_assert(ASTRONODE_POOL_MSG_COUNT >= 2 && ASTRONODE_POOL_MSG_COUNT <= 32,
+               "A transaction needs 2 messages and the used messages are a 32 bits mask.");
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+astronode_app_msg_t *astronode_pool_acquire_msg(astronode_ctx_t *p_ctx)
+{
+    astronode_pool_t *p_pool = &p_ctx->pool;
+
+    for (uint8_t i = 0; i < ASTRONODE_POOL_MSG_COUNT; i++)
+    {
+        if ((p_pool->msg_used_mask & (1UL << i)) == 0)
+        {
+            p_pool->msg_used_mask |= 1UL << i;
+            p_pool->msg_used_count++;
+            if (p_pool->msg_used_count > p_pool->high_water.msg_count)
+            {
+                p_pool->high_water.msg_count = p_pool->msg_used_count;
+            }
+
+            // Only the header is reset: the payload is written before it is read.
+            p_pool->p_msgs[i].op_code = 0;
+            p_pool->p_msgs[i].payload_len = 0;
+            return &p_pool->p_msgs[i];
+        }
+    }
+
+    send_debug_logs("ERROR : No free message in the pool, raise ASTRONODE_POOL_MSG_COUNT.");
+    return NULL;
+}
+
+void astronode_pool_release_msg(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_msg)
+{
+    astronode_pool_t *p_pool = &p_ctx->pool;
+
+    if (p_msg == NULL)
+    {
+        return;
+    }
+
+    uint32_t mask = 1UL << (p_msg - p_pool->p_msgs);
+
+    if (p_pool->msg_used_mask & mask)
+    {
+        p_pool->msg_used_mask &= ~mask;
+        p_pool->msg_used_count--;
+    }
+}
+
+void astronode_pool_record_frames(astronode_ctx_t *p_ctx, uint16_t request_length, uint16_t answer_length)
+{
+    astronode_pool_usage_t *p_high_water = &p_ctx->pool.high_water;
+
+    if (request_length > p_high_water->request_frame_len)
+    {
+        p_high_water->request_frame_len = request_length;
+    }
+    if (answer_length > p_high_water->answer_frame_len)
+    {
+        p_high_water->answer_frame_len = answer_length;
+    }
+}
+
+void astronode_pool_get_high_water(const astronode_ctx_t *p_ctx, astronode_pool_usage_t *p_usage)
+{
+    *p_usage = p_ctx->pool.high_water;
+}
@@ -0,0 +1,88 @@
+#ifndef ASTRONODE_POOL_H
+#define ASTRONODE_POOL_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Messages of one Astronode: the request and the answer of a transaction. Raise it for
+// an application keeping messages acquired across the calls of the library.
+#ifndef ASTRONODE_POOL_MSG_COUNT
+#define ASTRONODE_POOL_MSG_COUNT    2
+#endif
+
+// STX + OPCODE + Parameters + CRC + ETX
+#define ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES ( 1 + \
+                                                2 + \
+                                                2 * ASTRONODE_APP_MSG_MAX_LEN_BYTES + \
+                                                4 + \
+                                                1)
+
+// Frames on the wire, plus their null terminator for the logs. The longest request is
+// WIF_WR, the answers of ASTRONODE_OP_CODE_DESCRIPTORS are checked at build time to fit in
+// ASTRONODE_MAX_LENGTH_RESPONSE and the receiver rejects the longer ones.
+#define ASTRONODE_POOL_REQUEST_FRAME_LEN_BYTES  (ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES + 1)
+#define ASTRONODE_POOL_ANSWER_FRAME_LEN_BYTES   (ASTRONODE_MAX_LENGTH_RESPONSE + 1)
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct astronode_pool_usage_t
+{
+    uint8_t     msg_count;
+    uint16_t    request_frame_len;
+    uint16_t    answer_frame_len;
+} astronode_pool_usage_t;
+
+// Per Astronode buffers, part of astronode_ctx_t. The frames belong to the transport, one
+// transaction at a time, the messages are acquired and released by their users.
+typedef struct astronode_pool_t
+{
+    astronode_app_msg_t     p_msgs[ASTRONODE_POOL_MSG_COUNT];
+    uint8_t                 p_request_frame[ASTRONODE_POOL_REQUEST_FRAME_LEN_BYTES];
+    uint8_t                 p_answer_frame[ASTRONODE_POOL_ANSWER_FRAME_LEN_BYTES];
+    uint32_t                msg_used_mask;
+    uint8_t                 msg_used_count;
+    astronode_pool_usage_t  high_water;
+} astronode_pool_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Return a free message with a null op code and an empty payload, NULL if all are
+ * in use. The payload is not cleared: only its first payload_len bytes are meaningful.
+ */
+astronode_app_msg_t *astronode_pool_acquire_msg(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Give back a message acquired with astronode_pool_acquire_msg(), NULL is ignored.
+ */
+void astronode_pool_release_msg(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_msg);
+
+/**
+ * @brief Record the length of the frames of a transaction in the high-water marks.
+ */
+void astronode_pool_record_frames(astronode_ctx_t *p_ctx, uint16_t request_length, uint16_t answer_length);
+
+/**
+ * @brief Copy the highest usage of the pool since astronode_ctx_init().
+ */
+void astronode_pool_get_high_water(const astronode_ctx_t *p_ctx, astronode_pool_usage_t *p_usage);
+
+
+#endif /* ASTRONODE_POOL_H */
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(__ARM_ARCH_7EM__)
+#include "stm32l4xx.h"
+#else
+#include <time.h>
+#endif
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_packer.h"
+#include "astronode_profile.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const char *g_p_site_names[ASTRONODE_PROFILE_SITE_COUNT] =
+{
+#define ASTRONODE_PROFILE_SITE_NAME(site, name) name,
+    ASTRONODE_PROFILE_SITES(ASTRONODE_PROFILE_SITE_NAME)
+#undef ASTRONODE_PROFILE_SITE_NAME
+};
+
+static astronode_profile_stats_t g_p_stats[ASTRONODE_PROFILE_SITE_COUNT];
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_profile_init(void)
+{
+#if defined(__ARM_ARCH_7EM__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    astronode_profile_reset();
+}
+
+void astronode_profile_reset(void)
+{
+    memset(g_p_stats, 0, sizeof(g_p_stats));
+}
+
+uint32_t astronode_profile_get_ticks(void)
+{
+#if defined(__ARM_ARCH_7EM__)
+    return DWT->CYCCNT;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec);
+#endif
+}
+
+void astronode_profile_record(astronode_profile_site_t site, uint32_t ticks)
+{
+    astronode_profile_stats_t *p_stats = &g_p_stats[site];
+
+    if (p_stats->count == 0 || ticks < p_stats->min_ticks)
+    {
+        p_stats->min_ticks = ticks;
+    }
+    if (ticks > p_stats->max_ticks)
+    {
+        p_stats->max_ticks = ticks;
+    }
+    p_stats->sum_ticks += ticks;
+    p_stats->count++;
+}
+
+const astronode_profile_stats_t *astronode_profile_get_stats(astronode_profile_site_t site)
+{
+    return &g_p_stats[site];
+}
+
+const char *astronode_profile_get_site_name(astronode_profile_site_t site)
+{
+    return g_p_site_names[site];
+}
+
+void astronode_profile_dump(void)
+{
+    char str[96];
+
+    for (uint8_t i = 0; i < ASTRONODE_PROFILE_SITE_COUNT; i++)
+    {
+        const astronode_profile_stats_t *p_stats = &g_p_stats[i];
+        uint32_t mean = p_stats->count > 0 ? (uint32_t) (p_stats->sum_ticks / p_stats->count) : 0;
+
+        sprintf(str, "Profile %s: count %" PRIu32 ", min %" PRIu32 ", max %" PRIu32 ", mean %" PRIu32 " ticks.",
+                g_p_site_names[i], p_stats->count, p_stats->min_ticks, p_stats->max_ticks, mean);
+        send_debug_logs(str);
+    }
+}
+
+uint16_t astronode_profile_serialize(uint8_t *p_buffer, uint16_t capacity)
+{
+    uint8_t p_varint[ASTRONODE_VARINT_MAX_LEN_BYTES];
+    uint16_t length = 0;
+
+    if (capacity < 2)
+    {
+        return 0;
+    }
+    p_buffer[length++] = ASTRONODE_PROFILE_FORMAT_SITES;
+    p_buffer[length++] = ASTRONODE_PROFILE_SITE_COUNT;
+
+    for (uint8_t i = 0; i < ASTRONODE_PROFILE_SITE_COUNT; i++)
+    {
+        const astronode_profile_stats_t *p_stats = &g_p_stats[i];
+        uint32_t p_values[4] =
+        {
+            p_stats->count,
+            p_stats->min_ticks,
+            p_stats->max_ticks,
+            p_stats->count > 0 ? (uint32_t) (p_stats->sum_ticks / p_stats->count) : 0
+        };
+
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            uint8_t varint_length = astronode_varint_encode(p_values[j], p_varint);
+
+            if (length + varint_length > capacity)
+            {
+                return 0;
+            }
+            memcpy(&p_buffer[length], p_varint, varint_length);
+            length += varint_length;
+        }
+    }
+
+    return length;
+}
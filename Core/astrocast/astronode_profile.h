@@ -0,0 +1,93 @@
+#ifndef ASTRONODE_PROFILE_H
+#define ASTRONODE_PROFILE_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Profiled sites of the transport: X(site, name)
+#define ASTRONODE_PROFILE_SITES(X) \
+    X(SEND_RECEIVE, "send_receive") \
+    X(CREATE_REQUEST, "create_request") \
+    X(DECODE_ANSWER, "decode_answer") \
+    X(CALCULATE_CRC, "calculate_crc") \
+    X(RECEIVE_ANSWER, "receive_answer")
+
+// Uplink payload layout:
+// format | site count | for each site: varint count | varint min | varint max | varint mean
+#define ASTRONODE_PROFILE_FORMAT_SITES      ASTRONODE_UPLINK_FORMAT_PROFILE
+
+// Built with ASTRONODE_PROFILE defined, the sites sample the tick counter: the DWT cycle
+// counter on Cortex-M4, a monotonic clock in ns elsewhere. Otherwise the macros are empty.
+#ifdef ASTRONODE_PROFILE
+#define ASTRONODE_PROFILE_START(site) \
+    uint32_t profile_start_##site = astronode_profile_get_ticks()
+#define ASTRONODE_PROFILE_STOP(site) \
+    astronode_profile_record(ASTRONODE_PROFILE_SITE_##site, astronode_profile_get_ticks() - profile_start_##site)
+#else
+#define ASTRONODE_PROFILE_START(site)
+#define ASTRONODE_PROFILE_STOP(site)
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_profile_site_t
+{
+#define ASTRONODE_PROFILE_SITE_ENUM(site, name) ASTRONODE_PROFILE_SITE_##site,
+    ASTRONODE_PROFILE_SITES(ASTRONODE_PROFILE_SITE_ENUM)
+#undef ASTRONODE_PROFILE_SITE_ENUM
+    ASTRONODE_PROFILE_SITE_COUNT
+} astronode_profile_site_t;
+
+typedef struct astronode_profile_stats_t
+{
+    uint32_t    count;
+    uint32_t    min_ticks;
+    uint32_t    max_ticks;
+    uint64_t    sum_ticks;
+} astronode_profile_stats_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Start the tick counter (DWT CYCCNT on Cortex-M4) and clear the tables.
+ */
+void astronode_profile_init(void);
+
+void astronode_profile_reset(void);
+
+uint32_t astronode_profile_get_ticks(void);
+
+void astronode_profile_record(astronode_profile_site_t site, uint32_t ticks);
+
+const astronode_profile_stats_t *astronode_profile_get_stats(astronode_profile_site_t site);
+
+const char *astronode_profile_get_site_name(astronode_profile_site_t site);
+
+/**
+ * @brief Write the table of each site with send_debug_logs().
+ */
+void astronode_profile_dump(void);
+
+/**
+ * @brief Serialize the tables in an uplink payload, return its length or 0 if it does not fit.
+ */
+uint16_t astronode_profile_serialize(uint8_t *p_buffer, uint16_t capacity);
+
+
+#endif /* ASTRONODE_PROFILE_H */
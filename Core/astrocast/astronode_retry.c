@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_context.h"
+#include "astronode_metrics.h"
+#include "astronode_payload_policy.h"
+#include "astronode_retry.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct retry_policy_t
+{
+    uint8_t     retry_class;
+    uint8_t     max_retries;
+} retry_policy_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void open_circuit(astronode_ctx_t *p_ctx);
+static uint32_t get_random(astronode_retry_state_t *p_state);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// Indexed by the request op code, requests not listed are of class NONE.
+static const retry_policy_t g_retry_policies[0x80] =
+{
+#define RETRY_POLICY_ENTRY(request, retry_class, max_retries) [request] = { retry_class, max_retries },
+    ASTRONODE_RETRY_POLICIES(RETRY_POLICY_ENTRY)
+#undef RETRY_POLICY_ENTRY
+};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+return_status_t astronode_retry_check_circuit(astronode_ctx_t *p_ctx)
+{
+    astronode_retry_state_t *p_state = &p_ctx->retry_state;
+
+    if (p_state->is_disabled == false && p_state->circuit_state == ASTRONODE_CIRCUIT_OPEN)
+    {
+        if (get_systick() - p_state->open_time_ms < ASTRONODE_RETRY_CIRCUIT_OPEN_MS)
+        {
+            astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_CIRCUIT_REJECTED, 1);
+            return RS_FAILURE;
+        }
+        p_state->circuit_state = ASTRONODE_CIRCUIT_HALF_OPEN;
+    }
+    return RS_SUCCESS;
+}
+
+void astronode_retry_update_circuit(astronode_ctx_t *p_ctx, astronode_trace_status_t answer_status)
+{
+    astronode_retry_state_t *p_state = &p_ctx->retry_state;
+
+    if (p_state->is_disabled)
+    {
+        return;
+    }
+
+    if (answer_status != ASTRONODE_TRACE_STATUS_TIMEOUT)
+    {
+        // Any answer byte shows that the Astronode is alive.
+        p_state->consecutive_timeout_count = 0;
+        if (p_state->circuit_state == ASTRONODE_CIRCUIT_HALF_OPEN)
+        {
+            p_state->circuit_state = ASTRONODE_CIRCUIT_CLOSED;
+            astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_CIRCUIT_CLOSED, 1);
+            send_debug_logs("Circuit closed, the Astronode answers again.");
+        }
+        return;
+    }
+
+    p_state->consecutive_timeout_count++;
+    if (p_state->circuit_state == ASTRONODE_CIRCUIT_HALF_OPEN
+        || p_state->consecutive_timeout_count >= ASTRONODE_RETRY_CIRCUIT_TIMEOUT_THRESHOLD)
+    {
+        open_circuit(p_ctx);
+    }
+}
+
+astronode_retry_decision_t astronode_retry_decide(astronode_ctx_t *p_ctx,
+                                                  uint8_t op_code,
+                                                  uint8_t attempt,
+                                                  astronode_trace_status_t answer_status,
+                                                  uint16_t error_code)
+{
+    retry_policy_t policy = g_retry_policies[op_code & 0x7F];
+
+    if (answer_status == ASTRONODE_TRACE_STATUS_OK || p_ctx->retry_state.is_disabled)
+    {
+        return ASTRONODE_RETRY_DECISION_DONE;
+    }
+
+    if (answer_status == ASTRONODE_TRACE_STATUS_MODULE_ERROR)
+    {
+        if (attempt > 0
+            && ((policy.retry_class == ASTRONODE_RETRY_CLASS_CLEAR && error_code == ASTRONODE_ERR_CODE_NO_CLEAR)
+                || (policy.retry_class == ASTRONODE_RETRY_CLASS_ENQUEUE && error_code == ASTRONODE_ERR_CODE_DUPLICATE_ID)))
+        {
+            astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_RETRIES_RECOVERED, 1);
+            return ASTRONODE_RETRY_DECISION_RECOVERED;
+        }
+
+        // Only a request corrupted on its way to the Astronode is worth sending again.
+        if (error_code != ASTRONODE_ERR_CODE_CRC_NOT_VALID)
+        {
+            return ASTRONODE_RETRY_DECISION_DONE;
+        }
+    }
+
+    if (policy.retry_class == ASTRONODE_RETRY_CLASS_NONE)
+    {
+        astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_RETRIES_SKIPPED, 1);
+        return ASTRONODE_RETRY_DECISION_DONE;
+    }
+
+    if (attempt >= policy.max_retries || p_ctx->retry_state.circuit_state == ASTRONODE_CIRCUIT_OPEN)
+    {
+        astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_RETRIES_EXHAUSTED, 1);
+        return ASTRONODE_RETRY_DECISION_DONE;
+    }
+
+    astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_RETRIES, 1);
+    return ASTRONODE_RETRY_DECISION_RETRY;
+}
+
+uint16_t astronode_retry_get_backoff_ms(astronode_ctx_t *p_ctx, uint8_t retry)
+{
+    uint32_t delay_ms = ASTRONODE_RETRY_BACKOFF_MAX_MS;
+
+    if (retry < 16 && ((uint32_t) ASTRONODE_RETRY_BACKOFF_BASE_MS << retry) < ASTRONODE_RETRY_BACKOFF_MAX_MS)
+    {
+        delay_ms = (uint32_t) ASTRONODE_RETRY_BACKOFF_BASE_MS << retry;
+    }
+
+    // Spread the retries of the assets failing at the same time.
+    delay_ms = delay_ms / 2 + get_random(&p_ctx->retry_state) % (delay_ms / 2 + 1);
+    astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_BACKOFF_MS, delay_ms);
+
+    return (uint16_t) delay_ms;
+}
+
+astronode_circuit_state_t astronode_retry_get_circuit_state(const astronode_ctx_t *p_ctx)
+{
+    return p_ctx->retry_state.circuit_state;
+}
+
+void astronode_retry_set_enabled(astronode_ctx_t *p_ctx, bool is_enabled)
+{
+    p_ctx->retry_state.is_disabled = !is_enabled;
+    p_ctx->retry_state.circuit_state = ASTRONODE_CIRCUIT_CLOSED;
+    p_ctx->retry_state.consecutive_timeout_count = 0;
+}
+
+static void open_circuit(astronode_ctx_t *p_ctx)
+{
+    astronode_retry_state_t *p_state = &p_ctx->retry_state;
+    char str[64];
+
+    sprintf(str, "Circuit open after %d timeouts, reset the Astronode.", p_state->consecutive_timeout_count);
+    send_debug_logs(str);
+
+    p_state->circuit_state = ASTRONODE_CIRCUIT_OPEN;
+    p_state->consecutive_timeout_count = 0;
+    p_state->open_time_ms = get_systick();
+    astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_CIRCUIT_OPENED, 1);
+
+    p_ctx->p_uart_ops->reset(p_ctx->p_port);
+    astronode_payload_policy_forget(p_ctx);
+}
+
+static uint32_t get_random(astronode_retry_state_t *p_state)
+{
+    uint32_t x = p_state->random_state;
+
+    // Seeded by the device so that the assets failing together do not retry together.
+    if (x == 0)
+    {
+        x = (get_device_uid() ^ get_systick()) | 1;
+    }
+
+    // xorshift32
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p_state->random_state = x;
+
+    return x;
+}
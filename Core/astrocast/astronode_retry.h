@@ -0,0 +1,155 @@
+#ifndef ASTRONODE_RETRY_H
+#define ASTRONODE_RETRY_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_trace.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#ifndef ASTRONODE_RETRY_READ_MAX_RETRIES
+#define ASTRONODE_RETRY_READ_MAX_RETRIES            3
+#endif
+#ifndef ASTRONODE_RETRY_WRITE_MAX_RETRIES
+#define ASTRONODE_RETRY_WRITE_MAX_RETRIES           2
+#endif
+#ifndef ASTRONODE_RETRY_CLEAR_MAX_RETRIES
+#define ASTRONODE_RETRY_CLEAR_MAX_RETRIES           2
+#endif
+#ifndef ASTRONODE_RETRY_ENQUEUE_MAX_RETRIES
+#define ASTRONODE_RETRY_ENQUEUE_MAX_RETRIES         2
+#endif
+
+// Backoff before the retry n (0 for the first one): a random delay between the half and
+// the whole of min(BASE << n, MAX).
+#ifndef ASTRONODE_RETRY_BACKOFF_BASE_MS
+#define ASTRONODE_RETRY_BACKOFF_BASE_MS             20
+#endif
+#ifndef ASTRONODE_RETRY_BACKOFF_MAX_MS
+#define ASTRONODE_RETRY_BACKOFF_MAX_MS              500
+#endif
+
+// Consecutive transactions without any answer byte opening the circuit: the Astronode is
+// reset and the requests fail at once until the end of the open period.
+#ifndef ASTRONODE_RETRY_CIRCUIT_TIMEOUT_THRESHOLD
+#define ASTRONODE_RETRY_CIRCUIT_TIMEOUT_THRESHOLD   5
+#endif
+#ifndef ASTRONODE_RETRY_CIRCUIT_OPEN_MS
+#define ASTRONODE_RETRY_CIRCUIT_OPEN_MS             5000
+#endif
+
+// Retry policy of the requests sent by the library: X(request op code, class, max retries)
+// Requests not listed are never retried.
+#define ASTRONODE_RETRY_POLICIES(X) \
+    X(ASTRONODE_OP_CODE_CFG_WR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_CFG_SR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_CFG_FR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_CFG_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_CTX_SR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_WIF_WR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_SSC_WR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_MGI_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_MSN_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_MPN_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_NCO_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_RTC_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_EVT_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_GEO_WR, ASTRONODE_RETRY_CLASS_WRITE, ASTRONODE_RETRY_WRITE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_PLD_ER, ASTRONODE_RETRY_CLASS_ENQUEUE, ASTRONODE_RETRY_ENQUEUE_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_PLD_DR, ASTRONODE_RETRY_CLASS_NONE, 0) \
+    X(ASTRONODE_OP_CODE_PLD_FR, ASTRONODE_RETRY_CLASS_CLEAR, ASTRONODE_RETRY_CLEAR_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_SAK_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_SAK_CR, ASTRONODE_RETRY_CLASS_CLEAR, ASTRONODE_RETRY_CLEAR_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_RES_CR, ASTRONODE_RETRY_CLASS_CLEAR, ASTRONODE_RETRY_CLEAR_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_PER_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_PER_CR, ASTRONODE_RETRY_CLASS_CLEAR, ASTRONODE_RETRY_CLEAR_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_MST_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_LCD_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_END_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_CMD_RR, ASTRONODE_RETRY_CLASS_READ, ASTRONODE_RETRY_READ_MAX_RETRIES) \
+    X(ASTRONODE_OP_CODE_CMD_CR, ASTRONODE_RETRY_CLASS_CLEAR, ASTRONODE_RETRY_CLEAR_MAX_RETRIES)
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_retry_class_t
+{
+    ASTRONODE_RETRY_CLASS_NONE,     // Not idempotent: a lost answer may hide a done request
+    ASTRONODE_RETRY_CLASS_READ,     // No side effect
+    ASTRONODE_RETRY_CLASS_WRITE,    // Same value written again
+    ASTRONODE_RETRY_CLASS_CLEAR,    // NO_CLEAR on a retry: cleared by the lost attempt
+    ASTRONODE_RETRY_CLASS_ENQUEUE   // DUPLICATE_ID on a retry: queued by the lost attempt
+} astronode_retry_class_t;
+
+typedef enum astronode_retry_decision_t
+{
+    ASTRONODE_RETRY_DECISION_DONE,      // Answer given to the caller
+    ASTRONODE_RETRY_DECISION_RETRY,     // Send the request again after the backoff
+    ASTRONODE_RETRY_DECISION_RECOVERED  // Error answer meaning that a lost attempt succeeded
+} astronode_retry_decision_t;
+
+typedef enum astronode_circuit_state_t
+{
+    ASTRONODE_CIRCUIT_CLOSED,       // Requests sent
+    ASTRONODE_CIRCUIT_OPEN,         // Astronode reset, requests failing at once
+    ASTRONODE_CIRCUIT_HALF_OPEN     // One request sent to probe the Astronode
+} astronode_circuit_state_t;
+
+// Per Astronode state, part of astronode_ctx_t.
+typedef struct astronode_retry_state_t
+{
+    astronode_circuit_state_t   circuit_state;
+    uint8_t                     consecutive_timeout_count;
+    uint32_t                    open_time_ms;
+    uint32_t                    random_state;
+    bool                        is_disabled;
+} astronode_retry_state_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Return RS_FAILURE if the circuit of this Astronode is open, the request must not be sent.
+ */
+return_status_t astronode_retry_check_circuit(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Update the circuit with the answer of an attempt, opening it resets the Astronode.
+ */
+void astronode_retry_update_circuit(astronode_ctx_t *p_ctx, astronode_trace_status_t answer_status);
+
+/**
+ * @brief Decide what to do after the attempt n (0 for the first one) of a request.
+ */
+astronode_retry_decision_t astronode_retry_decide(astronode_ctx_t *p_ctx,
+                                                  uint8_t op_code,
+                                                  uint8_t attempt,
+                                                  astronode_trace_status_t answer_status,
+                                                  uint16_t error_code);
+
+/**
+ * @brief Return the jittered delay to wait before the retry n (0 for the first one).
+ */
+uint16_t astronode_retry_get_backoff_ms(astronode_ctx_t *p_ctx, uint8_t retry);
+
+astronode_circuit_state_t astronode_retry_get_circuit_state(const astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Enable (default) or disable the retries and the circuit breaker of this Astronode.
+ */
+void astronode_retry_set_enabled(astronode_ctx_t *p_ctx, bool is_enabled);
+
+
+#endif /* ASTRONODE_RETRY_H */
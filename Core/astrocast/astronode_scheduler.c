@@ -0,0 +1,276 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_scheduler.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define ASTRONODE_SCHEDULER_DEBUG_BUFFER_LENGTH 80
+
+// Time spent awake for one action (NCO_RR, LCD_RR or the uplink preparation) in simulation.
+#define ASTRONODE_SCHEDULER_SIMULATION_STEP_MS  500
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static astronode_ctx_t *g_p_ctx = NULL;
+static astronode_scheduler_prepare_uplink_t g_prepare_uplink = NULL;
+static bool g_is_pass_planned = false;
+static bool g_is_uplink_prepared = false;
+static uint32_t g_pass_start_ms = 0;
+static uint32_t g_pass_duration_ms = ASTRONODE_SCHEDULER_DEFAULT_PASS_MS;
+static uint32_t g_refresh_at_ms = 0;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static bool is_time_reached(uint32_t now_ms, uint32_t target_ms);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+static bool is_time_reached(uint32_t now_ms, uint32_t target_ms)
+{
+    // Wrap-around safe comparison of two systick values.
+    return (int32_t)(now_ms - target_ms) >= 0;
+}
+
+void astronode_scheduler_init(astronode_ctx_t *p_ctx, astronode_scheduler_prepare_uplink_t prepare_uplink)
+{
+    g_p_ctx = p_ctx;
+    g_prepare_uplink = prepare_uplink;
+    g_is_pass_planned = false;
+    g_is_uplink_prepared = false;
+    g_pass_start_ms = 0;
+    g_pass_duration_ms = ASTRONODE_SCHEDULER_DEFAULT_PASS_MS;
+    g_refresh_at_ms = 0;
+}
+
+void astronode_scheduler_set_next_pass(uint32_t now_ms, uint32_t time_to_next_pass_s)
+{
+    uint32_t pass_start_ms = now_ms + time_to_next_pass_s * 1000;
+
+    if (g_is_pass_planned
+        && g_is_uplink_prepared
+        && !is_time_reached(pass_start_ms, g_pass_start_ms + g_pass_duration_ms))
+    {
+        // Same pass as the one already served, ask again once it is over.
+        g_refresh_at_ms = now_ms + ASTRONODE_SCHEDULER_PREPARE_LEAD_MS;
+        return;
+    }
+
+    g_pass_start_ms = pass_start_ms;
+    g_is_pass_planned = true;
+    g_is_uplink_prepared = false;
+    g_refresh_at_ms = now_ms + ASTRONODE_SCHEDULER_MAX_SLEEP_MS;
+}
+
+void astronode_scheduler_set_last_contact(const astronode_last_contact_t *p_last_contact)
+{
+    if (p_last_contact->end_of_last_pass > p_last_contact->start_of_last_pass)
+    {
+        g_pass_duration_ms = (p_last_contact->end_of_last_pass - p_last_contact->start_of_last_pass) * 1000;
+    }
+}
+
+void astronode_scheduler_set_uplink_prepared(uint32_t now_ms)
+{
+    g_is_uplink_prepared = true;
+
+    // Nothing left to do for this pass, sleep until it is over.
+    g_refresh_at_ms = g_pass_start_ms + g_pass_duration_ms;
+    if (is_time_reached(now_ms, g_refresh_at_ms))
+    {
+        g_refresh_at_ms = now_ms + ASTRONODE_SCHEDULER_PREPARE_LEAD_MS;
+    }
+}
+
+astronode_scheduler_action_t astronode_scheduler_get_next_action(uint32_t now_ms, uint32_t *p_sleep_ms)
+{
+    uint32_t wake_up_ms = 0;
+
+    *p_sleep_ms = 0;
+
+    if (g_is_pass_planned == false)
+    {
+        return ASTRONODE_SCHEDULER_ACTION_REFRESH_NCO;
+    }
+
+    if (g_is_uplink_prepared == false)
+    {
+        wake_up_ms = g_pass_start_ms - ASTRONODE_SCHEDULER_PREPARE_LEAD_MS;
+
+        if (is_time_reached(now_ms, wake_up_ms))
+        {
+            return ASTRONODE_SCHEDULER_ACTION_PREPARE_UPLINK;
+        }
+    }
+    else
+    {
+        wake_up_ms = g_pass_start_ms + g_pass_duration_ms;
+    }
+
+    if (is_time_reached(now_ms, g_refresh_at_ms))
+    {
+        return ASTRONODE_SCHEDULER_ACTION_REFRESH_NCO;
+    }
+
+    if (is_time_reached(wake_up_ms, g_refresh_at_ms))
+    {
+        wake_up_ms = g_refresh_at_ms;
+    }
+
+    *p_sleep_ms = wake_up_ms - now_ms;
+    return ASTRONODE_SCHEDULER_ACTION_SLEEP;
+}
+
+void astronode_scheduler_run(uint32_t max_sleep_ms)
+{
+    uint32_t sleep_ms = 0;
+
+    switch (astronode_scheduler_get_next_action(get_systick(), &sleep_ms))
+    {
+        case ASTRONODE_SCHEDULER_ACTION_REFRESH_NCO:
+        {
+            uint32_t time_to_next_pass_s = 0;
+
+            if (g_is_uplink_prepared)
+            {
+                astronode_last_contact_t last_contact = {0};
+
+                if (astronode_send_lcd_rr(g_p_ctx, &last_contact) == RS_SUCCESS)
+                {
+                    astronode_scheduler_set_last_contact(&last_contact);
+                }
+            }
+
+            if (astronode_send_nco_rr(g_p_ctx, &time_to_next_pass_s) == RS_SUCCESS)
+            {
+                astronode_scheduler_set_next_pass(get_systick(), time_to_next_pass_s);
+            }
+            else
+            {
+                // Try again later, within the sleep allowed by the caller.
+                enter_sleep_mode(ASTRONODE_SCHEDULER_PREPARE_LEAD_MS < max_sleep_ms ? ASTRONODE_SCHEDULER_PREPARE_LEAD_MS : max_sleep_ms);
+            }
+            break;
+        }
+
+        case ASTRONODE_SCHEDULER_ACTION_PREPARE_UPLINK:
+            send_debug_logs("Pass is imminent, prepare the uplink.");
+            if (g_prepare_uplink != NULL)
+            {
+                g_prepare_uplink();
+            }
+            astronode_scheduler_set_uplink_prepared(get_systick());
+            break;
+
+        case ASTRONODE_SCHEDULER_ACTION_SLEEP:
+            enter_sleep_mode(sleep_ms < max_sleep_ms ? sleep_ms : max_sleep_ms);
+            break;
+    }
+}
+
+#ifdef ASTRONODE_SCHEDULER_SIMULATION
+void astronode_scheduler_simulate(const uint32_t *p_pass_start_s, const uint32_t *p_pass_duration_s, uint16_t pass_count)
+{
+    char str[ASTRONODE_SCHEDULER_DEBUG_BUFFER_LENGTH];
+    uint32_t now_ms = 0;
+    uint32_t sleep_total_ms = 0;
+    uint32_t latency_sum_ms = 0;
+    uint32_t latency_max_ms = 0;
+    uint16_t pass_index = 0;
+    uint16_t prepared_count = 0;
+    uint16_t refresh_count = 0;
+    bool is_pass_served = false;
+
+    astronode_scheduler_init(NULL, NULL);
+
+    while (pass_index < pass_count)
+    {
+        uint32_t pass_start_ms = p_pass_start_s[pass_index] * 1000;
+        uint32_t pass_end_ms = pass_start_ms + p_pass_duration_s[pass_index] * 1000;
+        uint32_t sleep_ms = 0;
+
+        if (is_time_reached(now_ms, pass_end_ms))
+        {
+            if (is_pass_served == false)
+            {
+                sprintf(str, "Pass %u missed.", pass_index);
+                send_debug_logs(str);
+            }
+            pass_index++;
+            is_pass_served = false;
+            continue;
+        }
+
+        switch (astronode_scheduler_get_next_action(now_ms, &sleep_ms))
+        {
+            case ASTRONODE_SCHEDULER_ACTION_REFRESH_NCO:
+                if (g_is_uplink_prepared && pass_index > 0)
+                {
+                    astronode_last_contact_t last_contact = {0};
+
+                    last_contact.start_of_last_pass = p_pass_start_s[pass_index - 1];
+                    last_contact.end_of_last_pass = p_pass_start_s[pass_index - 1] + p_pass_duration_s[pass_index - 1];
+                    astronode_scheduler_set_last_contact(&last_contact);
+                }
+                astronode_scheduler_set_next_pass(now_ms,
+                                                  is_time_reached(now_ms, pass_start_ms) ? 0 : (pass_start_ms - now_ms) / 1000);
+                refresh_count++;
+                now_ms += ASTRONODE_SCHEDULER_SIMULATION_STEP_MS;
+                break;
+
+            case ASTRONODE_SCHEDULER_ACTION_PREPARE_UPLINK:
+            {
+                // Age of the data when the satellite becomes reachable.
+                uint32_t latency_ms = is_time_reached(now_ms, pass_start_ms) ? 0 : pass_start_ms - now_ms;
+
+                astronode_scheduler_set_uplink_prepared(now_ms);
+                if (is_pass_served == false)
+                {
+                    latency_sum_ms += latency_ms;
+                    latency_max_ms = latency_ms > latency_max_ms ? latency_ms : latency_max_ms;
+                    prepared_count++;
+                    is_pass_served = true;
+                }
+                now_ms += ASTRONODE_SCHEDULER_SIMULATION_STEP_MS;
+                break;
+            }
+
+            case ASTRONODE_SCHEDULER_ACTION_SLEEP:
+                now_ms += sleep_ms;
+                sleep_total_ms += sleep_ms;
+                break;
+        }
+    }
+
+    sprintf(str, "Passes served: %u/%u, NCO refreshes: %u.", prepared_count, pass_count, refresh_count);
+    send_debug_logs(str);
+    if (prepared_count > 0)
+    {
+        sprintf(str, "Data freshness latency: mean %lums, max %lums.",
+                (unsigned long) (latency_sum_ms / prepared_count), (unsigned long) latency_max_ms);
+        send_debug_logs(str);
+    }
+    if (now_ms > 0)
+    {
+        sprintf(str, "Time spent asleep: %lu%%.", (unsigned long) ((uint64_t) sleep_total_ms * 100 / now_ms));
+        send_debug_logs(str);
+    }
+}
+#endif
@@ -0,0 +1,95 @@
+#ifndef ASTRONODE_SCHEDULER_H
+#define ASTRONODE_SCHEDULER_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_application.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Time needed before the start of a pass to aggregate, pack and enqueue the data.
+#ifndef ASTRONODE_SCHEDULER_PREPARE_LEAD_MS
+#define ASTRONODE_SCHEDULER_PREPARE_LEAD_MS     10000
+#endif
+
+// Pass duration assumed until a last contact (LCD_RR) has been read.
+#ifndef ASTRONODE_SCHEDULER_DEFAULT_PASS_MS
+#define ASTRONODE_SCHEDULER_DEFAULT_PASS_MS     300000
+#endif
+
+// Longest sleep before the next communication opportunity is read again (NCO_RR),
+// so that the prediction is refreshed against the clock drift of the asset.
+#ifndef ASTRONODE_SCHEDULER_MAX_SLEEP_MS
+#define ASTRONODE_SCHEDULER_MAX_SLEEP_MS        900000
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_scheduler_action_t
+{
+    ASTRONODE_SCHEDULER_ACTION_REFRESH_NCO,
+    ASTRONODE_SCHEDULER_ACTION_PREPARE_UPLINK,
+    ASTRONODE_SCHEDULER_ACTION_SLEEP
+} astronode_scheduler_action_t;
+
+/**
+ * @brief Called once per pass to aggregate, pack and enqueue the sensor data.
+ */
+typedef void (*astronode_scheduler_prepare_uplink_t)(void);
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Reset the scheduler of this Astronode and register the callback preparing the uplink.
+ */
+void astronode_scheduler_init(astronode_ctx_t *p_ctx, astronode_scheduler_prepare_uplink_t prepare_uplink);
+
+/**
+ * @brief Plan the next pass from the time to next communication opportunity (NCO_RR).
+ */
+void astronode_scheduler_set_next_pass(uint32_t now_ms, uint32_t time_to_next_pass_s);
+
+/**
+ * @brief Update the expected pass duration from the last contact details (LCD_RR).
+ */
+void astronode_scheduler_set_last_contact(const astronode_last_contact_t *p_last_contact);
+
+/**
+ * @brief Mark the uplink of the planned pass as prepared.
+ */
+void astronode_scheduler_set_uplink_prepared(uint32_t now_ms);
+
+/**
+ * @brief Return the next action to take at now_ms, and the sleep duration if any.
+ */
+astronode_scheduler_action_t astronode_scheduler_get_next_action(uint32_t now_ms, uint32_t *p_sleep_ms);
+
+/**
+ * @brief Execute the next action: read NCO/LCD, prepare the uplink or sleep until the next step.
+ * The sleep is bounded by max_sleep_ms so that the caller can keep its own periodic tasks.
+ */
+void astronode_scheduler_run(uint32_t max_sleep_ms);
+
+#ifdef ASTRONODE_SCHEDULER_SIMULATION
+/**
+ * @brief Replay a synthetic pass timeline (pass start and duration in seconds) and
+ * report the data freshness latency at the start of each pass.
+ */
+void astronode_scheduler_simulate(const uint32_t *p_pass_start_s, const uint32_t *p_pass_duration_s, uint16_t pass_count);
+#endif
+
+
+#endif /* ASTRONODE_SCHEDULER_H */
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_search_tuner.h"
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static astronode_ctx_t *g_p_ctx = NULL;
+static astronode_search_tuner_state_t g_state = {0};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_search_tuner_init(astronode_ctx_t *p_ctx)
+{
+    g_p_ctx = p_ctx;
+    astronode_search_tuner_reset_state(&g_state);
+}
+
+void astronode_search_tuner_reset_state(astronode_search_tuner_state_t *p_state)
+{
+    p_state->is_config_applied = false;
+    p_state->config.search_period_enum = ASTRONODE_SEARCH_TUNER_PERIOD_RELAXED;
+    p_state->config.enable_search_without_msg_queued = false;
+}
+
+bool astronode_search_tuner_update(astronode_search_tuner_state_t *p_state,
+                                   const astronode_search_tuner_input_t *p_input,
+                                   astronode_search_tuner_config_t *p_config)
+{
+    astronode_search_tuner_config_t config = {0};
+    uint32_t imminent_pass_s = ASTRONODE_SEARCH_TUNER_IMMINENT_PASS_S;
+
+    if (p_state->is_config_applied && p_state->config.search_period_enum == ASTRONODE_SEARCH_TUNER_PERIOD_AGGRESSIVE)
+    {
+        imminent_pass_s += ASTRONODE_SEARCH_TUNER_HYSTERESIS_S;
+    }
+
+    if (p_input->asset_backlog == 0 && p_input->module_queue_depth == 0)
+    {
+        // Nothing to send, search as rarely as possible.
+        config.search_period_enum = ASTRONODE_SEARCH_TUNER_PERIOD_RELAXED;
+        config.enable_search_without_msg_queued = false;
+    }
+    else if (p_input->time_to_next_pass_s <= imminent_pass_s)
+    {
+        // Backlog and a satellite about to be reachable. Search even if the module
+        // queue is still empty, the asset backlog is about to be enqueued.
+        config.search_period_enum = ASTRONODE_SEARCH_TUNER_PERIOD_AGGRESSIVE;
+        config.enable_search_without_msg_queued = p_input->asset_backlog > 0;
+    }
+    else if (p_input->last_search_rssi < ASTRONODE_SEARCH_TUNER_WEAK_RSSI)
+    {
+        config.search_period_enum = ASTRONODE_SEARCH_TUNER_PERIOD_RELAXED;
+        config.enable_search_without_msg_queued = false;
+    }
+    else
+    {
+        config.search_period_enum = ASTRONODE_SEARCH_TUNER_PERIOD_NORMAL;
+        config.enable_search_without_msg_queued = false;
+    }
+
+    bool is_changed = p_state->is_config_applied == false
+                      || config.search_period_enum != p_state->config.search_period_enum
+                      || config.enable_search_without_msg_queued != p_state->config.enable_search_without_msg_queued;
+
+    p_state->config = config;
+    p_state->is_config_applied = true;
+    *p_config = config;
+
+    return is_changed;
+}
+
+void astronode_search_tuner_run(uint16_t asset_backlog)
+{
+    astronode_search_tuner_input_t input = {0};
+    astronode_search_tuner_config_t config = {0};
+    astronode_module_state_t module_state = {0};
+    astronode_environment_details_t environment_details = {0};
+
+    if (astronode_send_mst_rr(g_p_ctx, &module_state) != RS_SUCCESS
+        || astronode_send_end_rr(g_p_ctx, &environment_details) != RS_SUCCESS
+        || astronode_send_nco_rr(g_p_ctx, &input.time_to_next_pass_s) != RS_SUCCESS)
+    {
+        return;
+    }
+
+    input.asset_backlog = asset_backlog;
+    input.module_queue_depth = module_state.msg_in_queue;
+    input.last_search_rssi = environment_details.last_sat_search_peak_rssi;
+
+    if (astronode_search_tuner_update(&g_state, &input, &config))
+    {
+        if (astronode_send_ssc_wr(g_p_ctx, config.search_period_enum, config.enable_search_without_msg_queued) != RS_SUCCESS)
+        {
+            // Force a new write at the next run.
+            g_state.is_config_applied = false;
+        }
+    }
+}
+
+void astronode_search_tuner_replay(const astronode_search_tuner_input_t *p_trace,
+                                   uint16_t trace_length,
+                                   astronode_search_tuner_config_t *p_configs)
+{
+    astronode_search_tuner_state_t state = {0};
+
+    astronode_search_tuner_reset_state(&state);
+    for (uint16_t i = 0; i < trace_length; i++)
+    {
+        astronode_search_tuner_update(&state, &p_trace[i], &p_configs[i]);
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef ASTRONODE_SEARCH_TUNER_H
+#define ASTRONODE_SEARCH_TUNER_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Search period enumerations written with SSC_WR, from the shortest to the longest period.
+#ifndef ASTRONODE_SEARCH_TUNER_PERIOD_AGGRESSIVE
+#define ASTRONODE_SEARCH_TUNER_PERIOD_AGGRESSIVE    0
+#endif
+#ifndef ASTRONODE_SEARCH_TUNER_PERIOD_NORMAL
+#define ASTRONODE_SEARCH_TUNER_PERIOD_NORMAL        1
+#endif
+#ifndef ASTRONODE_SEARCH_TUNER_PERIOD_RELAXED
+#define ASTRONODE_SEARCH_TUNER_PERIOD_RELAXED       3
+#endif
+
+// A pass is imminent when the next communication opportunity is closer than this.
+#ifndef ASTRONODE_SEARCH_TUNER_IMMINENT_PASS_S
+#define ASTRONODE_SEARCH_TUNER_IMMINENT_PASS_S      120
+#endif
+
+// Extra margin before leaving the aggressive search, to avoid toggling the configuration.
+#ifndef ASTRONODE_SEARCH_TUNER_HYSTERESIS_S
+#define ASTRONODE_SEARCH_TUNER_HYSTERESIS_S         60
+#endif
+
+// Below this peak RSSI of the last search, searching often is not worth the energy.
+#ifndef ASTRONODE_SEARCH_TUNER_WEAK_RSSI
+#define ASTRONODE_SEARCH_TUNER_WEAK_RSSI            20
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct astronode_search_tuner_input_t
+{
+    uint16_t    asset_backlog;          // Payloads waiting on the asset side
+    uint8_t     module_queue_depth;     // MST_RR messages in queue
+    uint8_t     last_search_rssi;       // END_RR last satellite search peak RSSI
+    uint32_t    time_to_next_pass_s;    // NCO_RR time to next communication opportunity
+} astronode_search_tuner_input_t;
+
+typedef struct astronode_search_tuner_config_t
+{
+    uint8_t     search_period_enum;
+    bool        enable_search_without_msg_queued;
+} astronode_search_tuner_config_t;
+
+// Configuration last applied, carried from one update to the next.
+typedef struct astronode_search_tuner_state_t
+{
+    bool                            is_config_applied;
+    astronode_search_tuner_config_t config;
+} astronode_search_tuner_state_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Reset the tuner of this Astronode, the next update always reports a configuration change.
+ */
+void astronode_search_tuner_init(astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Reset a tuner state, the next update with it always reports a configuration change.
+ */
+void astronode_search_tuner_reset_state(astronode_search_tuner_state_t *p_state);
+
+/**
+ * @brief Compute the search configuration for the given inputs and state, return true if it changed.
+ */
+bool astronode_search_tuner_update(astronode_search_tuner_state_t *p_state,
+                                   const astronode_search_tuner_input_t *p_input,
+                                   astronode_search_tuner_config_t *p_config);
+
+/**
+ * @brief Read MST_RR, END_RR and NCO_RR, and write SSC_WR if the configuration changed.
+ */
+void astronode_search_tuner_run(uint16_t asset_backlog);
+
+/**
+ * @brief Replay an input trace from a reset state, storing the configuration after each input.
+ * The tuner of astronode_search_tuner_run() is left untouched.
+ */
+void astronode_search_tuner_replay(const astronode_search_tuner_input_t *p_trace,
+                                   uint16_t trace_length,
+                                   astronode_search_tuner_config_t *p_configs);
+
+
+#endif /* ASTRONODE_SEARCH_TUNER_H */
@@ -0,0 +1,256 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_trace.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct trace_ring_t
+{
+    uint32_t    magic;
+    uint16_t    version;
+    uint16_t    header_length;
+    uint32_t    buffer_length;
+    uint32_t    head;           // Offset of the oldest record
+    uint32_t    used;           // Bytes of the records
+    uint32_t    record_count;
+    uint32_t    dropped_count;
+    uint32_t    boot_count;
+    uint8_t     p_buffer[ASTRONODE_TRACE_BUFFER_LEN_BYTES];
+} trace_ring_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+ASTRONODE_TRACE_SECTION static trace_ring_t g_trace_ring;
+
+static bool g_is_recording = false;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static bool is_ring_valid(void);
+static void read_ring(uint32_t offset, uint8_t *p_data, uint16_t length);
+static void write_ring(uint32_t offset, const uint8_t *p_data, uint16_t length);
+static uint16_t read_frame_length(uint32_t offset);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+bool astronode_trace_init(void)
+{
+    bool is_retained = is_ring_valid();
+
+    if (is_retained)
+    {
+        g_trace_ring.boot_count++;
+    }
+    else
+    {
+        astronode_trace_clear();
+    }
+    g_is_recording = true;
+
+    return is_retained && g_trace_ring.record_count > 0;
+}
+
+void astronode_trace_clear(void)
+{
+    memset(&g_trace_ring, 0, sizeof(g_trace_ring) - sizeof(g_trace_ring.p_buffer));
+    g_trace_ring.magic = ASTRONODE_TRACE_MAGIC;
+    g_trace_ring.version = ASTRONODE_TRACE_VERSION;
+    g_trace_ring.header_length = ASTRONODE_TRACE_HEADER_LEN_BYTES;
+    g_trace_ring.buffer_length = ASTRONODE_TRACE_BUFFER_LEN_BYTES;
+}
+
+void astronode_trace_record(astronode_trace_direction_t direction,
+                            uint8_t op_code,
+                            astronode_trace_status_t status,
+                            uint16_t error_code,
+                            const uint8_t *p_frame,
+                            uint16_t frame_length)
+{
+    uint32_t record_length = ASTRONODE_TRACE_HEADER_LEN_BYTES + frame_length;
+    uint32_t timestamp_ms = get_systick();
+
+    if (g_is_recording == false || record_length > ASTRONODE_TRACE_BUFFER_LEN_BYTES)
+    {
+        return;
+    }
+
+    while (ASTRONODE_TRACE_BUFFER_LEN_BYTES - g_trace_ring.used < record_length)
+    {
+        uint32_t oldest_length = ASTRONODE_TRACE_HEADER_LEN_BYTES + read_frame_length(g_trace_ring.head);
+
+        if (oldest_length > g_trace_ring.used)
+        {
+            astronode_trace_clear();
+            break;
+        }
+        g_trace_ring.head = (g_trace_ring.head + oldest_length) % ASTRONODE_TRACE_BUFFER_LEN_BYTES;
+        g_trace_ring.used -= oldest_length;
+        g_trace_ring.record_count--;
+        g_trace_ring.dropped_count++;
+    }
+
+    uint8_t p_header[ASTRONODE_TRACE_HEADER_LEN_BYTES] =
+    {
+        (uint8_t) frame_length,
+        (uint8_t) (frame_length >> 8),
+        (uint8_t) timestamp_ms,
+        (uint8_t) (timestamp_ms >> 8),
+        (uint8_t) (timestamp_ms >> 16),
+        (uint8_t) (timestamp_ms >> 24),
+        (uint8_t) direction,
+        op_code,
+        (uint8_t) status,
+        (uint8_t) error_code,
+        (uint8_t) (error_code >> 8)
+    };
+    uint32_t tail = (g_trace_ring.head + g_trace_ring.used) % ASTRONODE_TRACE_BUFFER_LEN_BYTES;
+
+    // The record is written before it is counted, a reset in between only loses it.
+    write_ring(tail, p_header, sizeof(p_header));
+    write_ring(tail + sizeof(p_header), p_frame, frame_length);
+    g_trace_ring.used += record_length;
+    g_trace_ring.record_count++;
+}
+
+astronode_trace_status_t astronode_trace_get_answer_status(return_status_t status, uint8_t answer_op_code, uint16_t answer_length)
+{
+    if (status == RS_SUCCESS)
+    {
+        return answer_op_code == ASTRONODE_OP_CODE_ERROR ? ASTRONODE_TRACE_STATUS_MODULE_ERROR : ASTRONODE_TRACE_STATUS_OK;
+    }
+    return answer_length == 0 ? ASTRONODE_TRACE_STATUS_TIMEOUT : ASTRONODE_TRACE_STATUS_INVALID;
+}
+
+uint16_t astronode_trace_read(uint32_t *p_cursor, uint8_t *p_record, uint16_t capacity)
+{
+    if (is_ring_valid() == false || *p_cursor >= g_trace_ring.used)
+    {
+        return 0;
+    }
+
+    uint32_t offset = (g_trace_ring.head + *p_cursor) % ASTRONODE_TRACE_BUFFER_LEN_BYTES;
+    uint32_t record_length = ASTRONODE_TRACE_HEADER_LEN_BYTES + read_frame_length(offset);
+
+    if (record_length > capacity || *p_cursor + record_length > g_trace_ring.used)
+    {
+        return 0;
+    }
+
+    read_ring(offset, p_record, (uint16_t) record_length);
+    *p_cursor += record_length;
+
+    return (uint16_t) record_length;
+}
+
+return_status_t astronode_trace_parse(const uint8_t *p_record, uint16_t length, astronode_trace_record_t *p_parsed)
+{
+    if (length < ASTRONODE_TRACE_HEADER_LEN_BYTES)
+    {
+        return RS_FAILURE;
+    }
+
+    p_parsed->frame_length = p_record[0] | (p_record[1] << 8);
+    p_parsed->timestamp_ms = p_record[2]
+                             | ((uint32_t) p_record[3] << 8)
+                             | ((uint32_t) p_record[4] << 16)
+                             | ((uint32_t) p_record[5] << 24);
+    p_parsed->direction = p_record[6];
+    p_parsed->op_code = p_record[7];
+    p_parsed->status = p_record[8];
+    p_parsed->error_code = p_record[9] | (p_record[10] << 8);
+    p_parsed->p_frame = &p_record[ASTRONODE_TRACE_HEADER_LEN_BYTES];
+
+    if (ASTRONODE_TRACE_HEADER_LEN_BYTES + p_parsed->frame_length != length)
+    {
+        return RS_FAILURE;
+    }
+    return RS_SUCCESS;
+}
+
+uint32_t astronode_trace_get_record_count(void)
+{
+    return is_ring_valid() ? g_trace_ring.record_count : 0;
+}
+
+void astronode_trace_dump(void)
+{
+    static const char p_hex[] = "0123456789ABCDEF";
+    static uint8_t p_record[ASTRONODE_TRACE_HEADER_LEN_BYTES + ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES];
+    static char str[sizeof(ASTRONODE_TRACE_DUMP_PREFIX) + 2 * sizeof(p_record)];
+    uint32_t cursor = 0;
+    uint16_t length = 0;
+
+    sprintf(str, ASTRONODE_TRACE_DUMP_PREFIX "BEGIN %" PRIu32 " records, %" PRIu32 " dropped, %" PRIu32 " warm resets",
+            astronode_trace_get_record_count(), g_trace_ring.dropped_count, g_trace_ring.boot_count);
+    send_debug_logs(str);
+
+    while ((length = astronode_trace_read(&cursor, p_record, sizeof(p_record))) > 0)
+    {
+        char *p_str = str + sprintf(str, ASTRONODE_TRACE_DUMP_PREFIX);
+
+        for (uint16_t i = 0; i < length; i++)
+        {
+            *p_str++ = p_hex[p_record[i] >> 4];
+            *p_str++ = p_hex[p_record[i] & 0x0F];
+        }
+        *p_str = '\0';
+        send_debug_logs(str);
+    }
+
+    send_debug_logs(ASTRONODE_TRACE_DUMP_PREFIX "END");
+}
+
+static bool is_ring_valid(void)
+{
+    return g_trace_ring.magic == ASTRONODE_TRACE_MAGIC
+           && g_trace_ring.version == ASTRONODE_TRACE_VERSION
+           && g_trace_ring.header_length == ASTRONODE_TRACE_HEADER_LEN_BYTES
+           && g_trace_ring.buffer_length == ASTRONODE_TRACE_BUFFER_LEN_BYTES
+           && g_trace_ring.head < ASTRONODE_TRACE_BUFFER_LEN_BYTES
+           && g_trace_ring.used <= ASTRONODE_TRACE_BUFFER_LEN_BYTES;
+}
+
+static void read_ring(uint32_t offset, uint8_t *p_data, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++)
+    {
+        p_data[i] = g_trace_ring.p_buffer[(offset + i) % ASTRONODE_TRACE_BUFFER_LEN_BYTES];
+    }
+}
+
+static void write_ring(uint32_t offset, const uint8_t *p_data, uint16_t length)
+{
+    for (uint16_t i = 0; i < length; i++)
+    {
+        g_trace_ring.p_buffer[(offset + i) % ASTRONODE_TRACE_BUFFER_LEN_BYTES] = p_data[i];
+    }
+}
+
+static uint16_t read_frame_length(uint32_t offset)
+{
+    uint8_t p_length[2];
+
+    read_ring(offset, p_length, sizeof(p_length));
+
+    return p_length[0] | (p_length[1] << 8);
+}
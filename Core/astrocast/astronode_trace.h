@@ -0,0 +1,115 @@
+#ifndef ASTRONODE_TRACE_H
+#define ASTRONODE_TRACE_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#ifndef ASTRONODE_TRACE_BUFFER_LEN_BYTES
+#define ASTRONODE_TRACE_BUFFER_LEN_BYTES    8192
+#endif
+
+// The ring is kept in its own section, not initialized at start: placed in SRAM2 by
+// the linker script, it survives the warm resets.
+#ifndef ASTRONODE_TRACE_SECTION
+#define ASTRONODE_TRACE_SECTION             __attribute__((section(".astronode_trace")))
+#endif
+
+#define ASTRONODE_TRACE_MAGIC               0x43415254 // "TRAC"
+#define ASTRONODE_TRACE_VERSION             1
+
+// Record layout (little endian):
+// frame length (2) | timestamp ms (4) | direction (1) | request op code (1) | status (1) |
+// module error code (2) | frame as sent or received on the wire
+#define ASTRONODE_TRACE_HEADER_LEN_BYTES    11
+
+// Lines written by astronode_trace_dump(), one record in hexadecimal per line.
+#define ASTRONODE_TRACE_DUMP_PREFIX         "TRACE "
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef enum astronode_trace_direction_t
+{
+    ASTRONODE_TRACE_DIRECTION_TX = 0,
+    ASTRONODE_TRACE_DIRECTION_RX = 1
+} astronode_trace_direction_t;
+
+typedef enum astronode_trace_status_t
+{
+    ASTRONODE_TRACE_STATUS_SENT = 0,            // TX frame
+    ASTRONODE_TRACE_STATUS_OK = 1,              // Valid answer
+    ASTRONODE_TRACE_STATUS_MODULE_ERROR = 2,    // Valid error answer, see the error code
+    ASTRONODE_TRACE_STATUS_INVALID = 3,         // Answer rejected by the transport
+    ASTRONODE_TRACE_STATUS_TIMEOUT = 4          // No answer
+} astronode_trace_status_t;
+
+typedef struct astronode_trace_record_t
+{
+    uint16_t        frame_length;
+    uint32_t        timestamp_ms;
+    uint8_t         direction;
+    uint8_t         op_code;
+    uint8_t         status;
+    uint16_t        error_code;
+    const uint8_t  *p_frame;
+} astronode_trace_record_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Start recording, return true if the trace of the previous run was retained.
+ */
+bool astronode_trace_init(void);
+
+void astronode_trace_clear(void);
+
+/**
+ * @brief Record a frame, the oldest records are dropped to make room for it.
+ */
+void astronode_trace_record(astronode_trace_direction_t direction,
+                            uint8_t op_code,
+                            astronode_trace_status_t status,
+                            uint16_t error_code,
+                            const uint8_t *p_frame,
+                            uint16_t frame_length);
+
+/**
+ * @brief Return the status of an answer from the result of the transport.
+ */
+astronode_trace_status_t astronode_trace_get_answer_status(return_status_t status, uint8_t answer_op_code, uint16_t answer_length);
+
+/**
+ * @brief Copy the record at *p_cursor (0 for the oldest) in p_record and move the cursor
+ * to the next one. Return the record length, 0 at the end or if it does not fit.
+ */
+uint16_t astronode_trace_read(uint32_t *p_cursor, uint8_t *p_record, uint16_t capacity);
+
+/**
+ * @brief Parse a record copied by astronode_trace_read(), p_frame points into p_record.
+ */
+return_status_t astronode_trace_parse(const uint8_t *p_record, uint16_t length, astronode_trace_record_t *p_parsed);
+
+uint32_t astronode_trace_get_record_count(void);
+
+/**
+ * @brief Write every record with send_debug_logs(), from the oldest one.
+ */
+void astronode_trace_dump(void);
+
+
+#endif /* ASTRONODE_TRACE_H */
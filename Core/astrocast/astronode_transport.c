@@ -8,6 +8,12 @@
 
 // Astrocast
 #include "astronode_definitions.h"
+#include "astronode_context.h"
+#include "astronode_metrics.h"
+#include "astronode_pool.h"
+#include "astronode_profile.h"
+#include "astronode_retry.h"
+#include "astronode_trace.h"
 #include "astronode_transport.h"
 #include "drivers.h"
 
@@ -15,12 +21,32 @@
 //------------------------------------------------------------------------------
 // Definitions
 //------------------------------------------------------------------------------
-// STX + OPCODE + Parameters + CRC + ETX
-#define ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES ( 1 + \
-                                                2 + \
-                                                2 * ASTRONODE_APP_MSG_MAX_LEN_BYTES + \
-                                                4 + \
-                                                1)
+// STX + OPCODE + CRC + ETX
+#define ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES 8
+
+#define OP_CODE_DESCRIPTOR_ENTRY(request, answer, min_length, max_length, timeout_ms) \
+    [request] = { answer, min_length, max_length, timeout_ms, ASTRONODE_OP_CODE_INDEX_##request + 1 },
+
+#define OP_CODE_DESCRIPTOR_CHECK(request, answer, min_length, max_length, timeout_ms) \
+    _Static_assert((answer) == ((request) | 0x80), "The answer op code is the request op code with bit 7 set."); \
+    _Static_assert((min_length) <= (max_length), "The minimum answer length exceeds the maximum."); \
+    _Static_assert(ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * (max_length) <= ASTRONODE_MAX_LENGTH_RESPONSE, \
+                   "The maximum answer length exceeds ASTRONODE_MAX_LENGTH_RESPONSE.");
+
+ASTRONODE_OP_CODE_DESCRIPTORS(OP_CODE_DESCRIPTOR_CHECK)
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct op_code_descriptor_t
+{
+    uint8_t     answer_op_code;
+    uint8_t     answer_min_len;
+    uint8_t     answer_max_len;
+    uint16_t    timeout_ms;
+    uint8_t     latency_index;  // Index + 1 in the latency estimates, 0 if not learned
+} op_code_descriptor_t;
 
 
 //------------------------------------------------------------------------------
@@ -31,17 +57,29 @@ static const uint8_t g_ascii_lookup[16] =
     '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
 };
 
+// Indexed by the request op code, requests not listed have a null answer op code.
+static const op_code_descriptor_t g_op_code_descriptors[0x80] =
+{
+    ASTRONODE_OP_CODE_DESCRIPTORS(OP_CODE_DESCRIPTOR_ENTRY)
+};
+
+
 
 //------------------------------------------------------------------------------
 // Function declarations
 //------------------------------------------------------------------------------
 static bool ascii_to_value(const uint8_t ascii, uint8_t *p_value);
 static uint16_t astronode_create_request_transport(astronode_app_msg_t *p_source_message, uint8_t *p_destination_buffer);
-static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffer, uint16_t length_buffer, astronode_app_msg_t *p_destination_message);
+static return_status_t astronode_decode_answer_transport(astronode_ctx_t *p_ctx, uint8_t *p_source_buffer, uint16_t length_buffer, astronode_app_msg_t *p_destination_message);
 static uint16_t calculate_crc(const uint8_t *p_data, uint16_t data_len, uint16_t init_value);
-static void check_for_error(astronode_app_msg_t *p_answer);
-static return_status_t receive_astronode_answer(uint8_t *p_rx_buffer, uint16_t *p_buffer_length);
+static void check_for_error(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_answer);
+static uint16_t compute_answer_timeout(const astronode_ctx_t *p_ctx, const op_code_descriptor_t *p_descriptor, uint16_t request_length);
+static op_code_descriptor_t get_descriptor(uint8_t op_code);
+static void mark_phase(astronode_ctx_t *p_ctx, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status);
+static return_status_t receive_astronode_answer(astronode_ctx_t *p_ctx, uint8_t *p_rx_buffer, uint16_t *p_buffer_length, const op_code_descriptor_t *p_descriptor, uint32_t *p_latency_ms);
+static return_status_t send_receive_once(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer, astronode_trace_status_t *p_answer_status);
 static void uint8_to_ascii_buffer(const uint8_t value, uint8_t *p_target_buffer);
+static void update_latency_estimate(astronode_ctx_t *p_ctx, const op_code_descriptor_t *p_descriptor, astronode_trace_status_t answer_status, uint32_t latency_ms);
 
 
 //------------------------------------------------------------------------------
@@ -69,6 +107,8 @@ static uint16_t astronode_create_request_transport(astronode_app_msg_t *p_source
 {
     uint16_t index = 0;
 
+    ASTRONODE_PROFILE_START(CREATE_REQUEST);
+
     p_destination_buffer[index++] = ASTRONODE_TRANSPORT_STX;
 
     uint16_t crc = calculate_crc((const uint8_t *)&p_source_message->op_code, 1, 0xFFFF);
@@ -91,20 +131,24 @@ static uint16_t astronode_create_request_transport(astronode_app_msg_t *p_source
 
     p_destination_buffer[index++] = ASTRONODE_TRANSPORT_ETX;
 
+    ASTRONODE_PROFILE_STOP(CREATE_REQUEST);
+
     return index;
 }
 
-static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffer, uint16_t length_buffer, astronode_app_msg_t *p_destination_message)
+static return_status_t astronode_decode_answer_transport(astronode_ctx_t *p_ctx, uint8_t *p_source_buffer, uint16_t length_buffer, astronode_app_msg_t *p_destination_message)
 {
     if (p_source_buffer[0] != ASTRONODE_TRANSPORT_STX)
     {
         send_debug_logs("ERROR : Message received from the Astronode does not start with STX character.");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_MISSING_STX);
         return RS_FAILURE;
     }
 
     if (length_buffer % 2 == 1 || length_buffer < 8) // 8: STX, ETX, 2 x opcode, 4 x CRC
     {
         send_debug_logs("ERROR : Message received from the Astronode is missing at least one character.");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_ODD_LENGTH);
         return RS_FAILURE;
     }
 
@@ -113,6 +157,7 @@ static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffe
     if (p_source_buffer[length_buffer - 1] != ASTRONODE_TRANSPORT_ETX)
     {
         send_debug_logs("ERROR : Message received from the Astronode does not end with ETX character.");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_MISSING_ETX);
         return RS_FAILURE;
     }
 
@@ -124,6 +169,7 @@ static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffe
         || ascii_to_value(p_source_buffer[2], &nibble_low) == false)
     {
         send_debug_logs("ERROR : Message received from the Astronode contains a non-ASCII character.");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_BAD_HEX);
         return RS_FAILURE;
     }
 
@@ -136,6 +182,7 @@ static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffe
             || ascii_to_value(p_source_buffer[i + 1], &nibble_low) == false)
         {
             send_debug_logs("ERROR : Message received from the Astronode contains a non-ASCII character.");
+            astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_BAD_HEX);
             return RS_FAILURE;
         }
 
@@ -152,6 +199,7 @@ static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffe
         || ascii_to_value(p_source_buffer[length_buffer - 4], &nibble_low) == false)
     {
         send_debug_logs("ERROR : Message received from the Astronode contains a non-ASCII character.");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_BAD_HEX);
         return RS_FAILURE;
     }
 
@@ -161,6 +209,7 @@ static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffe
         || ascii_to_value(p_source_buffer[length_buffer - 2], &nibble_low) == false)
     {
         send_debug_logs("ERROR : Message received from the Astronode contains a non-ASCII character.");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_BAD_HEX);
         return RS_FAILURE;
     }
 
@@ -169,53 +218,166 @@ static return_status_t astronode_decode_answer_transport(uint8_t *p_source_buffe
     if (crc_received != crc_calculated)
     {
         send_debug_logs("ERROR : CRC sent by the Astronode does not match the expected CRC");
+        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_CRC_MISMATCH);
         return RS_FAILURE;
     }
 
     if (p_destination_message->op_code == ASTRONODE_OP_CODE_ERROR)
     {
-        check_for_error(p_destination_message);
+        check_for_error(p_ctx, p_destination_message);
     }
 
     return RS_SUCCESS;
 }
 
-return_status_t astronode_transport_send_receive(astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer)
+uint16_t astronode_get_last_error_code(const astronode_ctx_t *p_ctx)
 {
-    uint8_t request_transport[ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES] = {0};
-    uint8_t answer_transport[ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES] = {0};
-    uint16_t answer_length =  0;
+    return p_ctx->last_error_code;
+}
+
+uint16_t astronode_transport_calculate_crc(const uint8_t *p_data, uint16_t data_len)
+{
+    return calculate_crc(p_data, data_len, 0xFFFF);
+}
 
-    uint16_t request_length = astronode_create_request_transport(p_request, request_transport);
+uint16_t astronode_transport_get_answer_timeout(const astronode_ctx_t *p_ctx, uint8_t op_code)
+{
+    op_code_descriptor_t descriptor = get_descriptor(op_code);
 
-    send_astronode_request(request_transport, request_length);
+    return compute_answer_timeout(p_ctx, &descriptor, ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES);
+}
 
-    if(receive_astronode_answer(answer_transport, &answer_length) == RS_SUCCESS)
+uint32_t astronode_transport_get_round_trip_count(const astronode_ctx_t *p_ctx)
+{
+    return p_ctx->round_trip_count;
+}
+
+return_status_t astronode_transport_send_receive(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer)
+{
+    astronode_trace_status_t answer_status = ASTRONODE_TRACE_STATUS_TIMEOUT;
+    return_status_t status = RS_FAILURE;
+
+    if (astronode_retry_check_circuit(p_ctx) != RS_SUCCESS)
     {
-        return astronode_decode_answer_transport(answer_transport, answer_length, p_answer);
+        p_ctx->last_error_code = 0;
+        send_debug_logs("ERROR : Circuit open, request not sent to the Astronode.");
+        return RS_FAILURE;
     }
-    else
+
+    for (uint8_t attempt = 0; ; attempt++)
     {
-        return RS_FAILURE;
+        status = send_receive_once(p_ctx, p_request, p_answer, &answer_status);
+        astronode_retry_update_circuit(p_ctx, answer_status);
+
+        switch (astronode_retry_decide(p_ctx, p_request->op_code, attempt, answer_status, p_ctx->last_error_code))
+        {
+            case ASTRONODE_RETRY_DECISION_RETRY:
+                // The core sleeps through the backoff.
+                wait_in_sleep_mode(astronode_retry_get_backoff_ms(p_ctx, attempt));
+                break;
+
+            case ASTRONODE_RETRY_DECISION_RECOVERED:
+                // The answer of the lost attempt: the payload ID of PLD_EA, nothing otherwise.
+                p_answer->op_code = p_request->op_code | 0x80;
+                p_answer->payload_len = p_request->op_code == ASTRONODE_OP_CODE_PLD_ER ? 2 : 0;
+                p_answer->p_payload[0] = p_request->p_payload[0];
+                p_answer->p_payload[1] = p_request->p_payload[1];
+                p_ctx->last_error_code = 0;
+                return status;
+
+            default:
+                return status;
+        }
     }
 }
 
+static return_status_t send_receive_once(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer, astronode_trace_status_t *p_answer_status)
+{
+    uint16_t answer_length =  0;
+    uint32_t latency_ms = 0;
+    op_code_descriptor_t descriptor = get_descriptor(p_request->op_code);
+    return_status_t status = RS_FAILURE;
+
+    ASTRONODE_PROFILE_START(SEND_RECEIVE);
+    mark_phase(p_ctx, p_request->op_code, ASTRONODE_TRANSPORT_PHASE_ENCODE, RS_SUCCESS);
+
+    p_ctx->last_error_code = 0;
+    p_ctx->round_trip_count++;
+
+    uint16_t request_length = astronode_create_request_transport(p_request, p_ctx->pool.p_request_frame);
+    p_ctx->pool.p_request_frame[request_length] = '\0';
+    descriptor.timeout_ms = compute_answer_timeout(p_ctx, &descriptor, request_length);
+
+    mark_phase(p_ctx, p_request->op_code, ASTRONODE_TRANSPORT_PHASE_TX, RS_SUCCESS);
+    p_ctx->p_uart_ops->send_request(p_ctx->p_port, p_ctx->pool.p_request_frame, request_length);
+    astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_TX_BYTES, request_length);
+    mark_phase(p_ctx, p_request->op_code, ASTRONODE_TRANSPORT_PHASE_WAIT, RS_SUCCESS);
+    astronode_trace_record(ASTRONODE_TRACE_DIRECTION_TX,
+                           p_request->op_code,
+                           ASTRONODE_TRACE_STATUS_SENT,
+                           0,
+                           p_ctx->pool.p_request_frame,
+                           request_length);
+
+    // The answer functions return early on errors, they are profiled from here.
+    ASTRONODE_PROFILE_START(RECEIVE_ANSWER);
+    status = receive_astronode_answer(p_ctx, p_ctx->pool.p_answer_frame, &answer_length, &descriptor, &latency_ms);
+    ASTRONODE_PROFILE_STOP(RECEIVE_ANSWER);
+
+    if (status == RS_SUCCESS)
+    {
+        mark_phase(p_ctx, p_request->op_code, ASTRONODE_TRANSPORT_PHASE_DECODE, RS_SUCCESS);
+        ASTRONODE_PROFILE_START(DECODE_ANSWER);
+        status = astronode_decode_answer_transport(p_ctx, p_ctx->pool.p_answer_frame, answer_length, p_answer);
+        ASTRONODE_PROFILE_STOP(DECODE_ANSWER);
+    }
+
+    astronode_trace_status_t answer_status = astronode_trace_get_answer_status(status, p_answer->op_code, answer_length);
+
+    *p_answer_status = answer_status;
+    update_latency_estimate(p_ctx, &descriptor, answer_status, latency_ms);
+    astronode_trace_record(ASTRONODE_TRACE_DIRECTION_RX,
+                           p_request->op_code,
+                           answer_status,
+                           p_ctx->last_error_code,
+                           p_ctx->pool.p_answer_frame,
+                           answer_length);
+    astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_RX_BYTES, answer_length);
+    astronode_pool_record_frames(p_ctx, request_length, answer_length);
+    astronode_metrics_count_transaction(p_ctx, p_request->op_code,
+                                        status == RS_SUCCESS ? ASTRONODE_METRICS_OUTCOME_SUCCESS
+                                        : answer_status == ASTRONODE_TRACE_STATUS_TIMEOUT ? ASTRONODE_METRICS_OUTCOME_TIMEOUT
+                                        : ASTRONODE_METRICS_OUTCOME_FAILURE);
+    mark_phase(p_ctx, p_request->op_code, ASTRONODE_TRANSPORT_PHASE_END, status);
+    ASTRONODE_PROFILE_STOP(SEND_RECEIVE);
+
+    return status;
+}
+
 static uint16_t calculate_crc(const uint8_t *p_data, uint16_t data_len, uint16_t init_value)
 {
     uint16_t crc = init_value;
 
+    ASTRONODE_PROFILE_START(CALCULATE_CRC);
+
     while (data_len--)
     {
         uint16_t x = crc >> 8 ^ *p_data++;
         x ^= x >> 4;
         crc = (crc << 8) ^ (x << 12) ^ (x << 5) ^ (x);
     }
+
+    ASTRONODE_PROFILE_STOP(CALCULATE_CRC);
+
     return crc;
 }
 
-static void check_for_error(astronode_app_msg_t *p_answer)
+static void check_for_error(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_answer)
 {
-    uint16_t error_code = p_answer->p_payload[0] + (p_answer->p_payload[1] << 8);
+    uint16_t error_code = (uint8_t) p_answer->p_payload[0] + ((uint8_t) p_answer->p_payload[1] << 8);
+
+    p_ctx->last_error_code = error_code;
+    astronode_metrics_count_error_code(p_ctx, error_code);
 
     switch (error_code)
     {
@@ -269,42 +431,185 @@ static void check_for_error(astronode_app_msg_t *p_answer)
     }
 }
 
-static return_status_t receive_astronode_answer(uint8_t *p_rx_buffer, uint16_t *p_buffer_length)
+static uint16_t compute_answer_timeout(const astronode_ctx_t *p_ctx, const op_code_descriptor_t *p_descriptor, uint16_t request_length)
+{
+    if (p_descriptor->latency_index == 0 || p_ctx->p_latency_estimates[p_descriptor->latency_index - 1].is_learned == false)
+    {
+        return p_descriptor->timeout_ms;
+    }
+
+    const astronode_latency_estimate_t *p_estimate = &p_ctx->p_latency_estimates[p_descriptor->latency_index - 1];
+    uint32_t wire_bytes = ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * p_descriptor->answer_max_len;
+
+    // An error answer can be longer than the expected answer.
+    if (wire_bytes < ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * ASTRONODE_ERROR_PAYLOAD_LEN_BYTES)
+    {
+        wire_bytes = ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * ASTRONODE_ERROR_PAYLOAD_LEN_BYTES;
+    }
+
+    // The request is on the wire as well when send_request() returns before its last byte.
+    wire_bytes += request_length;
+
+    uint32_t timeout_ms = (wire_bytes * ASTRONODE_TRANSPORT_CHARACTER_BITS * 1000 + ASTRONODE_TRANSPORT_BAUD_RATE - 1) / ASTRONODE_TRANSPORT_BAUD_RATE
+                          + (p_estimate->smoothed + 4 * (uint32_t) p_estimate->deviation + 7) / 8
+                          + ASTRONODE_TRANSPORT_TIMEOUT_GUARD_MS;
+
+    if (timeout_ms < ASTRONODE_TRANSPORT_TIMEOUT_FLOOR_MS)
+    {
+        timeout_ms = ASTRONODE_TRANSPORT_TIMEOUT_FLOOR_MS;
+    }
+    if (timeout_ms > p_descriptor->timeout_ms)
+    {
+        timeout_ms = p_descriptor->timeout_ms;
+    }
+
+    return (uint16_t) timeout_ms;
+}
+
+static op_code_descriptor_t get_descriptor(uint8_t op_code)
+{
+    op_code_descriptor_t descriptor = g_op_code_descriptors[op_code & 0x7F];
+
+    if (descriptor.answer_op_code == 0)
+    {
+        descriptor.answer_op_code = op_code | 0x80;
+        descriptor.answer_min_len = 0;
+        descriptor.answer_max_len = (ASTRONODE_MAX_LENGTH_RESPONSE - ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES) / 2;
+        descriptor.timeout_ms = ASTRONODE_ANSWER_TIMEOUT_MS;
+    }
+
+    return descriptor;
+}
+
+static void mark_phase(astronode_ctx_t *p_ctx, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status)
+{
+    if (p_ctx->phase_hook != NULL)
+    {
+        p_ctx->phase_hook(p_ctx->p_phase_hook_user, op_code, phase, status);
+    }
+}
+
+static return_status_t receive_astronode_answer(astronode_ctx_t *p_ctx, uint8_t *p_rx_buffer, uint16_t *p_buffer_length, const op_code_descriptor_t *p_descriptor, uint32_t *p_latency_ms)
 {
     uint8_t rx_char = 0;
     uint16_t length = 0;
+    uint16_t min_length = 0;
+    uint16_t max_length = ASTRONODE_MAX_LENGTH_RESPONSE;
     uint32_t timeout_answer_received = get_systick();
+    uint32_t last_character_time = 0;
+    bool is_answer_started = false;
     bool is_answer_received = false;
 
     while (is_answer_received == false)
     {
-        if (is_systick_timeout_over(timeout_answer_received, ASTRONODE_ANSWER_TIMEOUT_MS))
+        if (length > 0 && is_systick_timeout_over(last_character_time, ASTRONODE_TRANSPORT_INTER_BYTE_TIMEOUT_MS))
+        {
+            send_debug_logs("ERROR : Message received from the Astronode is truncated.");
+            astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_TRUNCATED);
+            return RS_FAILURE;
+        }
+        if (is_systick_timeout_over(timeout_answer_received, p_descriptor->timeout_ms))
         {
             send_debug_logs("ERROR : Received answer timeout..");
+            astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_TIMEOUT);
             return RS_FAILURE;
         }
-        if (is_astronode_character_received(&rx_char))
+        if (p_ctx->p_uart_ops->is_character_received(p_ctx->p_port, &rx_char))
         {
+            last_character_time = get_systick();
+
             if (rx_char == ASTRONODE_TRANSPORT_STX)
             {
-                is_answer_received = false;
+                if (is_answer_started == false)
+                {
+                    is_answer_started = true;
+                    *p_latency_ms = last_character_time - timeout_answer_received;
+                    mark_phase(p_ctx, p_descriptor->answer_op_code & 0x7F, ASTRONODE_TRANSPORT_PHASE_RX, RS_SUCCESS);
+                }
+                else if (length > 0)
+                {
+                    // A new answer begins: the bytes of the previous one are discarded.
+                    astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_NOISE_BYTES, length);
+                }
+
                 length = 0;
+                min_length = 0;
+                max_length = ASTRONODE_MAX_LENGTH_RESPONSE;
+            }
+            else if (length == 0)
+            {
+                // Resynchronization: the bytes before STX are discarded.
+                astronode_metrics_add(p_ctx, ASTRONODE_METRICS_COUNTER_NOISE_BYTES, 1);
+
+                if (rx_char == ASTRONODE_TRANSPORT_ETX)
+                {
+                    // End of an answer whose STX was lost, kept to show that the Astronode answered.
+                    send_debug_logs("ERROR : Message received from the Astronode does not start with STX.");
+                    astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_MISSING_STX);
+                    p_rx_buffer[0] = rx_char;
+                    *p_buffer_length = 1;
+                    return RS_FAILURE;
+                }
+                continue;
             }
 
             p_rx_buffer[length] = rx_char;
             length++;
+            *p_buffer_length = length;
 
-            if (length > ASTRONODE_MAX_LENGTH_RESPONSE)
+            if (length > max_length)
             {
                 send_debug_logs("ERROR : Message received from the Astronode exceed maximum length allowed.");
+                astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_OVERLENGTH);
                 return RS_FAILURE;
             }
 
+            // The op code tells the expected length: reject a wrong answer without waiting for its end.
+            if (length == 3 && p_rx_buffer[0] == ASTRONODE_TRANSPORT_STX)
+            {
+                uint8_t nibble_high = 0;
+                uint8_t nibble_low = 0;
+
+                if (ascii_to_value(p_rx_buffer[1], &nibble_high) == false
+                    || ascii_to_value(p_rx_buffer[2], &nibble_low) == false)
+                {
+                    send_debug_logs("ERROR : Message received from the Astronode contains a non-ASCII character.");
+                    astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_BAD_HEX);
+                    return RS_FAILURE;
+                }
+
+                uint8_t op_code = (nibble_high << 4) + nibble_low;
+
+                if (op_code == ASTRONODE_OP_CODE_ERROR)
+                {
+                    min_length = ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * ASTRONODE_ERROR_PAYLOAD_LEN_BYTES;
+                    max_length = min_length;
+                }
+                else if (op_code == p_descriptor->answer_op_code)
+                {
+                    min_length = ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * p_descriptor->answer_min_len;
+                    max_length = ASTRONODE_TRANSPORT_FRAME_OVERHEAD_LEN_BYTES + 2 * p_descriptor->answer_max_len;
+                }
+                else
+                {
+                    send_debug_logs("ERROR : Message received from the Astronode does not answer the request.");
+                    astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_UNEXPECTED_OP_CODE);
+                    return RS_FAILURE;
+                }
+            }
+
             if (rx_char == ASTRONODE_TRANSPORT_ETX)
             {
                 if (length > 1)
                 {
+                    if (length < min_length)
+                    {
+                        send_debug_logs("ERROR : Message received from the Astronode is shorter than the minimum length allowed.");
+                        astronode_metrics_count_failure(p_ctx, ASTRONODE_METRICS_FAILURE_UNDERLENGTH);
+                        return RS_FAILURE;
+                    }
                     *p_buffer_length = length;
+                    p_rx_buffer[length] = '\0';
                     is_answer_received = true;
                 }
             }
@@ -322,3 +627,41 @@ static void uint8_to_ascii_buffer(const uint8_t value, uint8_t *p_target_buffer)
     p_target_buffer[0] = g_ascii_lookup[value >> 4];
     p_target_buffer[1] = g_ascii_lookup[value & 0x0F];
 }
+
+static void update_latency_estimate(astronode_ctx_t *p_ctx, const op_code_descriptor_t *p_descriptor, astronode_trace_status_t answer_status, uint32_t latency_ms)
+{
+    if (p_descriptor->latency_index == 0)
+    {
+        return;
+    }
+
+    astronode_latency_estimate_t *p_estimate = &p_ctx->p_latency_estimates[p_descriptor->latency_index - 1];
+
+    if (answer_status == ASTRONODE_TRACE_STATUS_TIMEOUT)
+    {
+        // The Astronode may be slower than learned: the next request waits the full timeout.
+        p_estimate->is_learned = false;
+        return;
+    }
+    if (answer_status == ASTRONODE_TRACE_STATUS_INVALID)
+    {
+        return;
+    }
+
+    // Same estimator as the TCP retransmission timeout (RFC 6298), in 1/8 ms.
+    uint32_t sample = (latency_ms < ASTRONODE_ANSWER_TIMEOUT_MS ? latency_ms : ASTRONODE_ANSWER_TIMEOUT_MS) * 8;
+
+    if (p_estimate->is_learned == false)
+    {
+        p_estimate->smoothed = (uint16_t) sample;
+        p_estimate->deviation = (uint16_t) (sample / 2);
+        p_estimate->is_learned = true;
+    }
+    else
+    {
+        uint32_t difference = sample > p_estimate->smoothed ? sample - p_estimate->smoothed : p_estimate->smoothed - sample;
+
+        p_estimate->deviation = (uint16_t) ((3 * (uint32_t) p_estimate->deviation + difference) / 4);
+        p_estimate->smoothed = (uint16_t) ((7 * (uint32_t) p_estimate->smoothed + sample) / 8);
+    }
+}
@@ -12,22 +12,65 @@
 
 
 //------------------------------------------------------------------------------
-// Type definitions
+// Definitions
 //------------------------------------------------------------------------------
-typedef enum return_status_t
-{
-    RS_FAILURE,
-    RS_SUCCESS
-} return_status_t;
+// The answer timeout of a request is the time to receive its longest answer at the baud
+// rate, plus its first byte latency learned online (smoothed + 4 x deviation) and a guard,
+// bounded by the floor and by the timeout of the specification. Until the latency of a
+// request is learned, or after a timeout, the timeout of the specification is used.
+#ifndef ASTRONODE_TRANSPORT_BAUD_RATE
+#define ASTRONODE_TRANSPORT_BAUD_RATE               9600
+#endif
+#ifndef ASTRONODE_TRANSPORT_TIMEOUT_GUARD_MS
+#define ASTRONODE_TRANSPORT_TIMEOUT_GUARD_MS        10
+#endif
+#ifndef ASTRONODE_TRANSPORT_TIMEOUT_FLOOR_MS
+#define ASTRONODE_TRANSPORT_TIMEOUT_FLOOR_MS        20
+#endif
+
+// Bits per character on the wire: start, 8 data, stop.
+#define ASTRONODE_TRANSPORT_CHARACTER_BITS          10
+
+// Once an answer has begun, a silence longer than this many characters ends it as
+// truncated. The extra ms covers the resolution of the systick. Raise it when the UART
+// delivers the bytes in bursts, like USB adapters with a latency timer.
+#ifndef ASTRONODE_TRANSPORT_INTER_BYTE_TIMEOUT_CHARACTERS
+#define ASTRONODE_TRANSPORT_INTER_BYTE_TIMEOUT_CHARACTERS   4
+#endif
+#ifndef ASTRONODE_TRANSPORT_INTER_BYTE_TIMEOUT_MS
+#define ASTRONODE_TRANSPORT_INTER_BYTE_TIMEOUT_MS \
+    ((ASTRONODE_TRANSPORT_INTER_BYTE_TIMEOUT_CHARACTERS * ASTRONODE_TRANSPORT_CHARACTER_BITS * 1000 \
+      + ASTRONODE_TRANSPORT_BAUD_RATE - 1) / ASTRONODE_TRANSPORT_BAUD_RATE + 1)
+#endif
 
 
 //------------------------------------------------------------------------------
 // Function declarations
 //------------------------------------------------------------------------------
+/**
+ * @brief Return the CRC-16 used by the transport layer (CCITT, initial value 0xFFFF).
+ */
+uint16_t astronode_transport_calculate_crc(const uint8_t *p_data, uint16_t data_len);
+
+/**
+ * @brief Return the number of requests sent to this Astronode since the start.
+ */
+uint32_t astronode_transport_get_round_trip_count(const astronode_ctx_t *p_ctx);
+
+/**
+ * @brief Return the answer timeout of the next request with this op code, without payload.
+ */
+uint16_t astronode_transport_get_answer_timeout(const astronode_ctx_t *p_ctx, uint8_t op_code);
+
 /**
  * @brief Send the message to the Asset Interface and return the response.
  */
-return_status_t astronode_transport_send_receive(astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer);
+return_status_t astronode_transport_send_receive(astronode_ctx_t *p_ctx, astronode_app_msg_t *p_request, astronode_app_msg_t *p_answer);
+
+/**
+ * @brief Return the error code of the last answer, 0 if it was not an error.
+ */
+uint16_t astronode_get_last_error_code(const astronode_ctx_t *p_ctx);
 
 
 #endif /* ASTRONODE_TRANSPORT_H */
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_payload_policy.h"
+#include "astronode_uplink_queue.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define UPLINK_QUEUE_INDEX_NONE 0xFF
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct uplink_queue_entry_t
+{
+    uint8_t     next;
+    uint16_t    payload_length;
+    char        p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+} uplink_queue_entry_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// One FIFO per priority, chained through the entries of a static pool.
+static uplink_queue_entry_t g_pool[ASTRONODE_UPLINK_QUEUE_POOL_SIZE];
+static uint8_t g_heads[ASTRONODE_UPLINK_PRIORITY_COUNT];
+static uint8_t g_tails[ASTRONODE_UPLINK_PRIORITY_COUNT];
+static uint8_t g_free_head = UPLINK_QUEUE_INDEX_NONE;
+static uint8_t g_count = 0;
+// Bit n set when the FIFO of priority n is not empty.
+static uint8_t g_non_empty_mask = 0;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint8_t get_highest_priority(void);
+static void release_entry(uint8_t index);
+static uint8_t remove_head(uint8_t priority);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+static uint8_t get_highest_priority(void)
+{
+    // Index of the lowest bit set, the mask is never empty here.
+    return __builtin_ctz(g_non_empty_mask);
+}
+
+static void release_entry(uint8_t index)
+{
+    g_pool[index].next = g_free_head;
+    g_free_head = index;
+}
+
+static uint8_t remove_head(uint8_t priority)
+{
+    uint8_t index = g_heads[priority];
+
+    g_heads[priority] = g_pool[index].next;
+    if (g_heads[priority] == UPLINK_QUEUE_INDEX_NONE)
+    {
+        g_tails[priority] = UPLINK_QUEUE_INDEX_NONE;
+        g_non_empty_mask &= ~(1 << priority);
+    }
+    g_count--;
+
+    return index;
+}
+
+void astronode_uplink_queue_init(void)
+{
+    for (uint8_t i = 0; i < ASTRONODE_UPLINK_PRIORITY_COUNT; i++)
+    {
+        g_heads[i] = UPLINK_QUEUE_INDEX_NONE;
+        g_tails[i] = UPLINK_QUEUE_INDEX_NONE;
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_UPLINK_QUEUE_POOL_SIZE; i++)
+    {
+        g_pool[i].next = (i + 1 < ASTRONODE_UPLINK_QUEUE_POOL_SIZE) ? i + 1 : UPLINK_QUEUE_INDEX_NONE;
+    }
+
+    g_free_head = 0;
+    g_count = 0;
+    g_non_empty_mask = 0;
+}
+
+return_status_t astronode_uplink_queue_push(astronode_uplink_priority_t priority, const char *p_payload, uint16_t payload_length)
+{
+    if (priority >= ASTRONODE_UPLINK_PRIORITY_COUNT || payload_length > ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES)
+    {
+        return RS_FAILURE;
+    }
+
+    if (g_free_head == UPLINK_QUEUE_INDEX_NONE)
+    {
+        // Pool exhausted, discard the oldest payload of the lowest priority if it is below this one.
+        uint8_t lowest_priority = 31 - __builtin_clz(g_non_empty_mask);
+
+        if (lowest_priority <= priority)
+        {
+            send_debug_logs("Uplink queue is full, payload rejected.");
+            return RS_FAILURE;
+        }
+
+        release_entry(remove_head(lowest_priority));
+        send_debug_logs("Uplink queue is full, lower priority payload discarded.");
+    }
+
+    uint8_t index = g_free_head;
+    g_free_head = g_pool[index].next;
+
+    g_pool[index].next = UPLINK_QUEUE_INDEX_NONE;
+    g_pool[index].payload_length = payload_length;
+    memcpy(g_pool[index].p_payload, p_payload, payload_length);
+
+    if (g_tails[priority] == UPLINK_QUEUE_INDEX_NONE)
+    {
+        g_heads[priority] = index;
+    }
+    else
+    {
+        g_pool[g_tails[priority]].next = index;
+    }
+    g_tails[priority] = index;
+    g_non_empty_mask |= 1 << priority;
+    g_count++;
+
+    return RS_SUCCESS;
+}
+
+return_status_t astronode_uplink_queue_pop(astronode_uplink_priority_t *p_priority, char *p_payload, uint16_t *p_payload_length)
+{
+    if (g_count == 0)
+    {
+        return RS_FAILURE;
+    }
+
+    uint8_t priority = get_highest_priority();
+    uint8_t index = remove_head(priority);
+
+    *p_priority = priority;
+    *p_payload_length = g_pool[index].payload_length;
+    memcpy(p_payload, g_pool[index].p_payload, g_pool[index].payload_length);
+
+    release_entry(index);
+
+    return RS_SUCCESS;
+}
+
+uint8_t astronode_uplink_queue_get_count(void)
+{
+    return g_count;
+}
+
+void astronode_uplink_queue_service(void)
+{
+    while (g_count > 0)
+    {
+        uint8_t priority = get_highest_priority();
+        uplink_queue_entry_t *p_entry = &g_pool[g_heads[priority]];
+
+        if (astronode_payload_policy_enqueue(priority, p_entry->p_payload, p_entry->payload_length) != RS_SUCCESS)
+        {
+            if (astronode_payload_policy_get_queue_count() < ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH
+                || astronode_payload_policy_preempt(priority) != RS_SUCCESS
+                || astronode_payload_policy_enqueue(priority, p_entry->p_payload, p_entry->payload_length) != RS_SUCCESS)
+            {
+                // Retry at the next service.
+                return;
+            }
+        }
+
+        release_entry(remove_head(priority));
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef ASTRONODE_UPLINK_QUEUE_H
+#define ASTRONODE_UPLINK_QUEUE_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Number of payloads the asset can hold while waiting for room in the Astronode queue.
+#ifndef ASTRONODE_UPLINK_QUEUE_POOL_SIZE
+#define ASTRONODE_UPLINK_QUEUE_POOL_SIZE 8
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// The priority is also used as payload policy class when the payload is enqueued.
+typedef enum astronode_uplink_priority_t
+{
+    ASTRONODE_UPLINK_PRIORITY_ALARM,
+    ASTRONODE_UPLINK_PRIORITY_EVENT,
+    ASTRONODE_UPLINK_PRIORITY_PERIODIC,
+    ASTRONODE_UPLINK_PRIORITY_COUNT
+} astronode_uplink_priority_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Empty the queue and rebuild the free list of the pool.
+ */
+void astronode_uplink_queue_init(void);
+
+/**
+ * @brief Copy a payload in the queue. If the pool is full, the oldest payload of a lower
+ * priority is discarded to make room, otherwise the new payload is rejected.
+ */
+return_status_t astronode_uplink_queue_push(astronode_uplink_priority_t priority, const char *p_payload, uint16_t payload_length);
+
+/**
+ * @brief Copy out the oldest payload of the highest priority and remove it from the queue.
+ */
+return_status_t astronode_uplink_queue_pop(astronode_uplink_priority_t *p_priority, char *p_payload, uint16_t *p_payload_length);
+
+/**
+ * @brief Return the number of payloads waiting in the queue.
+ */
+uint8_t astronode_uplink_queue_get_count(void);
+
+/**
+ * @brief Move payloads to the Astronode queue, highest priority first. When the Astronode
+ * queue is full, a payload of lower priority is dequeued (PLD_DR) to make room.
+ */
+void astronode_uplink_queue_service(void);
+
+
+#endif /* ASTRONODE_UPLINK_QUEUE_H */
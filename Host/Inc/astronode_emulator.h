@@ -0,0 +1,174 @@
+#ifndef ASTRONODE_EMULATOR_H
+#define ASTRONODE_EMULATOR_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_context.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Payloads held by the emulated module, like the Astronode S.
+#ifndef ASTRONODE_EMULATOR_QUEUE_SIZE
+#define ASTRONODE_EMULATOR_QUEUE_SIZE   8
+#endif
+
+#ifndef ASTRONODE_EMULATOR_COMMAND_QUEUE_SIZE
+#define ASTRONODE_EMULATOR_COMMAND_QUEUE_SIZE 4
+#endif
+
+// Seconds between the Unix epoch and the Astrocast epoch (2018-01-01 00:00:00 UTC).
+#define ASTRONODE_EMULATOR_ASTROCAST_EPOCH  1514764800
+
+#define ASTRONODE_EMULATOR_BITS_PER_BYTE    10 // 8N1
+
+// Performance counters returned by PER_RR, IDs 0x01 to 0x0E.
+#define ASTRONODE_EMULATOR_COUNTER_COUNT    14
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct astronode_emulator_config_t
+{
+    // Serial link: bytes are paced at baud_rate (0 to disable) and each answer starts
+    // latency_ms after the end of its request.
+    uint32_t    baud_rate;
+    uint32_t    latency_ms;
+    // Faults injected in the answers, in per mille: CRC corrupted, byte dropped.
+    uint16_t    crc_error_per_mille;
+    uint16_t    drop_per_mille;
+    uint32_t    seed;
+    // Satellite: one pass of pass_duration_ms every pass_period_ms (0 for a continuous
+    // coverage), one queued payload sent and acknowledged every ack_delay_ms in a pass.
+    uint32_t    pass_period_ms;
+    uint32_t    pass_duration_ms;
+    uint32_t    ack_delay_ms;
+    // Time of the Astrocast epoch on the clock given as now_ms.
+    int64_t     epoch_offset_ms;
+} astronode_emulator_config_t;
+
+typedef struct astronode_emulator_payload_t
+{
+    uint16_t    id;
+    uint8_t     length;
+    uint8_t     p_data[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+} astronode_emulator_payload_t;
+
+/**
+ * @brief Called with each payload delivered to the satellite, as the backend receives it.
+ */
+typedef void (*astronode_emulator_uplink_t)(void *p_user, uint16_t payload_id, const uint8_t *p_data, uint8_t length);
+
+typedef struct astronode_emulator_command_t
+{
+    uint32_t    created_date;
+    uint8_t     p_data[ASTRONODE_APP_COMMAND_MAX_LEN_BYTES];
+    uint8_t     length;
+} astronode_emulator_command_t;
+
+typedef struct astronode_emulator_t
+{
+    astronode_emulator_config_t     config;
+    uint32_t                        random_state;
+    uint32_t                        boot_time_ms;
+    uint32_t                        now_ms;
+
+    // Frame being received
+    uint8_t                         p_request[ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES];
+    uint16_t                        request_length;
+    bool                            is_request_started;
+
+    // Configuration (CFG_WR layout), the one saved with CFG_SR, and the EVT_RA register
+    uint8_t                         p_config[3];
+    uint8_t                         p_saved_config[3];
+    uint8_t                         events;
+
+    astronode_emulator_payload_t    p_queue[ASTRONODE_EMULATOR_QUEUE_SIZE];
+    uint8_t                         queue_count;
+    uint16_t                        p_acks[ASTRONODE_EMULATOR_QUEUE_SIZE];
+    uint8_t                         ack_count;
+    uint32_t                        last_ack_time_ms;
+    bool                            is_in_pass;
+
+    astronode_emulator_command_t    p_commands[ASTRONODE_EMULATOR_COMMAND_QUEUE_SIZE];
+    uint8_t                         command_count;
+
+    int32_t                         latitude;
+    int32_t                         longitude;
+    uint8_t                         gpo;
+
+    // Performance counters (PER_RR), last contact (LCD_RR)
+    uint32_t                        p_counters[ASTRONODE_EMULATOR_COUNTER_COUNT];
+    uint32_t                        start_of_last_pass;
+    uint32_t                        end_of_last_pass;
+
+    astronode_emulator_uplink_t     uplink;
+    void                           *p_uplink_user;
+} astronode_emulator_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Power up the emulated module at now_ms: default configuration, empty queues
+ * and the reset event raised.
+ */
+void astronode_emulator_init(astronode_emulator_t *p_emulator, const astronode_emulator_config_t *p_config, uint32_t now_ms);
+
+/**
+ * @brief Register the function receiving the payloads delivered to the satellite, NULL to
+ * stop. It is kept across resets.
+ */
+void astronode_emulator_set_uplink(astronode_emulator_t *p_emulator, astronode_emulator_uplink_t uplink, void *p_user);
+
+/**
+ * @brief Reset the module (RESET pin): the saved configuration is restored, the queues
+ * are emptied and the reset event is raised.
+ */
+void astronode_emulator_reset(astronode_emulator_t *p_emulator, uint32_t now_ms);
+
+/**
+ * @brief Advance the satellite model to now_ms: passes, transmissions and acknowledgments.
+ */
+void astronode_emulator_run(astronode_emulator_t *p_emulator, uint32_t now_ms);
+
+/**
+ * @brief Feed one byte sent by the asset. When it completes a request, the answer frame
+ * (faults not injected) is written in p_answer and its length is returned, 0 otherwise.
+ */
+uint16_t astronode_emulator_receive_byte(astronode_emulator_t *p_emulator, uint8_t byte, uint8_t *p_answer);
+
+/**
+ * @brief Inject the configured faults in an answer frame, return its new length.
+ */
+uint16_t astronode_emulator_inject_faults(astronode_emulator_t *p_emulator, uint8_t *p_answer, uint16_t length);
+
+/**
+ * @brief Return the time needed to transfer length bytes at the configured baud rate.
+ */
+uint32_t astronode_emulator_get_transfer_time_us(const astronode_emulator_t *p_emulator, uint16_t length);
+
+/**
+ * @brief Queue a downlink command of 8 or 40 bytes, as if received from a satellite.
+ */
+return_status_t astronode_emulator_add_command(astronode_emulator_t *p_emulator, const uint8_t *p_data, uint8_t length);
+
+/**
+ * @brief Return the level of the EVT pin: an event enabled in the EVT pin mask is raised.
+ */
+bool astronode_emulator_is_evt_pin_high(const astronode_emulator_t *p_emulator);
+
+
+#endif /* ASTRONODE_EMULATOR_H */
@@ -0,0 +1,58 @@
+#ifndef BENCHMARK_HISTOGRAM_H
+#define BENCHMARK_HISTOGRAM_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdio.h>
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Log-linear buckets like HdrHistogram: values below 32 are exact, above each power of
+// two is split in 16 buckets, so the value of a bucket is within 1/16 (6.25 %).
+#define BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT    32
+#define BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT   16
+#define BENCHMARK_HISTOGRAM_MAX_SHIFT           36 // Values up to 2^41 ns (36 minutes)
+#define BENCHMARK_HISTOGRAM_BUCKET_COUNT        (BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT \
+                                                 + BENCHMARK_HISTOGRAM_MAX_SHIFT * BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT)
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct benchmark_histogram_t
+{
+    uint32_t    p_counts[BENCHMARK_HISTOGRAM_BUCKET_COUNT];
+    uint64_t    count;
+    uint64_t    min;
+    uint64_t    max;
+    uint64_t    sum;
+} benchmark_histogram_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+void benchmark_histogram_reset(benchmark_histogram_t *p_histogram);
+
+void benchmark_histogram_record(benchmark_histogram_t *p_histogram, uint64_t value);
+
+/**
+ * @brief Return the highest value equivalent to the bucket holding the percentile (0 to 100).
+ */
+uint64_t benchmark_histogram_get_percentile(const benchmark_histogram_t *p_histogram, double percentile);
+
+uint64_t benchmark_histogram_get_mean(const benchmark_histogram_t *p_histogram);
+
+/**
+ * @brief Print the percentile distribution in the HdrHistogram text format, values divided by scale.
+ */
+void benchmark_histogram_print_distribution(const benchmark_histogram_t *p_histogram, FILE *p_file, double scale);
+
+
+#endif /* BENCHMARK_HISTOGRAM_H */
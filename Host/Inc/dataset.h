@@ -0,0 +1,58 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define DATASET_MAX_CHANNELS            8
+#define DATASET_NAME_MAX_LEN_BYTES      32
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+/**
+ * @brief Sensor dataset of Host/Data: a time in seconds and one integer value per channel
+ * for each sample, the values of a sample being contiguous.
+ */
+typedef struct dataset_t
+{
+    uint8_t     channel_count;
+    char        p_names[DATASET_MAX_CHANNELS][DATASET_NAME_MAX_LEN_BYTES];
+    uint32_t    sample_count;
+    uint32_t   *p_times;
+    int32_t    *p_values;
+    uint32_t    text_length;
+} dataset_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Read a CSV file: '#' comment lines, a header line naming the time and the
+ * channels, then one line per sample.
+ */
+return_status_t dataset_load(dataset_t *p_dataset, const char *p_path);
+
+void dataset_free(dataset_t *p_dataset);
+
+/**
+ * @brief Return the values of a sample.
+ */
+const int32_t *dataset_get_sample(const dataset_t *p_dataset, uint32_t index);
+
+
+#endif /* DATASET_H */
@@ -0,0 +1,81 @@
+#ifndef DRIVERS_POSIX_H
+#define DRIVERS_POSIX_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Longest wait of is_astronode_character_received() when no byte is buffered, it keeps
+// the answer timeout of the transport accurate without a fixed per-byte timeout.
+#ifndef ASTRONODE_POSIX_CHARACTER_POLL_MS
+#define ASTRONODE_POSIX_CHARACTER_POLL_MS   10
+#endif
+
+#ifndef ASTRONODE_POSIX_RX_BUFFER_LEN_BYTES
+#define ASTRONODE_POSIX_RX_BUFFER_LEN_BYTES 64
+#endif
+
+// Modem lines (TIOCM_*) wired to the EVT and RESET pins of the Astronode, 0 when not wired.
+// Without an EVT line, the pin reads high every ASTRONODE_POSIX_EVT_POLL_PERIOD_MS until
+// the events are read with EVT_RR.
+#ifndef ASTRONODE_POSIX_EVT_MODEM_LINE
+#define ASTRONODE_POSIX_EVT_MODEM_LINE      0
+#endif
+#ifndef ASTRONODE_POSIX_RESET_MODEM_LINE
+#define ASTRONODE_POSIX_RESET_MODEM_LINE    0
+#endif
+#ifndef ASTRONODE_POSIX_EVT_POLL_PERIOD_MS
+#define ASTRONODE_POSIX_EVT_POLL_PERIOD_MS  5000
+#endif
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+/**
+ * @brief Serial port of one Astronode, given as p_port to astronode_ctx_init().
+ */
+typedef struct astronode_posix_port_t
+{
+    int         fd;
+    uint8_t     p_rx_buffer[ASTRONODE_POSIX_RX_BUFFER_LEN_BYTES];
+    uint16_t    rx_length;
+    uint16_t    rx_index;
+    uint32_t    evt_rr_time_ms;
+} astronode_posix_port_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Open p_device (serial port or pty) in raw 9600 8N1 mode with non-blocking reads.
+ */
+return_status_t open_astronode_port(astronode_posix_port_t *p_port, const char *p_device);
+
+void close_astronode_port(astronode_posix_port_t *p_port);
+
+/**
+ * @brief Return the port used by send_astronode_request() and the other drivers.h functions.
+ */
+astronode_posix_port_t *get_default_astronode_port(void);
+
+/**
+ * @brief Enable or disable the debug logs written on the standard error (enabled at start).
+ */
+void set_debug_logs_enabled(bool is_enabled);
+
+
+#endif /* DRIVERS_POSIX_H */
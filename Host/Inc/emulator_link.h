@@ -0,0 +1,54 @@
+#ifndef EMULATOR_LINK_H
+#define EMULATOR_LINK_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdbool.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_emulator.h"
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+/**
+ * @brief Simulated serial link, given as p_port to astronode_ctx_init(): requests are fed
+ * to an emulator in the same process and its answers are read back byte per byte. With a
+ * baud_rate in the emulator configuration, the request takes its transfer time to be sent
+ * and each answer byte arrives latency_ms later at that rate, as over a UART. Otherwise
+ * the answers are available at once. With is_tx_buffered set after emulator_link_init(),
+ * the request returns before its transfer, as written to a kernel or DMA buffer.
+ */
+typedef struct emulator_link_t
+{
+    astronode_emulator_t    emulator;
+    uint8_t                 p_answer[ASTRONODE_MAX_LENGTH_RESPONSE];
+    uint16_t                answer_length;
+    uint16_t                answer_index;
+    uint64_t                answer_start_us;
+    bool                    is_tx_buffered;
+} emulator_link_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+/**
+ * @brief Start the emulator of p_link with p_config.
+ */
+void emulator_link_init(emulator_link_t *p_link, const astronode_emulator_config_t *p_config);
+
+/**
+ * @brief Return the UART operations reaching the emulator of an emulator_link_t.
+ */
+const astronode_uart_ops_t *get_emulator_link_uart_ops(void);
+
+
+#endif /* EMULATOR_LINK_H */
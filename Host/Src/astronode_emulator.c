@@ -0,0 +1,805 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_application.h"
+#include "astronode_emulator.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define EMULATOR_DEVICE_TYPE_ID     3 // Commercial Satellite Astronode
+#define EMULATOR_HW_REVISION        1
+#define EMULATOR_FW_MAJOR_VERSION   2
+#define EMULATOR_FW_MINOR_VERSION   0
+#define EMULATOR_FW_REVISION        0
+
+#define EMULATOR_CONFIG_PAYLOAD_ACK (1 << 0)
+
+#define EMULATOR_GUID               "00000000-0000-0000-0000-000000000000"
+#define EMULATOR_SERIAL_NUMBER      "EMULATOR0001"
+#define EMULATOR_PRODUCT_NUMBER     "EMULATOR"
+
+#define EMULATOR_RESET_REASON_PIN   0x02
+#define EMULATOR_PEAK_RSSI          40
+
+// Indexes of the performance counters, ID - 1.
+#define COUNTER_SAT_DET_PHASE           0
+#define COUNTER_SAT_DET_OPERATIONS      1
+#define COUNTER_SIGNALLING_PHASE        2
+#define COUNTER_SIGNALLING_ATTEMPTS     3
+#define COUNTER_SIGNALLING_SUCCESSES    4
+#define COUNTER_ACK_DEMOD_ATTEMPTS      5
+#define COUNTER_ACK_DEMOD_SUCCESSES     6
+#define COUNTER_QUEUED_MSG              7
+#define COUNTER_DEQUEUED_UNACKED_MSG    8
+#define COUNTER_ACKED_MSG               9
+#define COUNTER_SENT_FRAG               10
+#define COUNTER_ACKED_FRAG              11
+#define COUNTER_COMMAND_ATTEMPTS        12
+#define COUNTER_COMMAND_SUCCESSES       13
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct request_length_t
+{
+    bool        is_supported;
+    uint8_t     min_length;
+    uint8_t     max_length;
+} request_length_t;
+
+typedef struct emulator_message_t
+{
+    uint8_t     op_code;
+    uint8_t     p_payload[ASTRONODE_APP_MSG_MAX_LEN_BYTES];
+    uint16_t    payload_len;
+} emulator_message_t;
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const uint8_t g_ascii_lookup[16] =
+{
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+// Payload length of each request, indexed by the request op code.
+static const request_length_t g_request_lengths[0x80] =
+{
+    [ASTRONODE_OP_CODE_CFG_WR] = { true, 3, 3 },
+    [ASTRONODE_OP_CODE_CFG_SR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_CFG_FR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_CFG_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_CTX_SR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_WIF_WR] = { true, ASTRONODE_WLAN_SSID_MAX_LENGTH + ASTRONODE_WLAN_KEY_MAX_LENGTH + ASTRONODE_AUTH_TOKEN_MAX_LENGTH,
+                                         ASTRONODE_WLAN_SSID_MAX_LENGTH + ASTRONODE_WLAN_KEY_MAX_LENGTH + ASTRONODE_AUTH_TOKEN_MAX_LENGTH },
+    [ASTRONODE_OP_CODE_SSC_WR] = { true, 2, 2 },
+    [ASTRONODE_OP_CODE_MGI_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_MSN_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_MPN_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_NCO_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_RTC_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_EVT_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_GEO_WR] = { true, 8, 8 },
+    [ASTRONODE_OP_CODE_GPI_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_GPO_SR] = { true, 1, 1 },
+    [ASTRONODE_OP_CODE_PLD_ER] = { true, 3, 2 + ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES },
+    [ASTRONODE_OP_CODE_PLD_DR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_PLD_FR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_SAK_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_SAK_CR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_RES_CR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_PER_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_PER_CR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_MST_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_LCD_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_END_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_CMD_RR] = { true, 0, 0 },
+    [ASTRONODE_OP_CODE_CMD_CR] = { true, 0, 0 },
+};
+
+static const uint8_t g_default_config[3] = { EMULATOR_CONFIG_PAYLOAD_ACK, 0x00, ASTRONODE_EVENT_MSG_ACK
+                                                                                | ASTRONODE_EVENT_RESET
+                                                                                | ASTRONODE_EVENT_CMD_AVAILABLE };
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint32_t get_random(astronode_emulator_t *p_emulator);
+static bool is_fault_drawn(astronode_emulator_t *p_emulator, uint16_t per_mille);
+static uint32_t get_astrocast_time(const astronode_emulator_t *p_emulator);
+static uint8_t get_events(const astronode_emulator_t *p_emulator);
+static bool ascii_to_value(uint8_t ascii, uint8_t *p_value);
+static uint16_t calculate_crc(const uint8_t *p_data, uint16_t data_len);
+static uint16_t encode_answer(const emulator_message_t *p_answer, uint8_t *p_buffer);
+static void set_error(emulator_message_t *p_answer, uint16_t error_code);
+static void append_u32(emulator_message_t *p_answer, uint32_t value);
+static void append_tlv(emulator_message_t *p_answer, uint8_t type, uint32_t value, uint8_t size);
+static void append_string(emulator_message_t *p_answer, const char *p_string);
+static bool decode_request(const astronode_emulator_t *p_emulator, emulator_message_t *p_request, uint16_t *p_error_code);
+static void process_request(astronode_emulator_t *p_emulator, const emulator_message_t *p_request, emulator_message_t *p_answer);
+static void process_payload_request(astronode_emulator_t *p_emulator, const emulator_message_t *p_request, emulator_message_t *p_answer);
+static void process_state_request(astronode_emulator_t *p_emulator, const emulator_message_t *p_request, emulator_message_t *p_answer);
+static void update_pass(astronode_emulator_t *p_emulator);
+static void transmit_payload(astronode_emulator_t *p_emulator);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void astronode_emulator_init(astronode_emulator_t *p_emulator, const astronode_emulator_config_t *p_config, uint32_t now_ms)
+{
+    memset(p_emulator, 0, sizeof(astronode_emulator_t));
+    p_emulator->config = *p_config;
+    p_emulator->random_state = p_config->seed != 0 ? p_config->seed : 1;
+    memcpy(p_emulator->p_saved_config, g_default_config, sizeof(g_default_config));
+
+    astronode_emulator_reset(p_emulator, now_ms);
+}
+
+void astronode_emulator_set_uplink(astronode_emulator_t *p_emulator, astronode_emulator_uplink_t uplink, void *p_user)
+{
+    p_emulator->uplink = uplink;
+    p_emulator->p_uplink_user = p_user;
+}
+
+void astronode_emulator_reset(astronode_emulator_t *p_emulator, uint32_t now_ms)
+{
+    p_emulator->boot_time_ms = now_ms;
+    p_emulator->now_ms = now_ms;
+    p_emulator->last_ack_time_ms = now_ms;
+    p_emulator->is_in_pass = false;
+    p_emulator->is_request_started = false;
+    p_emulator->request_length = 0;
+    memcpy(p_emulator->p_config, p_emulator->p_saved_config, sizeof(p_emulator->p_config));
+    p_emulator->queue_count = 0;
+    p_emulator->ack_count = 0;
+    p_emulator->command_count = 0;
+    p_emulator->events = ASTRONODE_EVENT_RESET;
+
+    update_pass(p_emulator);
+}
+
+void astronode_emulator_run(astronode_emulator_t *p_emulator, uint32_t now_ms)
+{
+    p_emulator->now_ms = now_ms;
+    update_pass(p_emulator);
+
+    if (p_emulator->is_in_pass == false || p_emulator->queue_count == 0)
+    {
+        // The acknowledgment delay starts with the pass or with the first queued payload.
+        p_emulator->last_ack_time_ms = now_ms;
+        return;
+    }
+
+    if (now_ms - p_emulator->last_ack_time_ms >= p_emulator->config.ack_delay_ms)
+    {
+        transmit_payload(p_emulator);
+        p_emulator->last_ack_time_ms = now_ms;
+    }
+}
+
+uint16_t astronode_emulator_receive_byte(astronode_emulator_t *p_emulator, uint8_t byte, uint8_t *p_answer)
+{
+    if (byte == ASTRONODE_TRANSPORT_STX)
+    {
+        p_emulator->is_request_started = true;
+        p_emulator->request_length = 0;
+    }
+
+    if (p_emulator->is_request_started == false)
+    {
+        return 0;
+    }
+
+    if (p_emulator->request_length >= sizeof(p_emulator->p_request))
+    {
+        // Too long for any request: wait for the next STX.
+        p_emulator->is_request_started = false;
+        return 0;
+    }
+
+    p_emulator->p_request[p_emulator->request_length++] = byte;
+
+    if (byte != ASTRONODE_TRANSPORT_ETX)
+    {
+        return 0;
+    }
+    p_emulator->is_request_started = false;
+
+    emulator_message_t request = {0};
+    emulator_message_t answer = {0};
+    uint16_t error_code = 0;
+
+    if (decode_request(p_emulator, &request, &error_code))
+    {
+        process_request(p_emulator, &request, &answer);
+    }
+    else
+    {
+        set_error(&answer, error_code);
+    }
+
+    return encode_answer(&answer, p_answer);
+}
+
+uint16_t astronode_emulator_inject_faults(astronode_emulator_t *p_emulator, uint8_t *p_answer, uint16_t length)
+{
+    if (length > 6 && is_fault_drawn(p_emulator, p_emulator->config.crc_error_per_mille))
+    {
+        // One of the 4 CRC characters is replaced by another hexadecimal character.
+        uint16_t index = length - 5 + get_random(p_emulator) % 4;
+        uint8_t value = 0;
+
+        ascii_to_value(p_answer[index], &value);
+        p_answer[index] = g_ascii_lookup[(value + 1 + get_random(p_emulator) % 15) & 0x0F];
+    }
+
+    uint16_t kept = 0;
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        if (is_fault_drawn(p_emulator, p_emulator->config.drop_per_mille) == false)
+        {
+            p_answer[kept++] = p_answer[i];
+        }
+    }
+
+    return kept;
+}
+
+uint32_t astronode_emulator_get_transfer_time_us(const astronode_emulator_t *p_emulator, uint16_t length)
+{
+    if (p_emulator->config.baud_rate == 0)
+    {
+        return 0;
+    }
+
+    return (uint32_t) ((uint64_t) length * ASTRONODE_EMULATOR_BITS_PER_BYTE * 1000000 / p_emulator->config.baud_rate);
+}
+
+return_status_t astronode_emulator_add_command(astronode_emulator_t *p_emulator, const uint8_t *p_data, uint8_t length)
+{
+    p_emulator->p_counters[COUNTER_COMMAND_ATTEMPTS]++;
+
+    if ((length != ASTRONODE_APP_COMMAND_SHORT_LEN_BYTES && length != ASTRONODE_APP_COMMAND_MAX_LEN_BYTES)
+        || p_emulator->command_count >= ASTRONODE_EMULATOR_COMMAND_QUEUE_SIZE)
+    {
+        return RS_FAILURE;
+    }
+
+    astronode_emulator_command_t *p_command = &p_emulator->p_commands[p_emulator->command_count++];
+
+    p_command->created_date = get_astrocast_time(p_emulator);
+    memcpy(p_command->p_data, p_data, length);
+    p_command->length = length;
+    p_emulator->p_counters[COUNTER_COMMAND_SUCCESSES]++;
+
+    return RS_SUCCESS;
+}
+
+bool astronode_emulator_is_evt_pin_high(const astronode_emulator_t *p_emulator)
+{
+    return (get_events(p_emulator) & p_emulator->p_config[2]) != 0;
+}
+
+static uint32_t get_random(astronode_emulator_t *p_emulator)
+{
+    // xorshift32, reproducible for a given seed.
+    uint32_t x = p_emulator->random_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    p_emulator->random_state = x;
+
+    return x;
+}
+
+static bool is_fault_drawn(astronode_emulator_t *p_emulator, uint16_t per_mille)
+{
+    return per_mille > 0 && get_random(p_emulator) % 1000 < per_mille;
+}
+
+static uint32_t get_astrocast_time(const astronode_emulator_t *p_emulator)
+{
+    return (uint32_t) ((p_emulator->now_ms + p_emulator->config.epoch_offset_ms) / 1000);
+}
+
+static uint8_t get_events(const astronode_emulator_t *p_emulator)
+{
+    // Only the reset event is latched, the others follow the queues.
+    uint8_t events = p_emulator->events;
+
+    if (p_emulator->ack_count > 0)
+    {
+        events |= ASTRONODE_EVENT_MSG_ACK;
+    }
+    if (p_emulator->command_count > 0)
+    {
+        events |= ASTRONODE_EVENT_CMD_AVAILABLE;
+    }
+    if (p_emulator->queue_count > 0)
+    {
+        events |= ASTRONODE_EVENT_MSG_TX_PENDING;
+    }
+
+    return events;
+}
+
+static bool ascii_to_value(uint8_t ascii, uint8_t *p_value)
+{
+    if (ascii >= '0' && ascii <= '9')
+    {
+        *p_value = ascii - '0';
+        return true;
+    }
+    else if (ascii >= 'A' && ascii <= 'F')
+    {
+        *p_value = ascii - 'A' + 10;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+static uint16_t calculate_crc(const uint8_t *p_data, uint16_t data_len)
+{
+    // CRC-16/CCITT-FALSE computed bit by bit, independently of the transport layer.
+    uint16_t crc = 0xFFFF;
+
+    for (uint16_t i = 0; i < data_len; i++)
+    {
+        crc ^= (uint16_t) p_data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static uint16_t encode_answer(const emulator_message_t *p_answer, uint8_t *p_buffer)
+{
+    uint8_t p_data[1 + ASTRONODE_APP_MSG_MAX_LEN_BYTES];
+    uint16_t index = 0;
+
+    p_data[0] = p_answer->op_code;
+    memcpy(&p_data[1], p_answer->p_payload, p_answer->payload_len);
+
+    uint16_t crc = calculate_crc(p_data, 1 + p_answer->payload_len);
+
+    p_buffer[index++] = ASTRONODE_TRANSPORT_STX;
+    for (uint16_t i = 0; i < 1 + p_answer->payload_len; i++)
+    {
+        p_buffer[index++] = g_ascii_lookup[p_data[i] >> 4];
+        p_buffer[index++] = g_ascii_lookup[p_data[i] & 0x0F];
+    }
+    // The CRC is sent least significant byte first.
+    p_buffer[index++] = g_ascii_lookup[(crc >> 4) & 0x0F];
+    p_buffer[index++] = g_ascii_lookup[crc & 0x0F];
+    p_buffer[index++] = g_ascii_lookup[crc >> 12];
+    p_buffer[index++] = g_ascii_lookup[(crc >> 8) & 0x0F];
+    p_buffer[index++] = ASTRONODE_TRANSPORT_ETX;
+
+    return index;
+}
+
+static void set_error(emulator_message_t *p_answer, uint16_t error_code)
+{
+    p_answer->op_code = ASTRONODE_OP_CODE_ERROR;
+    p_answer->p_payload[0] = (uint8_t) error_code;
+    p_answer->p_payload[1] = (uint8_t) (error_code >> 8);
+    p_answer->payload_len = ASTRONODE_ERROR_PAYLOAD_LEN_BYTES;
+}
+
+static void append_u32(emulator_message_t *p_answer, uint32_t value)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        p_answer->p_payload[p_answer->payload_len++] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+static void append_tlv(emulator_message_t *p_answer, uint8_t type, uint32_t value, uint8_t size)
+{
+    p_answer->p_payload[p_answer->payload_len++] = type;
+    p_answer->p_payload[p_answer->payload_len++] = size;
+    for (uint8_t i = 0; i < size; i++)
+    {
+        p_answer->p_payload[p_answer->payload_len++] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+static void append_string(emulator_message_t *p_answer, const char *p_string)
+{
+    // Sent with its null terminator.
+    uint16_t length = strlen(p_string) + 1;
+
+    memcpy(&p_answer->p_payload[p_answer->payload_len], p_string, length);
+    p_answer->payload_len += length;
+}
+
+static bool decode_request(const astronode_emulator_t *p_emulator, emulator_message_t *p_request, uint16_t *p_error_code)
+{
+    const uint8_t *p_frame = p_emulator->p_request;
+    uint16_t length = p_emulator->request_length;
+    uint8_t p_data[1 + ASTRONODE_APP_MSG_MAX_LEN_BYTES + 2];
+    uint16_t data_length = (length - 2) / 2;
+
+    // STX + op code + CRC + ETX
+    if (length < 8 || (length - 2) % 2 != 0 || data_length > sizeof(p_data))
+    {
+        *p_error_code = ASTRONODE_ERR_CODE_LENGTH_NOT_VALID;
+        return false;
+    }
+
+    for (uint16_t i = 0; i < data_length; i++)
+    {
+        uint8_t nibble_high = 0;
+        uint8_t nibble_low = 0;
+
+        if (ascii_to_value(p_frame[1 + 2 * i], &nibble_high) == false
+            || ascii_to_value(p_frame[2 + 2 * i], &nibble_low) == false)
+        {
+            *p_error_code = ASTRONODE_ERR_CODE_FORMAT_NOT_VALID;
+            return false;
+        }
+        p_data[i] = (nibble_high << 4) + nibble_low;
+    }
+
+    uint16_t crc = calculate_crc(p_data, data_length - 2);
+
+    if (p_data[data_length - 2] != (crc & 0xFF) || p_data[data_length - 1] != (crc >> 8))
+    {
+        *p_error_code = ASTRONODE_ERR_CODE_CRC_NOT_VALID;
+        return false;
+    }
+
+    p_request->op_code = p_data[0];
+    p_request->payload_len = data_length - 3;
+    memcpy(p_request->p_payload, &p_data[1], p_request->payload_len);
+
+    if (p_request->op_code >= 0x80 || g_request_lengths[p_request->op_code].is_supported == false)
+    {
+        *p_error_code = ASTRONODE_ERR_CODE_OPCODE_NOT_VALID;
+        return false;
+    }
+
+    if (p_request->payload_len < g_request_lengths[p_request->op_code].min_length
+        || p_request->payload_len > g_request_lengths[p_request->op_code].max_length)
+    {
+        *p_error_code = ASTRONODE_ERR_CODE_LENGTH_NOT_VALID;
+        return false;
+    }
+
+    return true;
+}
+
+static void process_request(astronode_emulator_t *p_emulator, const emulator_message_t *p_request, emulator_message_t *p_answer)
+{
+    p_answer->op_code = p_request->op_code | 0x80;
+
+    switch (p_request->op_code)
+    {
+        case ASTRONODE_OP_CODE_CFG_WR:
+            memcpy(p_emulator->p_config, p_request->p_payload, sizeof(p_emulator->p_config));
+            break;
+
+        case ASTRONODE_OP_CODE_CFG_SR:
+            memcpy(p_emulator->p_saved_config, p_emulator->p_config, sizeof(p_emulator->p_config));
+            break;
+
+        case ASTRONODE_OP_CODE_CFG_FR:
+            // The factory configuration is applied at the next reset.
+            memcpy(p_emulator->p_saved_config, g_default_config, sizeof(g_default_config));
+            break;
+
+        case ASTRONODE_OP_CODE_CFG_RR:
+            p_answer->p_payload[p_answer->payload_len++] = EMULATOR_DEVICE_TYPE_ID;
+            p_answer->p_payload[p_answer->payload_len++] = EMULATOR_HW_REVISION;
+            p_answer->p_payload[p_answer->payload_len++] = EMULATOR_FW_MAJOR_VERSION;
+            p_answer->p_payload[p_answer->payload_len++] = EMULATOR_FW_MINOR_VERSION;
+            p_answer->p_payload[p_answer->payload_len++] = EMULATOR_FW_REVISION;
+            memcpy(&p_answer->p_payload[p_answer->payload_len], p_emulator->p_config, sizeof(p_emulator->p_config));
+            p_answer->payload_len += sizeof(p_emulator->p_config);
+            break;
+
+        case ASTRONODE_OP_CODE_CTX_SR:
+        case ASTRONODE_OP_CODE_WIF_WR:
+        case ASTRONODE_OP_CODE_SSC_WR:
+            break;
+
+        case ASTRONODE_OP_CODE_MGI_RR:
+            append_string(p_answer, EMULATOR_GUID);
+            break;
+
+        case ASTRONODE_OP_CODE_MSN_RR:
+            append_string(p_answer, EMULATOR_SERIAL_NUMBER);
+            break;
+
+        case ASTRONODE_OP_CODE_MPN_RR:
+            append_string(p_answer, EMULATOR_PRODUCT_NUMBER);
+            break;
+
+        case ASTRONODE_OP_CODE_GPO_SR:
+            p_emulator->gpo = p_request->p_payload[0];
+            break;
+
+        case ASTRONODE_OP_CODE_GPI_RR:
+            // The GPI reads back the GPO, as with a loopback wire.
+            p_answer->p_payload[p_answer->payload_len++] = p_emulator->gpo;
+            break;
+
+        case ASTRONODE_OP_CODE_PLD_ER:
+        case ASTRONODE_OP_CODE_PLD_DR:
+        case ASTRONODE_OP_CODE_PLD_FR:
+        case ASTRONODE_OP_CODE_SAK_RR:
+        case ASTRONODE_OP_CODE_SAK_CR:
+        case ASTRONODE_OP_CODE_CMD_RR:
+        case ASTRONODE_OP_CODE_CMD_CR:
+            process_payload_request(p_emulator, p_request, p_answer);
+            break;
+
+        default:
+            process_state_request(p_emulator, p_request, p_answer);
+            break;
+    }
+}
+
+static void process_payload_request(astronode_emulator_t *p_emulator, const emulator_message_t *p_request, emulator_message_t *p_answer)
+{
+    uint16_t payload_id = p_request->p_payload[0] + (p_request->p_payload[1] << 8);
+
+    switch (p_request->op_code)
+    {
+        case ASTRONODE_OP_CODE_PLD_ER:
+            if (p_emulator->queue_count >= ASTRONODE_EMULATOR_QUEUE_SIZE)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_BUFFER_FULL);
+                return;
+            }
+            for (uint8_t i = 0; i < p_emulator->queue_count; i++)
+            {
+                if (p_emulator->p_queue[i].id == payload_id)
+                {
+                    set_error(p_answer, ASTRONODE_ERR_CODE_DUPLICATE_ID);
+                    return;
+                }
+            }
+            p_emulator->p_queue[p_emulator->queue_count].id = payload_id;
+            p_emulator->p_queue[p_emulator->queue_count].length = p_request->payload_len - 2;
+            memcpy(p_emulator->p_queue[p_emulator->queue_count].p_data, &p_request->p_payload[2], p_request->payload_len - 2);
+            p_emulator->queue_count++;
+            p_emulator->p_counters[COUNTER_QUEUED_MSG]++;
+            p_answer->p_payload[p_answer->payload_len++] = (uint8_t) payload_id;
+            p_answer->p_payload[p_answer->payload_len++] = (uint8_t) (payload_id >> 8);
+            break;
+
+        case ASTRONODE_OP_CODE_PLD_DR:
+            if (p_emulator->queue_count == 0)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_BUFFER_EMPTY);
+                return;
+            }
+            // The oldest payload is removed.
+            payload_id = p_emulator->p_queue[0].id;
+            p_emulator->queue_count--;
+            memmove(&p_emulator->p_queue[0], &p_emulator->p_queue[1], p_emulator->queue_count * sizeof(astronode_emulator_payload_t));
+            p_emulator->p_counters[COUNTER_DEQUEUED_UNACKED_MSG]++;
+            p_answer->p_payload[p_answer->payload_len++] = (uint8_t) payload_id;
+            p_answer->p_payload[p_answer->payload_len++] = (uint8_t) (payload_id >> 8);
+            break;
+
+        case ASTRONODE_OP_CODE_PLD_FR:
+            p_emulator->p_counters[COUNTER_DEQUEUED_UNACKED_MSG] += p_emulator->queue_count;
+            p_emulator->queue_count = 0;
+            break;
+
+        case ASTRONODE_OP_CODE_SAK_RR:
+            if (p_emulator->ack_count == 0)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_NO_ACK);
+                return;
+            }
+            p_answer->p_payload[p_answer->payload_len++] = (uint8_t) p_emulator->p_acks[0];
+            p_answer->p_payload[p_answer->payload_len++] = (uint8_t) (p_emulator->p_acks[0] >> 8);
+            break;
+
+        case ASTRONODE_OP_CODE_SAK_CR:
+            if (p_emulator->ack_count == 0)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_NO_CLEAR);
+                return;
+            }
+            p_emulator->ack_count--;
+            memmove(&p_emulator->p_acks[0], &p_emulator->p_acks[1], p_emulator->ack_count * sizeof(uint16_t));
+            break;
+
+        case ASTRONODE_OP_CODE_CMD_RR:
+            if (p_emulator->command_count == 0)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_BUFFER_EMPTY);
+                return;
+            }
+            append_u32(p_answer, p_emulator->p_commands[0].created_date);
+            memcpy(&p_answer->p_payload[p_answer->payload_len], p_emulator->p_commands[0].p_data, p_emulator->p_commands[0].length);
+            p_answer->payload_len += p_emulator->p_commands[0].length;
+            break;
+
+        case ASTRONODE_OP_CODE_CMD_CR:
+            if (p_emulator->command_count == 0)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_NO_CLEAR);
+                return;
+            }
+            p_emulator->command_count--;
+            memmove(&p_emulator->p_commands[0], &p_emulator->p_commands[1], p_emulator->command_count * sizeof(astronode_emulator_command_t));
+            break;
+
+        default:
+            set_error(p_answer, ASTRONODE_ERR_CODE_OPCODE_NOT_VALID);
+            break;
+    }
+}
+
+static void process_state_request(astronode_emulator_t *p_emulator, const emulator_message_t *p_request, emulator_message_t *p_answer)
+{
+    uint32_t uptime_s = (p_emulator->now_ms - p_emulator->boot_time_ms) / 1000;
+
+    switch (p_request->op_code)
+    {
+        case ASTRONODE_OP_CODE_NCO_RR:
+        {
+            uint32_t time_to_next_pass_s = 0;
+
+            if (p_emulator->config.pass_period_ms > 0 && p_emulator->is_in_pass == false)
+            {
+                uint32_t phase_ms = (p_emulator->now_ms - p_emulator->boot_time_ms) % p_emulator->config.pass_period_ms;
+
+                time_to_next_pass_s = (p_emulator->config.pass_period_ms - phase_ms) / 1000;
+            }
+            append_u32(p_answer, time_to_next_pass_s);
+            break;
+        }
+
+        case ASTRONODE_OP_CODE_RTC_RR:
+            append_u32(p_answer, get_astrocast_time(p_emulator));
+            break;
+
+        case ASTRONODE_OP_CODE_EVT_RR:
+            p_answer->p_payload[p_answer->payload_len++] = get_events(p_emulator);
+            break;
+
+        case ASTRONODE_OP_CODE_GEO_WR:
+        {
+            int32_t latitude = (int32_t) (p_request->p_payload[0]
+                                          | (p_request->p_payload[1] << 8)
+                                          | (p_request->p_payload[2] << 16)
+                                          | ((uint32_t) p_request->p_payload[3] << 24));
+            int32_t longitude = (int32_t) (p_request->p_payload[4]
+                                           | (p_request->p_payload[5] << 8)
+                                           | (p_request->p_payload[6] << 16)
+                                           | ((uint32_t) p_request->p_payload[7] << 24));
+
+            if (latitude < -900000000 || latitude > 900000000 || longitude < -1800000000 || longitude > 1800000000)
+            {
+                set_error(p_answer, ASTRONODE_ERR_CODE_INVALID_POS);
+                return;
+            }
+            p_emulator->latitude = latitude;
+            p_emulator->longitude = longitude;
+            break;
+        }
+
+        case ASTRONODE_OP_CODE_RES_CR:
+            p_emulator->events &= ~ASTRONODE_EVENT_RESET;
+            break;
+
+        case ASTRONODE_OP_CODE_PER_RR:
+            for (uint8_t i = 0; i < ASTRONODE_EMULATOR_COUNTER_COUNT; i++)
+            {
+                append_tlv(p_answer, i + 1, p_emulator->p_counters[i], 4);
+            }
+            break;
+
+        case ASTRONODE_OP_CODE_PER_CR:
+            memset(p_emulator->p_counters, 0, sizeof(p_emulator->p_counters));
+            break;
+
+        case ASTRONODE_OP_CODE_MST_RR:
+            append_tlv(p_answer, 0x41, p_emulator->queue_count, 1);
+            append_tlv(p_answer, 0x42, p_emulator->ack_count, 1);
+            append_tlv(p_answer, 0x43, EMULATOR_RESET_REASON_PIN, 1);
+            append_tlv(p_answer, 0x44, uptime_s, 4);
+            break;
+
+        case ASTRONODE_OP_CODE_LCD_RR:
+            // Nothing to report before the first pass.
+            if (p_emulator->start_of_last_pass != 0)
+            {
+                append_tlv(p_answer, 0x51, p_emulator->start_of_last_pass, 4);
+                append_tlv(p_answer, 0x52, p_emulator->end_of_last_pass, 4);
+                append_tlv(p_answer, 0x53, EMULATOR_PEAK_RSSI, 1);
+                append_tlv(p_answer, 0x54, p_emulator->start_of_last_pass, 4);
+            }
+            break;
+
+        case ASTRONODE_OP_CODE_END_RR:
+            append_tlv(p_answer, 0x61, 0, 1);
+            append_tlv(p_answer, 0x62, p_emulator->is_in_pass ? EMULATOR_PEAK_RSSI : 0, 1);
+            append_tlv(p_answer, 0x63, p_emulator->is_in_pass ? 0 : (get_astrocast_time(p_emulator) - p_emulator->end_of_last_pass), 4);
+            break;
+
+        default:
+            set_error(p_answer, ASTRONODE_ERR_CODE_OPCODE_NOT_VALID);
+            break;
+    }
+}
+
+static void update_pass(astronode_emulator_t *p_emulator)
+{
+    bool is_in_pass = true;
+
+    if (p_emulator->config.pass_period_ms > 0)
+    {
+        uint32_t phase_ms = (p_emulator->now_ms - p_emulator->boot_time_ms) % p_emulator->config.pass_period_ms;
+
+        is_in_pass = phase_ms < p_emulator->config.pass_duration_ms;
+    }
+
+    if (is_in_pass && p_emulator->is_in_pass == false)
+    {
+        p_emulator->start_of_last_pass = get_astrocast_time(p_emulator);
+        p_emulator->p_counters[COUNTER_SAT_DET_PHASE]++;
+        p_emulator->p_counters[COUNTER_SAT_DET_OPERATIONS]++;
+    }
+    if (is_in_pass || p_emulator->is_in_pass)
+    {
+        p_emulator->end_of_last_pass = get_astrocast_time(p_emulator);
+    }
+    p_emulator->is_in_pass = is_in_pass;
+}
+
+static void transmit_payload(astronode_emulator_t *p_emulator)
+{
+    astronode_emulator_payload_t payload = p_emulator->p_queue[0];
+    uint16_t payload_id = payload.id;
+
+    p_emulator->queue_count--;
+    memmove(&p_emulator->p_queue[0], &p_emulator->p_queue[1], p_emulator->queue_count * sizeof(astronode_emulator_payload_t));
+
+    if (p_emulator->uplink != NULL)
+    {
+        p_emulator->uplink(p_emulator->p_uplink_user, payload.id, payload.p_data, payload.length);
+    }
+
+    p_emulator->p_counters[COUNTER_SIGNALLING_PHASE]++;
+    p_emulator->p_counters[COUNTER_SIGNALLING_ATTEMPTS]++;
+    p_emulator->p_counters[COUNTER_SIGNALLING_SUCCESSES]++;
+    p_emulator->p_counters[COUNTER_SENT_FRAG]++;
+    p_emulator->p_counters[COUNTER_ACK_DEMOD_ATTEMPTS]++;
+    p_emulator->p_counters[COUNTER_ACK_DEMOD_SUCCESSES]++;
+    p_emulator->p_counters[COUNTER_ACKED_FRAG]++;
+    p_emulator->p_counters[COUNTER_ACKED_MSG]++;
+
+    // Without payload acknowledgment in the configuration, the acknowledgment is not reported.
+    if ((p_emulator->p_config[0] & EMULATOR_CONFIG_PAYLOAD_ACK) && p_emulator->ack_count < ASTRONODE_EMULATOR_QUEUE_SIZE)
+    {
+        p_emulator->p_acks[p_emulator->ack_count++] = payload_id;
+    }
+}
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Astrocast
+#include "benchmark_histogram.h"
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint16_t get_bucket_index(uint64_t value);
+static uint64_t get_bucket_highest_value(uint16_t index);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void benchmark_histogram_reset(benchmark_histogram_t *p_histogram)
+{
+    memset(p_histogram, 0, sizeof(benchmark_histogram_t));
+    p_histogram->min = UINT64_MAX;
+}
+
+void benchmark_histogram_record(benchmark_histogram_t *p_histogram, uint64_t value)
+{
+    p_histogram->p_counts[get_bucket_index(value)]++;
+    p_histogram->count++;
+    p_histogram->sum += value;
+    if (value < p_histogram->min)
+    {
+        p_histogram->min = value;
+    }
+    if (value > p_histogram->max)
+    {
+        p_histogram->max = value;
+    }
+}
+
+uint64_t benchmark_histogram_get_percentile(const benchmark_histogram_t *p_histogram, double percentile)
+{
+    uint64_t target = (uint64_t) (percentile / 100.0 * p_histogram->count + 0.5);
+    uint64_t total = 0;
+
+    if (p_histogram->count == 0)
+    {
+        return 0;
+    }
+    if (target == 0)
+    {
+        target = 1;
+    }
+
+    for (uint16_t i = 0; i < BENCHMARK_HISTOGRAM_BUCKET_COUNT; i++)
+    {
+        total += p_histogram->p_counts[i];
+        if (total >= target)
+        {
+            uint64_t value = get_bucket_highest_value(i);
+
+            return value < p_histogram->max ? value : p_histogram->max;
+        }
+    }
+
+    return p_histogram->max;
+}
+
+uint64_t benchmark_histogram_get_mean(const benchmark_histogram_t *p_histogram)
+{
+    return p_histogram->count > 0 ? p_histogram->sum / p_histogram->count : 0;
+}
+
+void benchmark_histogram_print_distribution(const benchmark_histogram_t *p_histogram, FILE *p_file, double scale)
+{
+    uint64_t total = 0;
+
+    fprintf(p_file, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+
+    for (uint16_t i = 0; i < BENCHMARK_HISTOGRAM_BUCKET_COUNT && total < p_histogram->count; i++)
+    {
+        if (p_histogram->p_counts[i] == 0)
+        {
+            continue;
+        }
+        total += p_histogram->p_counts[i];
+
+        uint64_t value = get_bucket_highest_value(i);
+        double ratio = (double) total / p_histogram->count;
+
+        if (value > p_histogram->max)
+        {
+            value = p_histogram->max;
+        }
+
+        if (total < p_histogram->count)
+        {
+            fprintf(p_file, "%12.3f %14.12f %10llu %14.2f\n", value / scale, ratio, (unsigned long long) total, 1.0 / (1.0 - ratio));
+        }
+        else
+        {
+            fprintf(p_file, "%12.3f %14.12f %10llu\n", value / scale, ratio, (unsigned long long) total);
+        }
+    }
+
+    fprintf(p_file, "#[Mean    = %12.3f, Max     = %12.3f]\n", benchmark_histogram_get_mean(p_histogram) / scale, p_histogram->max / scale);
+    fprintf(p_file, "#[Total count    = %12llu]\n", (unsigned long long) p_histogram->count);
+}
+
+static uint16_t get_bucket_index(uint64_t value)
+{
+    if (value < BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT)
+    {
+        return (uint16_t) value;
+    }
+
+    // The value shifted right falls in the upper half of the sub-buckets.
+    uint8_t shift = 63 - __builtin_clzll(value) - 4;
+
+    if (shift > BENCHMARK_HISTOGRAM_MAX_SHIFT)
+    {
+        return BENCHMARK_HISTOGRAM_BUCKET_COUNT - 1;
+    }
+
+    return BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT
+           + (shift - 1) * BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT
+           + (uint16_t) (value >> shift) - BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT;
+}
+
+static uint64_t get_bucket_highest_value(uint16_t index)
+{
+    if (index < BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+
+    uint8_t shift = (index - BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT) / BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT + 1;
+    uint64_t sub_bucket = (index - BENCHMARK_HISTOGRAM_SUB_BUCKET_COUNT) % BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT
+                          + BENCHMARK_HISTOGRAM_HALF_BUCKET_COUNT;
+
+    return ((sub_bucket + 1) << shift) - 1;
+}
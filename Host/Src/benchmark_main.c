@@ -0,0 +1,645 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_emulator.h"
+#include "astronode_geolocation.h"
+#include "astronode_metrics.h"
+#include "astronode_pool.h"
+#include "astronode_profile.h"
+#include "astronode_trace.h"
+#include "astronode_board.h"
+#include "benchmark_histogram.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define BENCHMARK_DEFAULT_ITERATIONS        200
+#define BENCHMARK_OP_CODE_COUNT             0x80
+#define BENCHMARK_STORM_PAYLOAD_COUNT       4
+#define BENCHMARK_STORM_COMMAND_COUNT       2
+#define BENCHMARK_STORM_TIMEOUT_MS          3000
+#define BENCHMARK_NS_PER_US                 1000.0
+
+// The telemetry sweep drifts the asset by about 30 m each time, its position is
+// written once it moved by 100 m.
+#define BENCHMARK_SWEEP_LATITUDE            465193000
+#define BENCHMARK_SWEEP_LONGITUDE           66322000
+#define BENCHMARK_SWEEP_DRIFT               2700
+#define BENCHMARK_SWEEP_MIN_DISTANCE_M      100
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// Durations of one op code: each phase lasts until the next one begins.
+typedef struct benchmark_op_code_stats_t
+{
+    benchmark_histogram_t   p_phases[ASTRONODE_TRANSPORT_PHASE_END];
+    benchmark_histogram_t   total;
+    uint32_t                failure_count;
+} benchmark_op_code_stats_t;
+
+typedef struct benchmark_recorder_t
+{
+    benchmark_op_code_stats_t  *p_op_codes[BENCHMARK_OP_CODE_COUNT];
+    uint64_t                    p_phase_times_ns[ASTRONODE_TRANSPORT_PHASE_COUNT];
+    bool                        p_is_phase_marked[ASTRONODE_TRANSPORT_PHASE_COUNT];
+} benchmark_recorder_t;
+
+typedef struct benchmark_workload_t
+{
+    const char     *p_name;
+    void          (*run)(astronode_ctx_t *p_ctx);
+} benchmark_workload_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void print_usage(const char *p_program);
+static uint64_t get_time_ns(void);
+static void record_phase(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status);
+static void reset_recorder(benchmark_recorder_t *p_recorder);
+static void run_boot(astronode_ctx_t *p_ctx);
+static void run_burst_enqueue(astronode_ctx_t *p_ctx);
+static void run_event_storm(astronode_ctx_t *p_ctx);
+static void run_telemetry_sweep(astronode_ctx_t *p_ctx);
+static void print_report(const benchmark_recorder_t *p_recorder, const char *p_workload, double duration_s, bool is_distribution_printed);
+static void print_profile(void);
+static void print_metrics(astronode_ctx_t *p_ctx);
+static void write_json_histogram(FILE *p_file, const char *p_name, const benchmark_histogram_t *p_histogram, bool is_last);
+static void write_json_workload(FILE *p_file, const benchmark_recorder_t *p_recorder, const char *p_workload, double duration_s, bool is_last);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const char *g_p_op_code_names[BENCHMARK_OP_CODE_COUNT] =
+{
+#define OP_CODE_NAME(op_code, answer_op_code, min_length, max_length, timeout_ms) \
+    [op_code] = &#op_code[sizeof("ASTRONODE_OP_CODE_") - 1],
+    ASTRONODE_OP_CODE_DESCRIPTORS(OP_CODE_NAME)
+#undef OP_CODE_NAME
+};
+
+static const char *g_p_phase_names[ASTRONODE_TRANSPORT_PHASE_END] =
+{
+    [ASTRONODE_TRANSPORT_PHASE_ENCODE] = "encode",
+    [ASTRONODE_TRANSPORT_PHASE_TX] = "tx",
+    [ASTRONODE_TRANSPORT_PHASE_WAIT] = "wait",
+    [ASTRONODE_TRANSPORT_PHASE_RX] = "rx",
+    [ASTRONODE_TRANSPORT_PHASE_DECODE] = "decode"
+};
+
+static const benchmark_workload_t g_p_workloads[] =
+{
+    { "boot", run_boot },
+    { "burst_enqueue", run_burst_enqueue },
+    { "event_storm", run_event_storm },
+    { "telemetry_sweep", run_telemetry_sweep }
+};
+
+static benchmark_recorder_t g_recorder;
+static emulator_link_t g_emulator_link;
+static bool g_is_emulator_link = true;
+static int32_t g_sweep_latitude = BENCHMARK_SWEEP_LATITUDE;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    astronode_emulator_config_t config = { 0 };
+    uint32_t iterations = BENCHMARK_DEFAULT_ITERATIONS;
+    const char *p_workload = NULL;
+    const char *p_device = NULL;
+    const char *p_json_path = NULL;
+    bool is_distribution_printed = false;
+    bool is_verbose = false;
+    bool is_trace_dumped = false;
+    int option = 0;
+
+    while ((option = getopt(argc, argv, "n:w:d:j:b:c:x:s:HTvh")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'w':
+                p_workload = optarg;
+                break;
+
+            case 'd':
+                p_device = optarg;
+                break;
+
+            case 'j':
+                p_json_path = optarg;
+                break;
+
+            case 'b':
+                config.baud_rate = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'c':
+                config.crc_error_per_mille = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'x':
+                config.drop_per_mille = strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                config.seed = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'H':
+                is_distribution_printed = true;
+                break;
+
+            case 'T':
+                is_trace_dumped = true;
+                break;
+
+            case 'v':
+                is_verbose = true;
+                break;
+
+            default:
+                print_usage(argv[0]);
+                return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    init_drivers();
+    set_debug_logs_enabled(is_verbose);
+    astronode_profile_init();
+    if (is_trace_dumped)
+    {
+        astronode_trace_init();
+        astronode_trace_clear();
+    }
+
+    astronode_ctx_t ctx;
+
+    if (p_device != NULL)
+    {
+        if (open_astronode_port(get_default_astronode_port(), p_device) != RS_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        astronode_ctx_init(&ctx, get_astronode_uart_ops(), get_default_astronode_port());
+        g_is_emulator_link = false;
+    }
+    else
+    {
+        emulator_link_init(&g_emulator_link, &config);
+        astronode_ctx_init(&ctx, get_emulator_link_uart_ops(), &g_emulator_link);
+    }
+
+    FILE *p_json = NULL;
+
+    if (p_json_path != NULL)
+    {
+        p_json = fopen(p_json_path, "w");
+        if (p_json == NULL)
+        {
+            perror(p_json_path);
+            return EXIT_FAILURE;
+        }
+        fprintf(p_json, "{\n  \"link\": \"%s\",\n  \"iterations\": %u,\n  \"unit\": \"us\",\n  \"workloads\": [\n",
+                p_device != NULL ? p_device : "emulator", iterations);
+    }
+
+    size_t workload_count = sizeof(g_p_workloads) / sizeof(g_p_workloads[0]);
+    size_t last_workload = workload_count - 1;
+
+    if (p_workload != NULL)
+    {
+        for (last_workload = 0; last_workload < workload_count; last_workload++)
+        {
+            if (strcmp(g_p_workloads[last_workload].p_name, p_workload) == 0)
+            {
+                break;
+            }
+        }
+        if (last_workload == workload_count)
+        {
+            fprintf(stderr, "Unknown workload %s.\n", p_workload);
+            return EXIT_FAILURE;
+        }
+    }
+
+    astronode_ctx_set_phase_hook(&ctx, record_phase, &g_recorder);
+    astronode_geolocation_init(&ctx, BENCHMARK_SWEEP_MIN_DISTANCE_M, ASTRONODE_GEOLOCATION_NO_MAX_AGE);
+
+    for (size_t i = 0; i < workload_count; i++)
+    {
+        if (p_workload != NULL && i != last_workload)
+        {
+            continue;
+        }
+
+        reset_recorder(&g_recorder);
+        astronode_profile_reset();
+        astronode_metrics_reset(&ctx);
+
+        uint64_t start_ns = get_time_ns();
+
+        for (uint32_t j = 0; j < iterations; j++)
+        {
+            g_p_workloads[i].run(&ctx);
+        }
+
+        double duration_s = (get_time_ns() - start_ns) / 1e9;
+
+        print_report(&g_recorder, g_p_workloads[i].p_name, duration_s, is_distribution_printed);
+        print_profile();
+        print_metrics(&ctx);
+        if (p_json != NULL)
+        {
+            write_json_workload(p_json, &g_recorder, g_p_workloads[i].p_name, duration_s, i == last_workload);
+        }
+    }
+
+    reset_recorder(&g_recorder);
+
+    if (is_trace_dumped)
+    {
+        set_debug_logs_enabled(true);
+        astronode_trace_dump();
+        set_debug_logs_enabled(is_verbose);
+    }
+    if (p_json != NULL)
+    {
+        fprintf(p_json, "  ]\n}\n");
+        fclose(p_json);
+    }
+    if (p_device != NULL)
+    {
+        close_astronode_port(get_default_astronode_port());
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static void print_usage(const char *p_program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "Measure the transactions of the library, per op code and per phase.\n"
+            "  -n <count>   iterations of each workload (default %d)\n"
+            "  -w <name>    run one workload: boot, burst_enqueue, event_storm, telemetry_sweep\n"
+            "  -d <device>  serial port or emulator pty, instead of the emulator linked in\n"
+            "  -j <path>    write the percentiles as JSON\n"
+            "  -b <baud>    byte pacing of the linked emulator, e.g. 9600 (default 0, answers at once)\n"
+            "  -c <permil>  answers sent with a corrupted CRC by the linked emulator\n"
+            "  -x <permil>  bytes of the answers dropped by the linked emulator\n"
+            "  -s <seed>    seed of the fault injection\n"
+            "  -H           print the percentile distribution of each op code\n"
+            "  -T           dump the last frames of the wire trace on the standard error\n"
+            "  -v           keep the debug logs of the library\n",
+            p_program, BENCHMARK_DEFAULT_ITERATIONS);
+}
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+static void record_phase(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status)
+{
+    benchmark_recorder_t *p_recorder = p_user;
+    uint64_t now_ns = get_time_ns();
+
+    if (phase == ASTRONODE_TRANSPORT_PHASE_ENCODE)
+    {
+        memset(p_recorder->p_is_phase_marked, 0, sizeof(p_recorder->p_is_phase_marked));
+    }
+    p_recorder->p_phase_times_ns[phase] = now_ns;
+    p_recorder->p_is_phase_marked[phase] = true;
+
+    if (phase != ASTRONODE_TRANSPORT_PHASE_END || p_recorder->p_is_phase_marked[ASTRONODE_TRANSPORT_PHASE_ENCODE] == false)
+    {
+        return;
+    }
+
+    op_code &= 0x7F;
+    if (p_recorder->p_op_codes[op_code] == NULL)
+    {
+        p_recorder->p_op_codes[op_code] = malloc(sizeof(benchmark_op_code_stats_t));
+        if (p_recorder->p_op_codes[op_code] == NULL)
+        {
+            return;
+        }
+        for (uint8_t i = 0; i < ASTRONODE_TRANSPORT_PHASE_END; i++)
+        {
+            benchmark_histogram_reset(&p_recorder->p_op_codes[op_code]->p_phases[i]);
+        }
+        benchmark_histogram_reset(&p_recorder->p_op_codes[op_code]->total);
+        p_recorder->p_op_codes[op_code]->failure_count = 0;
+    }
+
+    benchmark_op_code_stats_t *p_stats = p_recorder->p_op_codes[op_code];
+
+    // Failed transactions mostly wait for the answer timeout, they are only counted.
+    if (status != RS_SUCCESS)
+    {
+        p_stats->failure_count++;
+        return;
+    }
+
+    for (uint8_t i = 0; i < ASTRONODE_TRANSPORT_PHASE_END; i++)
+    {
+        benchmark_histogram_record(&p_stats->p_phases[i], p_recorder->p_phase_times_ns[i + 1] - p_recorder->p_phase_times_ns[i]);
+    }
+    benchmark_histogram_record(&p_stats->total, now_ns - p_recorder->p_phase_times_ns[ASTRONODE_TRANSPORT_PHASE_ENCODE]);
+}
+
+static void reset_recorder(benchmark_recorder_t *p_recorder)
+{
+    for (uint8_t i = 0; i < BENCHMARK_OP_CODE_COUNT; i++)
+    {
+        free(p_recorder->p_op_codes[i]);
+    }
+    memset(p_recorder, 0, sizeof(benchmark_recorder_t));
+}
+
+static void run_boot(astronode_ctx_t *p_ctx)
+{
+    uint8_t event_bitmask = 0;
+    uint32_t time_to_next_pass = 0;
+
+    p_ctx->p_uart_ops->reset(p_ctx->p_port);
+
+    astronode_send_evt_rr(p_ctx, &event_bitmask);
+    astronode_send_res_cr(p_ctx);
+    astronode_send_cfg_wr(p_ctx, true, false, true, true, true, true, true, false);
+    astronode_send_cfg_rr(p_ctx);
+    astronode_send_mgi_rr(p_ctx);
+    astronode_send_msn_rr(p_ctx);
+    astronode_send_mpn_rr(p_ctx);
+    astronode_send_rtc_rr(p_ctx);
+    astronode_send_nco_rr(p_ctx, &time_to_next_pass);
+}
+
+static void run_burst_enqueue(astronode_ctx_t *p_ctx)
+{
+    char p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint16_t payload_id = 0;
+    uint32_t ack_delay_ms = g_emulator_link.emulator.config.ack_delay_ms;
+
+    memset(p_payload, 'B', sizeof(p_payload));
+
+    // The linked satellite is held back during the burst, otherwise it would send a
+    // payload at each request and PLD_DR would find the queue empty.
+    if (g_is_emulator_link)
+    {
+        g_emulator_link.emulator.config.ack_delay_ms = UINT32_MAX;
+    }
+
+    astronode_send_pld_fr(p_ctx);
+    for (uint8_t i = 0; i < ASTRONODE_EMULATOR_QUEUE_SIZE; i++)
+    {
+        astronode_send_pld_er(p_ctx, astronode_ctx_allocate_payload_id(p_ctx), p_payload, sizeof(p_payload));
+    }
+    for (uint8_t i = 0; i < ASTRONODE_EMULATOR_QUEUE_SIZE; i++)
+    {
+        astronode_send_pld_dr(p_ctx, &payload_id);
+    }
+
+    if (g_is_emulator_link)
+    {
+        g_emulator_link.emulator.config.ack_delay_ms = ack_delay_ms;
+    }
+}
+
+static void run_event_storm(astronode_ctx_t *p_ctx)
+{
+    char p_payload[] = "Event storm";
+    uint8_t acknowledged_count = 0;
+    uint8_t event_bitmask = 0;
+    uint32_t start_ms = get_systick();
+
+    astronode_send_pld_fr(p_ctx);
+    for (uint8_t i = 0; i < BENCHMARK_STORM_PAYLOAD_COUNT; i++)
+    {
+        astronode_send_pld_er(p_ctx, astronode_ctx_allocate_payload_id(p_ctx), p_payload, strlen(p_payload));
+    }
+
+    // Over a serial port, the commands come from the emulator (-m option).
+    for (uint8_t i = 0; g_is_emulator_link && i < BENCHMARK_STORM_COMMAND_COUNT; i++)
+    {
+        uint8_t p_command[ASTRONODE_APP_COMMAND_SHORT_LEN_BYTES] = { i };
+
+        astronode_emulator_add_command(&g_emulator_link.emulator, p_command, sizeof(p_command));
+    }
+
+    // The events are polled back to back, as fast as the module answers.
+    while (acknowledged_count < BENCHMARK_STORM_PAYLOAD_COUNT && get_systick() - start_ms < BENCHMARK_STORM_TIMEOUT_MS)
+    {
+        uint16_t payload_id = 0;
+        astronode_command_t command;
+
+        if (astronode_send_evt_rr(p_ctx, &event_bitmask) != RS_SUCCESS)
+        {
+            continue;
+        }
+        if (is_sak_available(p_ctx) && astronode_send_sak_rr(p_ctx, &payload_id) == RS_SUCCESS)
+        {
+            astronode_send_sak_cr(p_ctx);
+            acknowledged_count++;
+        }
+        if (is_command_available(p_ctx) && astronode_send_cmd_rr(p_ctx, &command) == RS_SUCCESS)
+        {
+            astronode_send_cmd_cr(p_ctx);
+        }
+    }
+}
+
+static void run_telemetry_sweep(astronode_ctx_t *p_ctx)
+{
+    astronode_module_state_t module_state;
+    astronode_last_contact_t last_contact;
+    astronode_environment_details_t environment_details;
+    uint32_t time_to_next_pass = 0;
+
+    astronode_send_per_rr(p_ctx);
+    astronode_send_mst_rr(p_ctx, &module_state);
+    astronode_send_lcd_rr(p_ctx, &last_contact);
+    astronode_send_end_rr(p_ctx, &environment_details);
+    astronode_send_nco_rr(p_ctx, &time_to_next_pass);
+    astronode_send_rtc_rr(p_ctx);
+    g_sweep_latitude += BENCHMARK_SWEEP_DRIFT;
+    astronode_geolocation_update(g_sweep_latitude, BENCHMARK_SWEEP_LONGITUDE);
+    astronode_send_per_cr(p_ctx);
+}
+
+static void print_report(const benchmark_recorder_t *p_recorder, const char *p_workload, double duration_s, bool is_distribution_printed)
+{
+    printf("%s: %.3f s\n", p_workload, duration_s);
+    printf("  %-7s %7s %5s %10s %10s %10s %10s |", "op", "count", "fail", "p50 us", "p90 us", "p99 us", "max us");
+    for (uint8_t i = 0; i < ASTRONODE_TRANSPORT_PHASE_END; i++)
+    {
+        printf(" %8s", g_p_phase_names[i]);
+    }
+    printf(" (p50 us)\n");
+
+    for (uint8_t op_code = 0; op_code < BENCHMARK_OP_CODE_COUNT; op_code++)
+    {
+        const benchmark_op_code_stats_t *p_stats = p_recorder->p_op_codes[op_code];
+
+        if (p_stats == NULL)
+        {
+            continue;
+        }
+
+        printf("  %-7s %7llu %5u %10.1f %10.1f %10.1f %10.1f |",
+               g_p_op_code_names[op_code] != NULL ? g_p_op_code_names[op_code] : "?",
+               (unsigned long long) p_stats->total.count,
+               p_stats->failure_count,
+               benchmark_histogram_get_percentile(&p_stats->total, 50.0) / BENCHMARK_NS_PER_US,
+               benchmark_histogram_get_percentile(&p_stats->total, 90.0) / BENCHMARK_NS_PER_US,
+               benchmark_histogram_get_percentile(&p_stats->total, 99.0) / BENCHMARK_NS_PER_US,
+               p_stats->total.max / BENCHMARK_NS_PER_US);
+        for (uint8_t i = 0; i < ASTRONODE_TRANSPORT_PHASE_END; i++)
+        {
+            printf(" %8.1f", benchmark_histogram_get_percentile(&p_stats->p_phases[i], 50.0) / BENCHMARK_NS_PER_US);
+        }
+        printf("\n");
+
+        if (is_distribution_printed && p_stats->total.count > 0)
+        {
+            printf("\n%s %s total (us):\n", p_workload, g_p_op_code_names[op_code]);
+            benchmark_histogram_print_distribution(&p_stats->total, stdout, BENCHMARK_NS_PER_US);
+            printf("\n");
+        }
+    }
+    printf("\n");
+}
+
+static void print_profile(void)
+{
+#ifdef ASTRONODE_PROFILE
+    printf("  %-15s %9s %10s %10s %10s (ns)\n", "site", "count", "min", "max", "mean");
+    for (uint8_t i = 0; i < ASTRONODE_PROFILE_SITE_COUNT; i++)
+    {
+        const astronode_profile_stats_t *p_stats = astronode_profile_get_stats(i);
+
+        printf("  %-15s %9u %10u %10u %10llu\n",
+               astronode_profile_get_site_name(i),
+               p_stats->count,
+               p_stats->min_ticks,
+               p_stats->max_ticks,
+               (unsigned long long) (p_stats->count > 0 ? p_stats->sum_ticks / p_stats->count : 0));
+    }
+    printf("\n");
+#endif
+}
+
+static void print_metrics(astronode_ctx_t *p_ctx)
+{
+    astronode_metrics_snapshot_t snapshot;
+    astronode_pool_usage_t high_water;
+    uint8_t p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+
+    astronode_metrics_snapshot(p_ctx, &snapshot, true);
+
+    printf("  link:");
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_COUNTER_COUNT; i++)
+    {
+        printf(" %s %u", astronode_metrics_get_counter_name(i), snapshot.p_counters[i]);
+    }
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_FAILURE_COUNT; i++)
+    {
+        if (snapshot.p_failures[i] > 0)
+        {
+            printf(", %s %u", astronode_metrics_get_failure_name(i), snapshot.p_failures[i]);
+        }
+    }
+    for (uint8_t i = 0; i < ASTRONODE_METRICS_ERROR_CODE_COUNT; i++)
+    {
+        if (snapshot.p_error_codes[i] > 0)
+        {
+            printf(", %s %u", astronode_metrics_get_error_code_name(i), snapshot.p_error_codes[i]);
+        }
+    }
+    printf(" (%u bytes serialized)\n", astronode_metrics_serialize(&snapshot, p_payload, sizeof(p_payload)));
+
+    astronode_pool_get_high_water(p_ctx, &high_water);
+    printf("  pool high-water: msgs %u/%u, request frame %u/%u, answer frame %u/%u bytes\n\n",
+           high_water.msg_count, ASTRONODE_POOL_MSG_COUNT,
+           high_water.request_frame_len, ASTRONODE_POOL_REQUEST_FRAME_LEN_BYTES,
+           high_water.answer_frame_len, ASTRONODE_POOL_ANSWER_FRAME_LEN_BYTES);
+}
+
+static void write_json_histogram(FILE *p_file, const char *p_name, const benchmark_histogram_t *p_histogram, bool is_last)
+{
+    fprintf(p_file,
+            "            \"%s\": { \"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"p999\": %.3f, \"max\": %.3f, \"mean\": %.3f }%s\n",
+            p_name,
+            (p_histogram->count > 0 ? p_histogram->min : 0) / BENCHMARK_NS_PER_US,
+            benchmark_histogram_get_percentile(p_histogram, 50.0) / BENCHMARK_NS_PER_US,
+            benchmark_histogram_get_percentile(p_histogram, 90.0) / BENCHMARK_NS_PER_US,
+            benchmark_histogram_get_percentile(p_histogram, 99.0) / BENCHMARK_NS_PER_US,
+            benchmark_histogram_get_percentile(p_histogram, 99.9) / BENCHMARK_NS_PER_US,
+            p_histogram->max / BENCHMARK_NS_PER_US,
+            benchmark_histogram_get_mean(p_histogram) / BENCHMARK_NS_PER_US,
+            is_last ? "" : ",");
+}
+
+static void write_json_workload(FILE *p_file, const benchmark_recorder_t *p_recorder, const char *p_workload, double duration_s, bool is_last)
+{
+    bool is_first = true;
+
+    fprintf(p_file, "    {\n      \"name\": \"%s\",\n      \"duration_s\": %.6f,\n      \"op_codes\": [", p_workload, duration_s);
+
+    for (uint8_t op_code = 0; op_code < BENCHMARK_OP_CODE_COUNT; op_code++)
+    {
+        const benchmark_op_code_stats_t *p_stats = p_recorder->p_op_codes[op_code];
+
+        if (p_stats == NULL)
+        {
+            continue;
+        }
+
+        fprintf(p_file, "%s\n        {\n          \"op_code\": \"%s\",\n          \"count\": %llu,\n          \"failures\": %u,\n          \"phases\": {\n",
+                is_first ? "" : ",",
+                g_p_op_code_names[op_code] != NULL ? g_p_op_code_names[op_code] : "?",
+                (unsigned long long) p_stats->total.count,
+                p_stats->failure_count);
+        for (uint8_t i = 0; i < ASTRONODE_TRANSPORT_PHASE_END; i++)
+        {
+            write_json_histogram(p_file, g_p_phase_names[i], &p_stats->p_phases[i], false);
+        }
+        write_json_histogram(p_file, "total", &p_stats->total, true);
+        fprintf(p_file, "          }\n        }");
+        is_first = false;
+    }
+
+    fprintf(p_file, "\n      ]\n    }%s\n", is_last ? "" : ",");
+}
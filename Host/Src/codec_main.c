@@ -0,0 +1,702 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_aggregator.h"
+#include "astronode_application.h"
+#include "astronode_compress.h"
+#include "astronode_definitions.h"
+#include "astronode_downsampler.h"
+#include "astronode_packer.h"
+#include "astronode_payload_policy.h"
+#include "dataset.h"
+#include "drivers_posix.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define CODEC_DEFAULT_ITERATIONS    100
+#define CODEC_LINE_MAX_LEN_BYTES    (2 * ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES + 2)
+#define CODEC_TEXT_MAX_LEN_BYTES    64
+#define CODEC_DEFAULT_ERROR_BOUND   1
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// Room for the flag byte of astronode_compress().
+typedef struct codec_payload_t
+{
+    uint16_t    length;
+    uint8_t     p_data[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES + 1];
+} codec_payload_t;
+
+// Payloads of a whole dataset, as they would be uplinked.
+typedef struct codec_payloads_t
+{
+    codec_payload_t    *p_payloads;
+    uint32_t            count;
+    uint32_t            capacity;
+    uint32_t            total_length;
+} codec_payloads_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void print_usage(const char *p_program);
+static uint64_t get_time_ns(void);
+static return_status_t add_payload(codec_payloads_t *p_payloads, const uint8_t *p_data, uint16_t length);
+static return_status_t pack_dataset(const dataset_t *p_dataset, uint16_t payload_capacity, codec_payloads_t *p_payloads);
+static return_status_t format_dataset(const dataset_t *p_dataset, uint16_t payload_capacity, codec_payloads_t *p_payloads);
+static return_status_t compress_payloads(const codec_payloads_t *p_input, uint8_t compression, codec_payloads_t *p_output);
+static return_status_t decompress_payloads(const codec_payloads_t *p_input, codec_payloads_t *p_output);
+static void print_compression(const char *p_name, const codec_payloads_t *p_input, uint8_t compression, uint32_t raw_length, uint32_t iterations);
+static void count_summary(const uint8_t *p_record, uint16_t record_length);
+static uint32_t downsample_channel(const dataset_t *p_dataset, uint8_t channel, astronode_downsampler_mode_t mode, uint32_t error_bound, uint32_t *p_point_count);
+static void print_reduction(const dataset_t *p_dataset, uint32_t error_bound, uint32_t iterations);
+static uint32_t unpack_payload(const uint8_t *p_data, uint16_t length, const dataset_t *p_dataset, uint32_t first_sample, FILE *p_output);
+static int benchmark(const char *p_path, uint16_t payload_capacity, uint32_t error_bound, uint32_t iterations);
+static int encode(const char *p_path, uint16_t payload_capacity, uint8_t compression);
+static int decode(FILE *p_input, bool is_compressed);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// Summary records emitted by the aggregator.
+static uint32_t g_summary_count = 0;
+static uint32_t g_summary_length = 0;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    uint32_t iterations = CODEC_DEFAULT_ITERATIONS;
+    uint16_t payload_capacity = ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES;
+    uint8_t compression = ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE;
+    uint32_t error_bound = CODEC_DEFAULT_ERROR_BOUND;
+    int option = 0;
+
+    while ((option = getopt(argc, argv, "n:l:e:zZh")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'l':
+                payload_capacity = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'e':
+                error_bound = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'z':
+                compression = ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS;
+                break;
+
+            case 'Z':
+                compression = ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS_DICTIONARY;
+                break;
+
+            default:
+                print_usage(argv[0]);
+                return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    set_debug_logs_enabled(false);
+    if (payload_capacity < 2 || payload_capacity > ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES)
+    {
+        fprintf(stderr, "The payload length is at most %d bytes.\n", ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES);
+        return EXIT_FAILURE;
+    }
+
+    if (argc - optind >= 2 && strcmp(argv[optind], "bench") == 0)
+    {
+        int status = EXIT_SUCCESS;
+
+        for (int i = optind + 1; i < argc; i++)
+        {
+            if (benchmark(argv[i], payload_capacity, error_bound, iterations > 0 ? iterations : 1) != EXIT_SUCCESS)
+            {
+                status = EXIT_FAILURE;
+            }
+        }
+        return status;
+    }
+    else if (argc - optind == 2 && strcmp(argv[optind], "encode") == 0)
+    {
+        return encode(argv[optind + 1], payload_capacity, compression);
+    }
+    else if ((argc - optind == 1 || argc - optind == 2) && strcmp(argv[optind], "decode") == 0)
+    {
+        FILE *p_input = argc - optind == 2 ? fopen(argv[optind + 1], "r") : stdin;
+
+        if (p_input == NULL)
+        {
+            perror(argv[optind + 1]);
+            return EXIT_FAILURE;
+        }
+        return decode(p_input, compression != ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE);
+    }
+
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+}
+
+static void print_usage(const char *p_program)
+{
+    fprintf(stderr,
+            "Usage: %s [-n <iterations>] [-l <length>] [-e <bound>] bench <dataset.csv>...\n"
+            "       %s [-l <length>] [-z | -Z] encode <dataset.csv>\n"
+            "       %s [-z] decode [<payloads>]\n"
+            "The datasets are CSV files such as Host/Data/sensor_*.csv: a time in seconds and integer channels.\n"
+            "  bench        pack each dataset in payloads of at most -l bytes (default %d), check\n"
+            "               that they unpack to the dataset and print the ratio and the throughput,\n"
+            "               then the same with the LZSS stage, and LZSS alone on the samples as text.\n"
+            "               Each channel is also summarized by the aggregator and downsampled within\n"
+            "               the error bound -e (default %d)\n"
+            "  encode       write the payloads of a dataset in hexadecimal, one per line\n"
+            "  decode       read payloads in hexadecimal, one per line (standard input by default),\n"
+            "               and write their samples as CSV, as the backend would\n"
+            "  -z, -Z       payloads through the LZSS stage of the payload policy, -Z with the dictionary\n",
+            p_program, p_program, p_program, ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES, CODEC_DEFAULT_ERROR_BOUND);
+}
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+static return_status_t add_payload(codec_payloads_t *p_payloads, const uint8_t *p_data, uint16_t length)
+{
+    if (p_payloads->count == p_payloads->capacity)
+    {
+        uint32_t capacity = p_payloads->capacity > 0 ? 2 * p_payloads->capacity : 64;
+        codec_payload_t *p_array = realloc(p_payloads->p_payloads, capacity * sizeof(codec_payload_t));
+
+        if (p_array == NULL)
+        {
+            return RS_FAILURE;
+        }
+        p_payloads->p_payloads = p_array;
+        p_payloads->capacity = capacity;
+    }
+
+    p_payloads->p_payloads[p_payloads->count].length = length;
+    memcpy(p_payloads->p_payloads[p_payloads->count].p_data, p_data, length);
+    p_payloads->count++;
+    p_payloads->total_length += length;
+
+    return RS_SUCCESS;
+}
+
+static return_status_t pack_dataset(const dataset_t *p_dataset, uint16_t payload_capacity, codec_payloads_t *p_payloads)
+{
+    uint8_t p_buffer[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint32_t index = 0;
+
+    p_payloads->count = 0;
+    p_payloads->total_length = 0;
+
+    while (index < p_dataset->sample_count)
+    {
+        astronode_packer_t packer;
+        astronode_packer_header_t header =
+        {
+            .channel_count = p_dataset->channel_count,
+            .base_timestamp = p_dataset->p_times[index],
+            .sample_interval = index + 1 < p_dataset->sample_count ? p_dataset->p_times[index + 1] - p_dataset->p_times[index] : 0
+        };
+
+        if (astronode_packer_init(&packer, p_buffer, payload_capacity, &header) != RS_SUCCESS
+            || astronode_packer_add_sample(&packer, dataset_get_sample(p_dataset, index)) != RS_SUCCESS)
+        {
+            return RS_FAILURE;
+        }
+        index++;
+
+        // A payload ends when it is full or when a sample is off the regular interval.
+        while (index < p_dataset->sample_count
+               && p_dataset->p_times[index] == header.base_timestamp + packer.sample_count * header.sample_interval
+               && astronode_packer_add_sample(&packer, dataset_get_sample(p_dataset, index)) == RS_SUCCESS)
+        {
+            index++;
+        }
+
+        if (add_payload(p_payloads, p_buffer, packer.length) != RS_SUCCESS)
+        {
+            return RS_FAILURE;
+        }
+    }
+
+    return RS_SUCCESS;
+}
+
+static return_status_t format_dataset(const dataset_t *p_dataset, uint16_t payload_capacity, codec_payloads_t *p_payloads)
+{
+    char p_text[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint16_t length = 0;
+
+    p_payloads->count = 0;
+    p_payloads->total_length = 0;
+
+    // Samples written as "name:value" text, the way a payload is often built by hand.
+    for (uint32_t i = 0; i < p_dataset->sample_count; i++)
+    {
+        char p_sample[DATASET_MAX_CHANNELS * CODEC_TEXT_MAX_LEN_BYTES];
+        uint16_t sample_length = snprintf(p_sample, sizeof(p_sample), "time:%u", p_dataset->p_times[i]);
+
+        for (uint8_t j = 0; j < p_dataset->channel_count; j++)
+        {
+            sample_length += snprintf(&p_sample[sample_length], sizeof(p_sample) - sample_length, ",%s:%d",
+                                      p_dataset->p_names[j], dataset_get_sample(p_dataset, i)[j]);
+        }
+        p_sample[sample_length++] = ';';
+
+        if (sample_length > payload_capacity)
+        {
+            return RS_FAILURE;
+        }
+        if (length + sample_length > payload_capacity)
+        {
+            if (add_payload(p_payloads, (const uint8_t *) p_text, length) != RS_SUCCESS)
+            {
+                return RS_FAILURE;
+            }
+            length = 0;
+        }
+        memcpy(&p_text[length], p_sample, sample_length);
+        length += sample_length;
+    }
+
+    return length > 0 ? add_payload(p_payloads, (const uint8_t *) p_text, length) : RS_SUCCESS;
+}
+
+static return_status_t compress_payloads(const codec_payloads_t *p_input, uint8_t compression, codec_payloads_t *p_output)
+{
+    codec_payload_t payload;
+
+    p_output->count = 0;
+    p_output->total_length = 0;
+
+    for (uint32_t i = 0; i < p_input->count; i++)
+    {
+        if (astronode_compress(p_input->p_payloads[i].p_data,
+                               p_input->p_payloads[i].length,
+                               compression == ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS_DICTIONARY,
+                               payload.p_data,
+                               sizeof(payload.p_data),
+                               &payload.length) != RS_SUCCESS
+            || add_payload(p_output, payload.p_data, payload.length) != RS_SUCCESS)
+        {
+            return RS_FAILURE;
+        }
+    }
+
+    return RS_SUCCESS;
+}
+
+static return_status_t decompress_payloads(const codec_payloads_t *p_input, codec_payloads_t *p_output)
+{
+    codec_payload_t payload;
+
+    p_output->count = 0;
+    p_output->total_length = 0;
+
+    for (uint32_t i = 0; i < p_input->count; i++)
+    {
+        if (astronode_decompress(p_input->p_payloads[i].p_data,
+                                 p_input->p_payloads[i].length,
+                                 payload.p_data,
+                                 sizeof(payload.p_data),
+                                 &payload.length) != RS_SUCCESS
+            || add_payload(p_output, payload.p_data, payload.length) != RS_SUCCESS)
+        {
+            return RS_FAILURE;
+        }
+    }
+
+    return RS_SUCCESS;
+}
+
+static void print_compression(const char *p_name, const codec_payloads_t *p_input, uint8_t compression, uint32_t raw_length, uint32_t iterations)
+{
+    codec_payloads_t compressed = { 0 };
+    codec_payloads_t restored = { 0 };
+    bool is_restored = compress_payloads(p_input, compression, &compressed) == RS_SUCCESS
+                       && decompress_payloads(&compressed, &restored) == RS_SUCCESS
+                       && restored.count == p_input->count;
+
+    for (uint32_t i = 0; is_restored && i < restored.count; i++)
+    {
+        is_restored = restored.p_payloads[i].length == p_input->p_payloads[i].length
+                      && memcmp(restored.p_payloads[i].p_data, p_input->p_payloads[i].p_data, restored.p_payloads[i].length) == 0;
+    }
+
+    if (is_restored == false)
+    {
+        printf("  %-12s round trip FAILED\n", p_name);
+        free(compressed.p_payloads);
+        free(restored.p_payloads);
+        return;
+    }
+
+    uint64_t start_ns = get_time_ns();
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        compress_payloads(p_input, compression, &compressed);
+    }
+
+    uint64_t compress_ns = get_time_ns() - start_ns;
+
+    start_ns = get_time_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        decompress_payloads(&compressed, &restored);
+    }
+
+    uint64_t decompress_ns = get_time_ns() - start_ns;
+
+    printf("  %-12s %7u bytes in %u payloads, ratio %.2f (%.1f %% of raw), LZSS %.1f %% of its input\n",
+           p_name, compressed.total_length, compressed.count,
+           (double) raw_length / compressed.total_length, 100.0 * compressed.total_length / raw_length,
+           100.0 * compressed.total_length / p_input->total_length);
+    printf("  %-12s compress %.2f MB/s, decompress %.2f MB/s of input\n", "",
+           (double) p_input->total_length * iterations / (compress_ns / 1e3),
+           (double) p_input->total_length * iterations / (decompress_ns / 1e3));
+
+    free(compressed.p_payloads);
+    free(restored.p_payloads);
+}
+
+static void count_summary(const uint8_t *p_record, uint16_t record_length)
+{
+    (void) p_record;
+
+    g_summary_count++;
+    g_summary_length += record_length;
+}
+
+static uint32_t downsample_channel(const dataset_t *p_dataset, uint8_t channel, astronode_downsampler_mode_t mode, uint32_t error_bound, uint32_t *p_point_count)
+{
+    astronode_downsampler_t downsampler;
+    astronode_downsampler_point_t previous = { 0 };
+    astronode_downsampler_point_t point = { 0 };
+    uint8_t p_buffer[ASTRONODE_DOWNSAMPLER_POINT_MAX_LEN_BYTES];
+    uint32_t length = 0;
+
+    // Points encoded as a single trace, without the payload format bytes.
+    astronode_downsampler_init(&downsampler, mode, error_bound);
+    *p_point_count = 0;
+    for (uint32_t i = 0; i <= p_dataset->sample_count; i++)
+    {
+        bool is_kept = i < p_dataset->sample_count
+                       ? astronode_downsampler_add_sample(&downsampler, p_dataset->p_times[i], dataset_get_sample(p_dataset, i)[channel], &point)
+                       : astronode_downsampler_flush(&downsampler, &point);
+
+        if (is_kept)
+        {
+            length += astronode_downsampler_encode_point(*p_point_count > 0 ? &previous : NULL, &point, p_buffer);
+            previous = point;
+            (*p_point_count)++;
+        }
+    }
+
+    return length;
+}
+
+static void print_reduction(const dataset_t *p_dataset, uint32_t error_bound, uint32_t iterations)
+{
+    uint32_t point_count = 0;
+
+    printf("  per channel  aggregator windows of the SENSOR channel, downsampler error bound %u\n", error_bound);
+    for (uint8_t channel = 0; channel < p_dataset->channel_count; channel++)
+    {
+        g_summary_count = 0;
+        g_summary_length = 0;
+        astronode_aggregator_init(count_summary);
+        for (uint32_t i = 0; i < p_dataset->sample_count; i++)
+        {
+            astronode_aggregator_add_sample(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, dataset_get_sample(p_dataset, i)[channel]);
+        }
+        astronode_aggregator_flush(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR);
+
+        printf("  %-12s aggregator %u bytes in %u summaries\n", p_dataset->p_names[channel], g_summary_length, g_summary_count);
+
+        uint32_t length = downsample_channel(p_dataset, channel, ASTRONODE_DOWNSAMPLER_MODE_DEADBAND, error_bound, &point_count);
+
+        printf("  %-12s deadband %u bytes in %u points (%.1f %% of the samples)\n", "",
+               length, point_count, 100.0 * point_count / p_dataset->sample_count);
+
+        length = downsample_channel(p_dataset, channel, ASTRONODE_DOWNSAMPLER_MODE_SWINGING_DOOR, error_bound, &point_count);
+
+        printf("  %-12s swinging door %u bytes in %u points (%.1f %% of the samples)\n", "",
+               length, point_count, 100.0 * point_count / p_dataset->sample_count);
+    }
+
+    uint64_t start_ns = get_time_ns();
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        for (uint32_t j = 0; j < p_dataset->sample_count; j++)
+        {
+            astronode_aggregator_add_sample(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, dataset_get_sample(p_dataset, j)[0]);
+        }
+    }
+
+    uint64_t aggregate_ns = get_time_ns() - start_ns;
+
+    start_ns = get_time_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        downsample_channel(p_dataset, 0, ASTRONODE_DOWNSAMPLER_MODE_SWINGING_DOOR, error_bound, &point_count);
+    }
+
+    uint64_t downsample_ns = get_time_ns() - start_ns;
+
+    printf("  throughput   aggregate %.2f Msamples/s, swinging door %.2f Msamples/s\n",
+           (double) p_dataset->sample_count * iterations / (aggregate_ns / 1e3),
+           (double) p_dataset->sample_count * iterations / (downsample_ns / 1e3));
+}
+
+static uint32_t unpack_payload(const uint8_t *p_data, uint16_t length, const dataset_t *p_dataset, uint32_t first_sample, FILE *p_output)
+{
+    astronode_unpacker_t unpacker;
+    astronode_packer_header_t header;
+    int32_t p_values[ASTRONODE_PACKER_MAX_CHANNELS];
+    uint32_t count = 0;
+
+    if (astronode_unpacker_init(&unpacker, p_data, length, &header) != RS_SUCCESS)
+    {
+        return 0;
+    }
+
+    while (unpacker.index < length && astronode_unpacker_next_sample(&unpacker, p_values) == RS_SUCCESS)
+    {
+        uint32_t time_s = header.base_timestamp + count * header.sample_interval;
+
+        if (p_dataset != NULL
+            && (first_sample + count >= p_dataset->sample_count
+                || header.channel_count != p_dataset->channel_count
+                || time_s != p_dataset->p_times[first_sample + count]
+                || memcmp(p_values, dataset_get_sample(p_dataset, first_sample + count), header.channel_count * sizeof(int32_t)) != 0))
+        {
+            return 0;
+        }
+
+        if (p_output != NULL)
+        {
+            fprintf(p_output, "%u", time_s);
+            for (uint8_t i = 0; i < header.channel_count; i++)
+            {
+                fprintf(p_output, ",%d", p_values[i]);
+            }
+            fprintf(p_output, "\n");
+        }
+        count++;
+    }
+
+    return unpacker.index == length ? count : 0;
+}
+
+static int benchmark(const char *p_path, uint16_t payload_capacity, uint32_t error_bound, uint32_t iterations)
+{
+    dataset_t dataset;
+    codec_payloads_t payloads = { 0 };
+    uint32_t sample_index = 0;
+
+    if (dataset_load(&dataset, p_path) != RS_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Time of the samples and one int32 per channel, as they are held by the asset.
+    uint32_t raw_length = dataset.sample_count * (1 + dataset.channel_count) * sizeof(int32_t);
+
+    if (pack_dataset(&dataset, payload_capacity, &payloads) != RS_SUCCESS)
+    {
+        fprintf(stderr, "%s: packing failed.\n", p_path);
+        dataset_free(&dataset);
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t i = 0; i < payloads.count; i++)
+    {
+        uint32_t count = unpack_payload(payloads.p_payloads[i].p_data, payloads.p_payloads[i].length, &dataset, sample_index, NULL);
+
+        if (count == 0)
+        {
+            fprintf(stderr, "%s: payload %u does not unpack to the dataset.\n", p_path, i);
+            free(payloads.p_payloads);
+            dataset_free(&dataset);
+            return EXIT_FAILURE;
+        }
+        sample_index += count;
+    }
+
+    if (sample_index != dataset.sample_count)
+    {
+        fprintf(stderr, "%s: %u samples unpacked.\n", p_path, sample_index);
+        free(payloads.p_payloads);
+        dataset_free(&dataset);
+        return EXIT_FAILURE;
+    }
+
+    uint64_t start_ns = get_time_ns();
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        pack_dataset(&dataset, payload_capacity, &payloads);
+    }
+
+    uint64_t pack_ns = get_time_ns() - start_ns;
+
+    start_ns = get_time_ns();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        for (uint32_t j = 0; j < payloads.count; j++)
+        {
+            unpack_payload(payloads.p_payloads[j].p_data, payloads.p_payloads[j].length, NULL, 0, NULL);
+        }
+    }
+
+    uint64_t unpack_ns = get_time_ns() - start_ns;
+
+    printf("%s: %u samples of %u channels\n", p_path, dataset.sample_count, dataset.channel_count);
+    printf("  raw          %7u bytes (int32 time and values), CSV %u bytes\n", raw_length, dataset.text_length);
+    printf("  packer       %7u bytes in %u payloads of at most %u bytes, ratio %.2f (%.1f %% of raw)\n",
+           payloads.total_length, payloads.count, payload_capacity,
+           (double) raw_length / payloads.total_length, 100.0 * payloads.total_length / raw_length);
+    printf("  throughput   pack %.2f Msamples/s, unpack %.2f Msamples/s\n",
+           (double) dataset.sample_count * iterations / (pack_ns / 1e3),
+           (double) dataset.sample_count * iterations / (unpack_ns / 1e3));
+
+    // The LZSS stage adds its flag byte: the payloads are packed one byte shorter.
+    if (pack_dataset(&dataset, payload_capacity - 1, &payloads) == RS_SUCCESS)
+    {
+        print_compression("packer+lzss", &payloads, ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS, raw_length, iterations);
+        print_compression("packer+dict", &payloads, ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS_DICTIONARY, raw_length, iterations);
+    }
+    if (format_dataset(&dataset, payload_capacity - 1, &payloads) == RS_SUCCESS)
+    {
+        printf("  text         %7u bytes in %u payloads\n", payloads.total_length, payloads.count);
+        print_compression("text+lzss", &payloads, ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS, raw_length, iterations);
+        print_compression("text+dict", &payloads, ASTRONODE_PAYLOAD_POLICY_COMPRESSION_LZSS_DICTIONARY, raw_length, iterations);
+    }
+    print_reduction(&dataset, error_bound, iterations);
+
+    free(payloads.p_payloads);
+    dataset_free(&dataset);
+
+    return EXIT_SUCCESS;
+}
+
+static int encode(const char *p_path, uint16_t payload_capacity, uint8_t compression)
+{
+    dataset_t dataset;
+    codec_payloads_t packed = { 0 };
+    codec_payloads_t payloads = { 0 };
+    int status = EXIT_SUCCESS;
+
+    if (dataset_load(&dataset, p_path) != RS_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (compression == ASTRONODE_PAYLOAD_POLICY_COMPRESSION_NONE
+        ? pack_dataset(&dataset, payload_capacity, &payloads) == RS_SUCCESS
+        : pack_dataset(&dataset, payload_capacity - 1, &packed) == RS_SUCCESS
+          && compress_payloads(&packed, compression, &payloads) == RS_SUCCESS)
+    {
+        for (uint32_t i = 0; i < payloads.count; i++)
+        {
+            for (uint16_t j = 0; j < payloads.p_payloads[i].length; j++)
+            {
+                printf("%02X", payloads.p_payloads[i].p_data[j]);
+            }
+            printf("\n");
+        }
+    }
+    else
+    {
+        fprintf(stderr, "%s: packing failed.\n", p_path);
+        status = EXIT_FAILURE;
+    }
+
+    free(packed.p_payloads);
+    free(payloads.p_payloads);
+    dataset_free(&dataset);
+
+    return status;
+}
+
+static int decode(FILE *p_input, bool is_compressed)
+{
+    char p_line[CODEC_LINE_MAX_LEN_BYTES + 1];
+    uint8_t p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint8_t p_packed[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint32_t line_number = 0;
+    int status = EXIT_SUCCESS;
+
+    printf("time_s,values...\n");
+    while (fgets(p_line, sizeof(p_line), p_input) != NULL)
+    {
+        uint16_t length = 0;
+        unsigned int byte = 0;
+
+        line_number++;
+        while (length < sizeof(p_payload) && sscanf(&p_line[2 * length], "%2x", &byte) == 1)
+        {
+            p_payload[length++] = byte;
+        }
+
+        if (length == 0)
+        {
+            continue;
+        }
+
+        if (is_compressed)
+        {
+            uint16_t packed_length = 0;
+
+            if (astronode_decompress(p_payload, length, p_packed, sizeof(p_packed), &packed_length) != RS_SUCCESS)
+            {
+                fprintf(stderr, "Line %u: invalid compressed payload.\n", line_number);
+                status = EXIT_FAILURE;
+                continue;
+            }
+            memcpy(p_payload, p_packed, packed_length);
+            length = packed_length;
+        }
+
+        if (unpack_payload(p_payload, length, NULL, 0, stdout) == 0)
+        {
+            fprintf(stderr, "Line %u: invalid payload.\n", line_number);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
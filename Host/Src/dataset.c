@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Astrocast
+#include "dataset.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define DATASET_LINE_MAX_LEN_BYTES  512
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static return_status_t parse_header(dataset_t *p_dataset, char *p_line);
+static return_status_t add_sample(dataset_t *p_dataset, char *p_line, uint32_t *p_capacity);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+return_status_t dataset_load(dataset_t *p_dataset, const char *p_path)
+{
+    FILE *p_input = fopen(p_path, "r");
+    char p_line[DATASET_LINE_MAX_LEN_BYTES];
+    uint32_t capacity = 0;
+    uint32_t line_number = 0;
+    return_status_t status = RS_SUCCESS;
+
+    memset(p_dataset, 0, sizeof(dataset_t));
+    if (p_input == NULL)
+    {
+        perror(p_path);
+        return RS_FAILURE;
+    }
+
+    while (status == RS_SUCCESS && fgets(p_line, sizeof(p_line), p_input) != NULL)
+    {
+        line_number++;
+        if (p_line[0] == '#' || p_line[0] == '\n')
+        {
+            continue;
+        }
+
+        p_dataset->text_length += strlen(p_line);
+        if (p_dataset->channel_count == 0)
+        {
+            status = parse_header(p_dataset, p_line);
+        }
+        else
+        {
+            status = add_sample(p_dataset, p_line, &capacity);
+        }
+    }
+    fclose(p_input);
+
+    if (status != RS_SUCCESS || p_dataset->sample_count == 0)
+    {
+        fprintf(stderr, "%s:%u: invalid dataset line.\n", p_path, line_number);
+        dataset_free(p_dataset);
+        return RS_FAILURE;
+    }
+
+    return RS_SUCCESS;
+}
+
+void dataset_free(dataset_t *p_dataset)
+{
+    free(p_dataset->p_times);
+    free(p_dataset->p_values);
+    memset(p_dataset, 0, sizeof(dataset_t));
+}
+
+const int32_t *dataset_get_sample(const dataset_t *p_dataset, uint32_t index)
+{
+    return &p_dataset->p_values[index * p_dataset->channel_count];
+}
+
+static return_status_t parse_header(dataset_t *p_dataset, char *p_line)
+{
+    // The first column is the time.
+    char *p_field = strtok(p_line, ",\n");
+
+    while ((p_field = strtok(NULL, ",\n")) != NULL)
+    {
+        if (p_dataset->channel_count == DATASET_MAX_CHANNELS)
+        {
+            return RS_FAILURE;
+        }
+        snprintf(p_dataset->p_names[p_dataset->channel_count++], DATASET_NAME_MAX_LEN_BYTES, "%s", p_field);
+    }
+
+    return p_dataset->channel_count > 0 ? RS_SUCCESS : RS_FAILURE;
+}
+
+static return_status_t add_sample(dataset_t *p_dataset, char *p_line, uint32_t *p_capacity)
+{
+    char *p_end = NULL;
+
+    if (p_dataset->sample_count == *p_capacity)
+    {
+        uint32_t capacity = *p_capacity > 0 ? 2 * *p_capacity : 256;
+        uint32_t *p_times = realloc(p_dataset->p_times, capacity * sizeof(uint32_t));
+        int32_t *p_values = realloc(p_dataset->p_values, capacity * p_dataset->channel_count * sizeof(int32_t));
+
+        if (p_times != NULL)
+        {
+            p_dataset->p_times = p_times;
+        }
+        if (p_values != NULL)
+        {
+            p_dataset->p_values = p_values;
+        }
+        if (p_times == NULL || p_values == NULL)
+        {
+            return RS_FAILURE;
+        }
+        *p_capacity = capacity;
+    }
+
+    int32_t *p_values = &p_dataset->p_values[p_dataset->sample_count * p_dataset->channel_count];
+
+    p_dataset->p_times[p_dataset->sample_count] = strtoul(p_line, &p_end, 10);
+    for (uint8_t i = 0; i < p_dataset->channel_count; i++)
+    {
+        if (*p_end != ',')
+        {
+            return RS_FAILURE;
+        }
+        p_values[i] = strtol(p_end + 1, &p_end, 10);
+    }
+    p_dataset->sample_count++;
+
+    return RS_SUCCESS;
+}
@@ -0,0 +1,364 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>  // memset
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_context.h"
+#include "astronode_board.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static astronode_posix_port_t g_default_port = { .fd = -1 };
+
+static uint8_t g_number_of_message_to_send = 0;
+static bool g_is_stdin_open = true;
+static bool g_is_debug_logs_enabled = true;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void send_astronode_request_on_port(void *p_port, uint8_t *p_tx_buffer, uint32_t length);
+static bool is_astronode_character_received_on_port(void *p_port, uint8_t *p_rx_char);
+static bool is_evt_pin_high_on_port(void *p_port);
+static void reset_astronode_on_port(void *p_port);
+static void read_stdin_lines(void);
+#if ASTRONODE_POSIX_RESET_MODEM_LINE != 0
+static void sleep_ms(uint32_t duration);
+#endif
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+return_status_t open_astronode_port(astronode_posix_port_t *p_port, const char *p_device)
+{
+    struct termios tty;
+
+    memset(p_port, 0, sizeof(astronode_posix_port_t));
+    p_port->fd = open(p_device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (p_port->fd < 0)
+    {
+        perror(p_device);
+        return RS_FAILURE;
+    }
+
+    if (tcgetattr(p_port->fd, &tty) != 0)
+    {
+        perror(p_device);
+        close_astronode_port(p_port);
+        return RS_FAILURE;
+    }
+
+    cfmakeraw(&tty);
+    tty.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+    cfsetispeed(&tty, B9600);
+    cfsetospeed(&tty, B9600);
+
+    if (tcsetattr(p_port->fd, TCSANOW, &tty) != 0)
+    {
+        perror(p_device);
+        close_astronode_port(p_port);
+        return RS_FAILURE;
+    }
+    tcflush(p_port->fd, TCIOFLUSH);
+
+    return RS_SUCCESS;
+}
+
+void close_astronode_port(astronode_posix_port_t *p_port)
+{
+    if (p_port->fd >= 0)
+    {
+        close(p_port->fd);
+    }
+    p_port->fd = -1;
+}
+
+astronode_posix_port_t *get_default_astronode_port(void)
+{
+    return &g_default_port;
+}
+
+void set_debug_logs_enabled(bool is_enabled)
+{
+    g_is_debug_logs_enabled = is_enabled;
+}
+
+void init_drivers(void)
+{
+    // Lines written on the standard input play the role of the button of the example board.
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+}
+
+void send_debug_logs(char *p_tx_buffer)
+{
+    if (g_is_debug_logs_enabled)
+    {
+        fprintf(stderr, "%s\n", p_tx_buffer);
+    }
+}
+
+void send_astronode_request(uint8_t *p_tx_buffer, uint32_t length)
+{
+    send_astronode_request_on_port(&g_default_port, p_tx_buffer, length);
+}
+
+bool is_astronode_character_received(uint8_t *p_rx_char)
+{
+    return is_astronode_character_received_on_port(&g_default_port, p_rx_char);
+}
+
+const astronode_uart_ops_t *get_astronode_uart_ops(void)
+{
+    static const astronode_uart_ops_t uart_ops =
+    {
+        .send_request = send_astronode_request_on_port,
+        .is_character_received = is_astronode_character_received_on_port,
+        .is_evt_pin_high = is_evt_pin_high_on_port,
+        .reset = reset_astronode_on_port
+    };
+
+    return &uart_ops;
+}
+
+bool is_message_available(void)
+{
+    read_stdin_lines();
+
+    if (g_number_of_message_to_send > 0)
+    {
+        g_number_of_message_to_send--;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool is_evt_pin_high(void)
+{
+    return is_evt_pin_high_on_port(&g_default_port);
+}
+
+void reset_astronode(void)
+{
+    reset_astronode_on_port(&g_default_port);
+}
+
+int32_t read_sensor_value(void)
+{
+    // The gateway has no sensor: replace with the acquisition of the asset sensor.
+    return 0;
+}
+
+uint32_t get_device_uid(void)
+{
+    // The process ID tells apart the gateways of a same host.
+    return (uint32_t) gethostid() ^ (uint32_t) getpid();
+}
+
+uint32_t get_systick(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000);
+}
+
+bool is_systick_timeout_over(uint32_t starting_value, uint16_t duration)
+{
+    return (get_systick() - starting_value > duration) ? true : false;
+}
+
+void enter_sleep_mode(uint32_t duration)
+{
+    uint32_t starting_value = get_systick();
+
+    // Woken up by a line on the standard input, like the button of the example board.
+    while (get_systick() - starting_value < duration)
+    {
+        read_stdin_lines();
+        if (is_evt_pin_high() || g_number_of_message_to_send > 0)
+        {
+            return;
+        }
+
+        struct pollfd stdin_poll = { .fd = g_is_stdin_open ? STDIN_FILENO : -1, .events = POLLIN };
+        uint32_t remaining = duration - (get_systick() - starting_value);
+
+        poll(&stdin_poll, 1, remaining > 100 ? 100 : (int) remaining);
+    }
+}
+
+void wait_in_sleep_mode(uint32_t duration)
+{
+    struct timespec delay = { .tv_sec = duration / 1000, .tv_nsec = (long) (duration % 1000) * 1000000 };
+
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR)
+    {
+    }
+}
+
+static void send_astronode_request_on_port(void *p_port, uint8_t *p_tx_buffer, uint32_t length)
+{
+    astronode_posix_port_t *p_posix_port = (astronode_posix_port_t *) p_port;
+    uint32_t sent = 0;
+
+    send_debug_logs("Message sent to the Astronode --> ");
+    send_debug_logs((char *) p_tx_buffer);
+
+    // Bytes left from a previous answer would be taken as the start of the next one.
+    p_posix_port->rx_length = 0;
+    p_posix_port->rx_index = 0;
+    tcflush(p_posix_port->fd, TCIFLUSH);
+
+    while (sent < length)
+    {
+        ssize_t written = write(p_posix_port->fd, p_tx_buffer + sent, length - sent);
+
+        if (written > 0)
+        {
+            sent += (uint32_t) written;
+        }
+        else if (written < 0 && errno != EAGAIN && errno != EINTR)
+        {
+            send_debug_logs("[ERROR] Serial port write failed.");
+            return;
+        }
+        else
+        {
+            struct pollfd tx_poll = { .fd = p_posix_port->fd, .events = POLLOUT };
+
+            poll(&tx_poll, 1, ASTRONODE_POSIX_CHARACTER_POLL_MS);
+        }
+    }
+
+    // The answer timeout starts once the request has left the UART, not the kernel buffer.
+    tcdrain(p_posix_port->fd);
+
+    if (length > 2
+        && p_tx_buffer[0] == ASTRONODE_TRANSPORT_STX
+        && p_tx_buffer[1] == '6'
+        && p_tx_buffer[2] == '5')
+    {
+        // EVT_RR: the emulated EVT pin goes low until the next poll period.
+        p_posix_port->evt_rr_time_ms = get_systick();
+    }
+}
+
+static bool is_astronode_character_received_on_port(void *p_port, uint8_t *p_rx_char)
+{
+    astronode_posix_port_t *p_posix_port = (astronode_posix_port_t *) p_port;
+
+    if (p_posix_port->rx_index >= p_posix_port->rx_length)
+    {
+        struct pollfd rx_poll = { .fd = p_posix_port->fd, .events = POLLIN };
+
+        if (poll(&rx_poll, 1, ASTRONODE_POSIX_CHARACTER_POLL_MS) <= 0)
+        {
+            return false;
+        }
+
+        ssize_t received = read(p_posix_port->fd, p_posix_port->p_rx_buffer, ASTRONODE_POSIX_RX_BUFFER_LEN_BYTES);
+
+        if (received <= 0)
+        {
+            return false;
+        }
+        p_posix_port->rx_length = (uint16_t) received;
+        p_posix_port->rx_index = 0;
+    }
+
+    *p_rx_char = p_posix_port->p_rx_buffer[p_posix_port->rx_index++];
+
+    return true;
+}
+
+static bool is_evt_pin_high_on_port(void *p_port)
+{
+    astronode_posix_port_t *p_posix_port = (astronode_posix_port_t *) p_port;
+
+#if ASTRONODE_POSIX_EVT_MODEM_LINE != 0
+    int modem_lines = 0;
+
+    if (ioctl(p_posix_port->fd, TIOCMGET, &modem_lines) != 0)
+    {
+        return false;
+    }
+
+    return (modem_lines & ASTRONODE_POSIX_EVT_MODEM_LINE) ? true : false;
+#else
+    return (get_systick() - p_posix_port->evt_rr_time_ms >= ASTRONODE_POSIX_EVT_POLL_PERIOD_MS) ? true : false;
+#endif
+}
+
+static void reset_astronode_on_port(void *p_port)
+{
+#if ASTRONODE_POSIX_RESET_MODEM_LINE != 0
+    astronode_posix_port_t *p_posix_port = (astronode_posix_port_t *) p_port;
+    int modem_line = ASTRONODE_POSIX_RESET_MODEM_LINE;
+
+    ioctl(p_posix_port->fd, TIOCMBIS, &modem_line);
+    sleep_ms(1);
+    ioctl(p_posix_port->fd, TIOCMBIC, &modem_line);
+    sleep_ms(250);
+#else
+    (void) p_port;
+    send_debug_logs("No reset line, the Astronode is not reset.");
+#endif
+}
+
+static void read_stdin_lines(void)
+{
+    char p_line[ASTRONODE_POSIX_RX_BUFFER_LEN_BYTES];
+    ssize_t length = 0;
+
+    while (g_is_stdin_open && (length = read(STDIN_FILENO, p_line, sizeof(p_line))) != 0)
+    {
+        if (length < 0)
+        {
+            return;
+        }
+        for (ssize_t i = 0; i < length; i++)
+        {
+            if (p_line[i] == '\n' && g_number_of_message_to_send < UINT8_MAX)
+            {
+                g_number_of_message_to_send++;
+            }
+        }
+    }
+
+    g_is_stdin_open = false;
+}
+
+#if ASTRONODE_POSIX_RESET_MODEM_LINE != 0
+static void sleep_ms(uint32_t duration)
+{
+    struct timespec delay = { .tv_sec = duration / 1000, .tv_nsec = (long) (duration % 1000) * 1000000 };
+
+    nanosleep(&delay, NULL);
+}
+#endif
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// Astrocast
+#include "astronode_emulator.h"
+#include "drivers.h"
+#include "emulator_link.h"
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint64_t get_time_us(void);
+static void send_request_to_emulator(void *p_port, uint8_t *p_data, uint32_t length);
+static bool is_character_received_from_emulator(void *p_port, uint8_t *p_rx_char);
+static bool is_emulator_evt_pin_high(void *p_port);
+static void reset_emulator(void *p_port);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const astronode_uart_ops_t g_emulator_uart_ops =
+{
+    .send_request = send_request_to_emulator,
+    .is_character_received = is_character_received_from_emulator,
+    .is_evt_pin_high = is_emulator_evt_pin_high,
+    .reset = reset_emulator
+};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void emulator_link_init(emulator_link_t *p_link, const astronode_emulator_config_t *p_config)
+{
+    memset(p_link, 0, sizeof(emulator_link_t));
+    astronode_emulator_init(&p_link->emulator, p_config, get_systick());
+}
+
+const astronode_uart_ops_t *get_emulator_link_uart_ops(void)
+{
+    return &g_emulator_uart_ops;
+}
+
+static uint64_t get_time_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+static void send_request_to_emulator(void *p_port, uint8_t *p_data, uint32_t length)
+{
+    emulator_link_t *p_link = p_port;
+    uint32_t transfer_time_us = astronode_emulator_get_transfer_time_us(&p_link->emulator, length);
+
+    // Blocking transmission, as the UART driver of the target.
+    if (transfer_time_us > 0 && p_link->is_tx_buffered == false)
+    {
+        struct timespec duration = { transfer_time_us / 1000000, (transfer_time_us % 1000000) * 1000 };
+
+        nanosleep(&duration, NULL);
+    }
+
+    astronode_emulator_run(&p_link->emulator, get_systick());
+
+    p_link->answer_length = 0;
+    p_link->answer_index = 0;
+    p_link->answer_start_us = get_time_us() + (uint64_t) p_link->emulator.config.latency_ms * 1000;
+    if (p_link->is_tx_buffered)
+    {
+        p_link->answer_start_us += transfer_time_us;
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint16_t answer_length = astronode_emulator_receive_byte(&p_link->emulator, p_data[i], p_link->p_answer);
+
+        if (answer_length > 0)
+        {
+            p_link->answer_length = astronode_emulator_inject_faults(&p_link->emulator, p_link->p_answer, answer_length);
+        }
+    }
+}
+
+static bool is_character_received_from_emulator(void *p_port, uint8_t *p_rx_char)
+{
+    emulator_link_t *p_link = p_port;
+
+    // Each byte is received once fully shifted in at the baud rate.
+    if (p_link->answer_index < p_link->answer_length
+        && get_time_us() >= p_link->answer_start_us
+                            + astronode_emulator_get_transfer_time_us(&p_link->emulator, p_link->answer_index + 1))
+    {
+        *p_rx_char = p_link->p_answer[p_link->answer_index++];
+        return true;
+    }
+    return false;
+}
+
+static bool is_emulator_evt_pin_high(void *p_port)
+{
+    emulator_link_t *p_link = p_port;
+
+    return astronode_emulator_is_evt_pin_high(&p_link->emulator);
+}
+
+static void reset_emulator(void *p_port)
+{
+    emulator_link_t *p_link = p_port;
+
+    astronode_emulator_reset(&p_link->emulator, get_systick());
+    p_link->answer_length = 0;
+}
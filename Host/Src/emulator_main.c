@@ -0,0 +1,345 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_emulator.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define EMULATOR_POLL_PERIOD_MS 1
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static volatile sig_atomic_t g_is_reset_requested = 0;
+static volatile sig_atomic_t g_is_stop_requested = 0;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void print_usage(const char *p_program);
+static void handle_signal(int signal_number);
+static uint64_t get_time_us(int clock_id);
+static void sleep_until_us(uint64_t time_us);
+static int open_pty(char *p_slave_name, size_t slave_name_length, int *p_slave_fd);
+static void send_answer(astronode_emulator_t *p_emulator, int fd, uint8_t *p_answer, uint16_t length, uint64_t start_us);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    astronode_emulator_config_t config =
+    {
+        .baud_rate = 9600,
+        .latency_ms = 5,
+        .ack_delay_ms = 2000
+    };
+    const char *p_link = NULL;
+    uint32_t command_period_ms = 0;
+    bool is_verbose = false;
+    int option = 0;
+
+    while ((option = getopt(argc, argv, "b:l:c:d:s:a:p:w:m:L:vh")) != -1)
+    {
+        switch (option)
+        {
+            case 'b':
+                config.baud_rate = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'l':
+                config.latency_ms = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'c':
+                config.crc_error_per_mille = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'd':
+                config.drop_per_mille = strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                config.seed = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'a':
+                config.ack_delay_ms = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'p':
+                config.pass_period_ms = strtoul(optarg, NULL, 0) * 1000;
+                break;
+
+            case 'w':
+                config.pass_duration_ms = strtoul(optarg, NULL, 0) * 1000;
+                break;
+
+            case 'm':
+                command_period_ms = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'L':
+                p_link = optarg;
+                break;
+
+            case 'v':
+                is_verbose = true;
+                break;
+
+            default:
+                print_usage(argv[0]);
+                return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    char slave_name[128];
+    int slave_fd = -1;
+    int master_fd = open_pty(slave_name, sizeof(slave_name), &slave_fd);
+
+    if (master_fd < 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (p_link != NULL)
+    {
+        unlink(p_link);
+        if (symlink(slave_name, p_link) != 0)
+        {
+            perror(p_link);
+            return EXIT_FAILURE;
+        }
+    }
+
+    signal(SIGUSR1, handle_signal);
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+
+    // Only differences of the monotonic clock are used, the RTC follows the real time clock.
+    uint64_t now_us = get_time_us(CLOCK_MONOTONIC);
+    config.epoch_offset_ms = (int64_t) (get_time_us(CLOCK_REALTIME) / 1000)
+                             - (int64_t) ASTRONODE_EMULATOR_ASTROCAST_EPOCH * 1000
+                             - (int64_t) (uint32_t) (now_us / 1000);
+
+    astronode_emulator_t emulator;
+    astronode_emulator_init(&emulator, &config, (uint32_t) (now_us / 1000));
+
+    printf("%s\n", slave_name);
+    fflush(stdout);
+
+    uint8_t p_answer[ASTRONODE_MAX_LENGTH_RESPONSE];
+    uint64_t request_start_us = 0;
+    uint16_t request_length = 0;
+    uint64_t last_command_us = now_us;
+    uint32_t command_counter = 0;
+    bool is_evt_pin_high = false;
+
+    while (g_is_stop_requested == 0)
+    {
+        struct pollfd rx_poll = { .fd = master_fd, .events = POLLIN };
+        uint8_t p_rx_buffer[64];
+        ssize_t received = 0;
+
+        if (poll(&rx_poll, 1, EMULATOR_POLL_PERIOD_MS) > 0)
+        {
+            received = read(master_fd, p_rx_buffer, sizeof(p_rx_buffer));
+        }
+
+        now_us = get_time_us(CLOCK_MONOTONIC);
+        astronode_emulator_run(&emulator, (uint32_t) (now_us / 1000));
+
+        if (g_is_reset_requested)
+        {
+            g_is_reset_requested = 0;
+            astronode_emulator_reset(&emulator, (uint32_t) (now_us / 1000));
+            fprintf(stderr, "Reset.\n");
+        }
+
+        if (command_period_ms > 0 && now_us - last_command_us >= (uint64_t) command_period_ms * 1000)
+        {
+            uint8_t p_command[ASTRONODE_APP_COMMAND_SHORT_LEN_BYTES] = {0};
+
+            command_counter++;
+            for (uint8_t i = 0; i < 4; i++)
+            {
+                p_command[ASTRONODE_APP_COMMAND_SHORT_LEN_BYTES - 1 - i] = (uint8_t) (command_counter >> (8 * i));
+            }
+            astronode_emulator_add_command(&emulator, p_command, sizeof(p_command));
+            last_command_us = now_us;
+        }
+
+        if (astronode_emulator_is_evt_pin_high(&emulator) != is_evt_pin_high)
+        {
+            is_evt_pin_high = !is_evt_pin_high;
+            if (is_verbose)
+            {
+                fprintf(stderr, "EVT pin %s.\n", is_evt_pin_high ? "high" : "low");
+            }
+        }
+
+        for (ssize_t i = 0; i < received; i++)
+        {
+            if (p_rx_buffer[i] == ASTRONODE_TRANSPORT_STX)
+            {
+                request_start_us = now_us;
+                request_length = 0;
+            }
+            request_length++;
+
+            uint16_t answer_length = astronode_emulator_receive_byte(&emulator, p_rx_buffer[i], p_answer);
+
+            if (answer_length == 0)
+            {
+                continue;
+            }
+
+            if (is_verbose)
+            {
+                fprintf(stderr, "<-- %.*s\n--> %.*s\n", request_length - 2, &emulator.p_request[1], answer_length - 2, &p_answer[1]);
+            }
+
+            // The request is taken as received at the configured baud rate, then processed.
+            uint64_t answer_start_us = request_start_us
+                                       + astronode_emulator_get_transfer_time_us(&emulator, request_length)
+                                       + (uint64_t) config.latency_ms * 1000;
+
+            answer_length = astronode_emulator_inject_faults(&emulator, p_answer, answer_length);
+            send_answer(&emulator, master_fd, p_answer, answer_length, answer_start_us);
+        }
+    }
+
+    if (p_link != NULL)
+    {
+        unlink(p_link);
+    }
+    close(slave_fd);
+    close(master_fd);
+
+    return EXIT_SUCCESS;
+}
+
+static void print_usage(const char *p_program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "Emulate an Astronode on a pseudo-terminal, the slave device is printed on the standard output.\n"
+            "  -b <baud>    byte pacing of the serial link, 0 to disable (default 9600)\n"
+            "  -l <ms>      latency between a request and its answer (default 5)\n"
+            "  -c <permil>  answers sent with a corrupted CRC\n"
+            "  -d <permil>  bytes of the answers dropped\n"
+            "  -s <seed>    seed of the fault injection\n"
+            "  -a <ms>      delay to send and acknowledge each queued payload (default 2000)\n"
+            "  -p <s>       period of the satellite passes, 0 for a continuous coverage (default 0)\n"
+            "  -w <s>       duration of the satellite passes\n"
+            "  -m <ms>      period of the downlink commands, 0 for none (default 0)\n"
+            "  -L <path>    symbolic link to the slave device\n"
+            "  -v           log the requests, the answers and the EVT pin\n"
+            "SIGUSR1 resets the emulated module.\n",
+            p_program);
+}
+
+static void handle_signal(int signal_number)
+{
+    if (signal_number == SIGUSR1)
+    {
+        g_is_reset_requested = 1;
+    }
+    else
+    {
+        g_is_stop_requested = 1;
+    }
+}
+
+static uint64_t get_time_us(int clock_id)
+{
+    struct timespec now;
+
+    clock_gettime(clock_id, &now);
+
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+static void sleep_until_us(uint64_t time_us)
+{
+    struct timespec deadline = { .tv_sec = time_us / 1000000, .tv_nsec = (long) (time_us % 1000000) * 1000 };
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+    {
+    }
+}
+
+static int open_pty(char *p_slave_name, size_t slave_name_length, int *p_slave_fd)
+{
+    int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    struct termios tty;
+
+    if (master_fd < 0 || grantpt(master_fd) != 0 || unlockpt(master_fd) != 0)
+    {
+        perror("pty");
+        return -1;
+    }
+    snprintf(p_slave_name, slave_name_length, "%s", ptsname(master_fd));
+
+    // The slave stays open so that the asset can close and reopen it, and it is raw
+    // from the start so that no byte is echoed or translated before the asset opens it.
+    *p_slave_fd = open(p_slave_name, O_RDWR | O_NOCTTY);
+    if (*p_slave_fd < 0 || tcgetattr(*p_slave_fd, &tty) != 0)
+    {
+        perror(p_slave_name);
+        close(master_fd);
+        return -1;
+    }
+    cfmakeraw(&tty);
+    tcsetattr(*p_slave_fd, TCSANOW, &tty);
+
+    return master_fd;
+}
+
+static void send_answer(astronode_emulator_t *p_emulator, int fd, uint8_t *p_answer, uint16_t length, uint64_t start_us)
+{
+    uint16_t sent = 0;
+
+    sleep_until_us(start_us);
+
+    while (sent < length)
+    {
+        // Each byte leaves when it would have been fully shifted out at the baud rate,
+        // without pacing the whole answer is written at once.
+        uint16_t count = p_emulator->config.baud_rate > 0 ? 1 : length - sent;
+        ssize_t written = 0;
+
+        sleep_until_us(start_us + astronode_emulator_get_transfer_time_us(p_emulator, sent + count));
+
+        written = write(fd, &p_answer[sent], count);
+        if (written > 0)
+        {
+            sent += (uint16_t) written;
+        }
+        else if (errno != EAGAIN && errno != EINTR)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// Astrocast
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_downlink.h"
+#include "astronode_event.h"
+#include "astronode_board.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define HOUSEKEEPING_PERIOD_MS 60000
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+astronode_ctx_t g_astronode_ctx;
+
+uint16_t g_message_counter = 0;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void acknowledge_payload(uint16_t payload_id);
+astronode_downlink_result_t handle_log_command(const uint8_t *p_data, uint8_t length);
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <serial device>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    init_drivers();
+    if (open_astronode_port(get_default_astronode_port(), argv[1]) != RS_SUCCESS)
+    {
+        return EXIT_FAILURE;
+    }
+    astronode_ctx_init(&g_astronode_ctx, get_astronode_uart_ops(), get_default_astronode_port());
+
+    send_debug_logs("Start the gateway, press enter to send a message...");
+
+    reset_astronode();
+
+    astronode_send_cfg_wr(&g_astronode_ctx, true, false, true, true, true, true, true, false);
+    astronode_send_mgi_rr(&g_astronode_ctx);
+    astronode_send_msn_rr(&g_astronode_ctx);
+
+    astronode_downlink_init(&g_astronode_ctx);
+    astronode_event_init(&g_astronode_ctx, acknowledge_payload);
+
+    uint32_t housekeeping_timer = get_systick();
+
+    while (1)
+    {
+        if (is_evt_pin_high() && astronode_downlink_is_pending() == false)
+        {
+            astronode_event_process();
+        }
+        else if (is_message_available())
+        {
+            char payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES] = {0};
+
+            g_message_counter++;
+            sprintf(payload, "Gateway message %d", g_message_counter);
+            astronode_send_pld_er(&g_astronode_ctx,
+                                  astronode_ctx_allocate_payload_id(&g_astronode_ctx),
+                                  payload,
+                                  strlen(payload));
+        }
+        else if (astronode_downlink_is_pending())
+        {
+            astronode_downlink_process();
+        }
+        else
+        {
+            enter_sleep_mode(HOUSEKEEPING_PERIOD_MS - (get_systick() - housekeeping_timer));
+        }
+
+        if (get_systick() - housekeeping_timer >= HOUSEKEEPING_PERIOD_MS)
+        {
+            astronode_send_per_rr(&g_astronode_ctx);
+            housekeeping_timer = get_systick();
+        }
+    }
+}
+
+static void acknowledge_payload(uint16_t payload_id)
+{
+    char str[64];
+
+    sprintf(str, "Message %d has been acknowledged.", payload_id);
+    send_debug_logs(str);
+}
+
+astronode_downlink_result_t handle_log_command(const uint8_t *p_data, uint8_t length)
+{
+    char str[2 * ASTRONODE_APP_COMMAND_MAX_LEN_BYTES + 32] = "Command received: ";
+    size_t offset = strlen(str);
+
+    for (uint8_t i = 0; i < length; i++)
+    {
+        offset += sprintf(str + offset, "%02X", p_data[i]);
+    }
+    send_debug_logs(str);
+
+    return ASTRONODE_DOWNLINK_ACCEPTED;
+}
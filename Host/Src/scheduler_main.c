@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_scheduler.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define SCHEDULER_MAX_PASS_COUNT        1024
+
+#define SCHEDULER_DEFAULT_PASS_COUNT    48
+#define SCHEDULER_DEFAULT_PERIOD_S      5400
+#define SCHEDULER_DEFAULT_JITTER_S      1800
+#define SCHEDULER_DEFAULT_DURATION_S    300
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void print_usage(const char *p_program);
+static uint16_t load_timeline(const char *p_path, uint32_t *p_start_s, uint32_t *p_duration_s);
+static uint32_t get_random(uint32_t *p_state);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static uint32_t g_p_pass_start_s[SCHEDULER_MAX_PASS_COUNT];
+static uint32_t g_p_pass_duration_s[SCHEDULER_MAX_PASS_COUNT];
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    uint32_t pass_count = SCHEDULER_DEFAULT_PASS_COUNT;
+    uint32_t period_s = SCHEDULER_DEFAULT_PERIOD_S;
+    uint32_t jitter_s = SCHEDULER_DEFAULT_JITTER_S;
+    uint32_t duration_s = SCHEDULER_DEFAULT_DURATION_S;
+    uint32_t random_state = 1;
+    int option = 0;
+
+    while ((option = getopt(argc, argv, "n:p:j:w:s:h")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                pass_count = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'p':
+                period_s = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'j':
+                jitter_s = strtoul(optarg, NULL, 0);
+                break;
+
+            case 'w':
+                duration_s = strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                random_state = strtoul(optarg, NULL, 0) | 1;
+                break;
+
+            default:
+                print_usage(argv[0]);
+                return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (optind < argc)
+    {
+        pass_count = load_timeline(argv[optind], g_p_pass_start_s, g_p_pass_duration_s);
+        if (pass_count == 0)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        uint32_t start_s = 0;
+
+        if (pass_count == 0 || pass_count > SCHEDULER_MAX_PASS_COUNT || duration_s == 0 || period_s <= duration_s + jitter_s)
+        {
+            fprintf(stderr, "Between 1 and %d passes, shorter than the period minus the jitter.\n", SCHEDULER_MAX_PASS_COUNT);
+            return EXIT_FAILURE;
+        }
+
+        // Passes spread around the period, as a constellation seen from a fixed asset.
+        for (uint32_t i = 0; i < pass_count; i++)
+        {
+            start_s += period_s - jitter_s + (jitter_s > 0 ? get_random(&random_state) % (2 * jitter_s) : 0);
+            g_p_pass_start_s[i] = start_s;
+            g_p_pass_duration_s[i] = duration_s / 2 + get_random(&random_state) % (duration_s / 2 + 1);
+        }
+    }
+
+    // The simulation reports through the debug logs.
+    set_debug_logs_enabled(true);
+    astronode_scheduler_simulate(g_p_pass_start_s, g_p_pass_duration_s, pass_count);
+
+    return EXIT_SUCCESS;
+}
+
+static void print_usage(const char *p_program)
+{
+    fprintf(stderr,
+            "Usage: %s [options] [timeline]\n"
+            "Replay a pass timeline through the scheduler and log the data freshness latency.\n"
+            "The timeline file has one pass per line: start (s) and duration (s), in increasing order.\n"
+            "Without it, a synthetic timeline is generated:\n"
+            "  -n <count>   passes (default %d)\n"
+            "  -p <s>       mean period between passes (default %d)\n"
+            "  -j <s>       jitter of the pass start around the period (default %d)\n"
+            "  -w <s>       longest pass duration (default %d)\n"
+            "  -s <seed>    seed of the timeline\n",
+            p_program,
+            SCHEDULER_DEFAULT_PASS_COUNT,
+            SCHEDULER_DEFAULT_PERIOD_S,
+            SCHEDULER_DEFAULT_JITTER_S,
+            SCHEDULER_DEFAULT_DURATION_S);
+}
+
+static uint16_t load_timeline(const char *p_path, uint32_t *p_start_s, uint32_t *p_duration_s)
+{
+    FILE *p_input = fopen(p_path, "r");
+    uint16_t count = 0;
+    unsigned long start_s = 0;
+    unsigned long duration_s = 0;
+
+    if (p_input == NULL)
+    {
+        perror(p_path);
+        return 0;
+    }
+
+    while (count < SCHEDULER_MAX_PASS_COUNT && fscanf(p_input, "%lu %lu", &start_s, &duration_s) == 2)
+    {
+        if (count > 0 && start_s < p_start_s[count - 1] + p_duration_s[count - 1])
+        {
+            fprintf(stderr, "%s: pass %u overlaps the previous one.\n", p_path, count);
+            fclose(p_input);
+            return 0;
+        }
+        p_start_s[count] = start_s;
+        p_duration_s[count] = duration_s;
+        count++;
+    }
+
+    fclose(p_input);
+    if (count == 0)
+    {
+        fprintf(stderr, "%s: no pass.\n", p_path);
+    }
+    return count;
+}
+
+static uint32_t get_random(uint32_t *p_state)
+{
+    uint32_t x = *p_state;
+
+    // xorshift32
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *p_state = x;
+
+    return x;
+}
@@ -0,0 +1,514 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_retry.h"
+#include "astronode_trace.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TRACE_RECORD_MAX_LEN_BYTES      (ASTRONODE_TRACE_HEADER_LEN_BYTES + ASTRONODE_TRANSPORT_MSG_MAX_LEN_BYTES)
+#define TRACE_LINE_MAX_LEN_BYTES        (2 * TRACE_RECORD_MAX_LEN_BYTES + 256)
+
+// STX + OPCODE + CRC + ETX
+#define TRACE_FRAME_OVERHEAD_LEN_BYTES  (1 + 2 + 4 + 1)
+
+// Classic pcap format, the records are stored as they are in the ring.
+#define PCAP_MAGIC                      0xA1B2C3D4
+#define PCAP_VERSION_MAJOR              2
+#define PCAP_VERSION_MINOR              4
+#define PCAP_LINKTYPE_USER0             147
+#define PCAP_GLOBAL_HEADER_LEN_BYTES    24
+#define PCAP_RECORD_HEADER_LEN_BYTES    16
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct trace_record_t
+{
+    uint16_t    length;
+    uint8_t     p_data[TRACE_RECORD_MAX_LEN_BYTES];
+} trace_record_t;
+
+typedef struct trace_file_t
+{
+    trace_record_t *p_records;
+    uint32_t        count;
+    uint32_t        capacity;
+} trace_file_t;
+
+// Link answering each request with the recorded answer frame.
+typedef struct replay_link_t
+{
+    const uint8_t  *p_answer;
+    uint16_t        answer_length;
+    uint16_t        answer_index;
+} replay_link_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void print_usage(const char *p_program);
+static uint64_t get_time_ns(void);
+static bool is_hex(char character);
+static uint8_t hex_to_value(char character);
+static return_status_t add_record(trace_file_t *p_file, const uint8_t *p_data, uint32_t length);
+static return_status_t load_dump(FILE *p_input, trace_file_t *p_file);
+static return_status_t load_pcap(FILE *p_input, trace_file_t *p_file);
+static return_status_t load_trace(const char *p_path, trace_file_t *p_file);
+static void write_u16(FILE *p_output, uint16_t value);
+static void write_u32(FILE *p_output, uint32_t value);
+static uint32_t read_u32(const uint8_t *p_data);
+static int convert_to_pcap(const trace_file_t *p_file, const char *p_path);
+static return_status_t decode_request_frame(const astronode_trace_record_t *p_record, astronode_app_msg_t *p_request);
+static int replay(const trace_file_t *p_file, uint32_t pass_count);
+static void send_request_to_replay(void *p_port, uint8_t *p_data, uint32_t length);
+static bool is_character_received_from_replay(void *p_port, uint8_t *p_rx_char);
+static bool is_replay_evt_pin_high(void *p_port);
+static void reset_replay(void *p_port);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const char *g_p_status_names[] =
+{
+    [ASTRONODE_TRACE_STATUS_SENT] = "sent",
+    [ASTRONODE_TRACE_STATUS_OK] = "ok",
+    [ASTRONODE_TRACE_STATUS_MODULE_ERROR] = "module error",
+    [ASTRONODE_TRACE_STATUS_INVALID] = "invalid",
+    [ASTRONODE_TRACE_STATUS_TIMEOUT] = "timeout"
+};
+
+static const astronode_uart_ops_t g_replay_uart_ops =
+{
+    .send_request = send_request_to_replay,
+    .is_character_received = is_character_received_from_replay,
+    .is_evt_pin_high = is_replay_evt_pin_high,
+    .reset = reset_replay
+};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    trace_file_t file = { 0 };
+    uint32_t pass_count = 1;
+    int option = 0;
+
+    while ((option = getopt(argc, argv, "n:h")) != -1)
+    {
+        switch (option)
+        {
+            case 'n':
+                pass_count = strtoul(optarg, NULL, 0);
+                break;
+
+            default:
+                print_usage(argv[0]);
+                return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind == 3 && strcmp(argv[optind], "pcap") == 0)
+    {
+        if (load_trace(argv[optind + 1], &file) != RS_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        return convert_to_pcap(&file, argv[optind + 2]);
+    }
+    else if (argc - optind == 2 && strcmp(argv[optind], "replay") == 0)
+    {
+        if (load_trace(argv[optind + 1], &file) != RS_SUCCESS)
+        {
+            return EXIT_FAILURE;
+        }
+        return replay(&file, pass_count > 0 ? pass_count : 1);
+    }
+
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+}
+
+static void print_usage(const char *p_program)
+{
+    fprintf(stderr,
+            "Usage: %s pcap <trace> <output.pcap>\n"
+            "       %s [-n <passes>] replay <trace>\n"
+            "The trace is a log holding the lines of astronode_trace_dump() or a pcap file.\n"
+            "  pcap         write the records in a pcap file (link type USER0)\n"
+            "  replay       decode the recorded answers again and compare their status,\n"
+            "               -n repeats the replay to measure the decoding throughput\n",
+            p_program, p_program);
+}
+
+static uint64_t get_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+static bool is_hex(char character)
+{
+    return (character >= '0' && character <= '9') || (character >= 'A' && character <= 'F');
+}
+
+static uint8_t hex_to_value(char character)
+{
+    return character <= '9' ? character - '0' : character - 'A' + 10;
+}
+
+static return_status_t add_record(trace_file_t *p_file, const uint8_t *p_data, uint32_t length)
+{
+    astronode_trace_record_t record;
+
+    if (length > TRACE_RECORD_MAX_LEN_BYTES || astronode_trace_parse(p_data, (uint16_t) length, &record) != RS_SUCCESS)
+    {
+        return RS_FAILURE;
+    }
+
+    if (p_file->count == p_file->capacity)
+    {
+        uint32_t capacity = p_file->capacity > 0 ? 2 * p_file->capacity : 64;
+        trace_record_t *p_records = realloc(p_file->p_records, capacity * sizeof(trace_record_t));
+
+        if (p_records == NULL)
+        {
+            return RS_FAILURE;
+        }
+        p_file->p_records = p_records;
+        p_file->capacity = capacity;
+    }
+
+    p_file->p_records[p_file->count].length = (uint16_t) length;
+    memcpy(p_file->p_records[p_file->count].p_data, p_data, length);
+    p_file->count++;
+
+    return RS_SUCCESS;
+}
+
+static return_status_t load_dump(FILE *p_input, trace_file_t *p_file)
+{
+    static char p_line[TRACE_LINE_MAX_LEN_BYTES];
+    uint8_t p_record[TRACE_RECORD_MAX_LEN_BYTES];
+    uint32_t line_number = 0;
+
+    // The dump lines can be mixed with other logs, even on the same line.
+    while (fgets(p_line, sizeof(p_line), p_input) != NULL)
+    {
+        char *p_hex = strstr(p_line, ASTRONODE_TRACE_DUMP_PREFIX);
+        uint32_t length = 0;
+
+        line_number++;
+        if (p_hex == NULL)
+        {
+            continue;
+        }
+        p_hex += strlen(ASTRONODE_TRACE_DUMP_PREFIX);
+
+        while (is_hex(p_hex[0]) && is_hex(p_hex[1]) && length < sizeof(p_record))
+        {
+            p_record[length++] = (hex_to_value(p_hex[0]) << 4) + hex_to_value(p_hex[1]);
+            p_hex += 2;
+        }
+
+        // BEGIN and END lines
+        if (length == 0 || (*p_hex != '\0' && *p_hex != '\r' && *p_hex != '\n'))
+        {
+            continue;
+        }
+
+        if (add_record(p_file, p_record, length) != RS_SUCCESS)
+        {
+            fprintf(stderr, "Line %u: invalid record, ignored.\n", line_number);
+        }
+    }
+
+    return RS_SUCCESS;
+}
+
+static return_status_t load_pcap(FILE *p_input, trace_file_t *p_file)
+{
+    uint8_t p_header[PCAP_RECORD_HEADER_LEN_BYTES];
+    uint8_t p_record[TRACE_RECORD_MAX_LEN_BYTES];
+
+    if (fseek(p_input, PCAP_GLOBAL_HEADER_LEN_BYTES, SEEK_SET) != 0)
+    {
+        return RS_FAILURE;
+    }
+
+    while (fread(p_header, 1, sizeof(p_header), p_input) == sizeof(p_header))
+    {
+        uint32_t length = read_u32(&p_header[8]);
+
+        if (length > sizeof(p_record) || fread(p_record, 1, length, p_input) != length)
+        {
+            fprintf(stderr, "Truncated pcap file.\n");
+            return RS_FAILURE;
+        }
+        if (add_record(p_file, p_record, length) != RS_SUCCESS)
+        {
+            fprintf(stderr, "Record %u: invalid record, ignored.\n", p_file->count);
+        }
+    }
+
+    return RS_SUCCESS;
+}
+
+static return_status_t load_trace(const char *p_path, trace_file_t *p_file)
+{
+    FILE *p_input = fopen(p_path, "rb");
+    uint8_t p_magic[4] = { 0 };
+    return_status_t status = RS_FAILURE;
+
+    if (p_input == NULL)
+    {
+        perror(p_path);
+        return RS_FAILURE;
+    }
+
+    if (fread(p_magic, 1, sizeof(p_magic), p_input) == sizeof(p_magic) && read_u32(p_magic) == PCAP_MAGIC)
+    {
+        status = load_pcap(p_input, p_file);
+    }
+    else
+    {
+        rewind(p_input);
+        status = load_dump(p_input, p_file);
+    }
+    fclose(p_input);
+
+    if (status == RS_SUCCESS && p_file->count == 0)
+    {
+        fprintf(stderr, "%s: no trace record.\n", p_path);
+        return RS_FAILURE;
+    }
+
+    return status;
+}
+
+static void write_u16(FILE *p_output, uint16_t value)
+{
+    uint8_t p_data[2] = { (uint8_t) value, (uint8_t) (value >> 8) };
+
+    fwrite(p_data, 1, sizeof(p_data), p_output);
+}
+
+static void write_u32(FILE *p_output, uint32_t value)
+{
+    write_u16(p_output, (uint16_t) value);
+    write_u16(p_output, (uint16_t) (value >> 16));
+}
+
+static uint32_t read_u32(const uint8_t *p_data)
+{
+    return p_data[0] | ((uint32_t) p_data[1] << 8) | ((uint32_t) p_data[2] << 16) | ((uint32_t) p_data[3] << 24);
+}
+
+static int convert_to_pcap(const trace_file_t *p_file, const char *p_path)
+{
+    FILE *p_output = fopen(p_path, "wb");
+
+    if (p_output == NULL)
+    {
+        perror(p_path);
+        return EXIT_FAILURE;
+    }
+
+    write_u32(p_output, PCAP_MAGIC);
+    write_u16(p_output, PCAP_VERSION_MAJOR);
+    write_u16(p_output, PCAP_VERSION_MINOR);
+    write_u32(p_output, 0);
+    write_u32(p_output, 0);
+    write_u32(p_output, TRACE_RECORD_MAX_LEN_BYTES);
+    write_u32(p_output, PCAP_LINKTYPE_USER0);
+
+    for (uint32_t i = 0; i < p_file->count; i++)
+    {
+        const trace_record_t *p_record = &p_file->p_records[i];
+        uint32_t timestamp_ms = read_u32(&p_record->p_data[2]);
+
+        write_u32(p_output, timestamp_ms / 1000);
+        write_u32(p_output, (timestamp_ms % 1000) * 1000);
+        write_u32(p_output, p_record->length);
+        write_u32(p_output, p_record->length);
+        fwrite(p_record->p_data, 1, p_record->length, p_output);
+    }
+
+    if (fclose(p_output) != 0)
+    {
+        perror(p_path);
+        return EXIT_FAILURE;
+    }
+    printf("%u records written in %s.\n", p_file->count, p_path);
+
+    return EXIT_SUCCESS;
+}
+
+static return_status_t decode_request_frame(const astronode_trace_record_t *p_record, astronode_app_msg_t *p_request)
+{
+    const uint8_t *p_frame = p_record->p_frame;
+    uint16_t length = p_record->frame_length;
+
+    // STX, op code, payload, CRC, ETX
+    if (length < TRACE_FRAME_OVERHEAD_LEN_BYTES || length % 2 == 1
+        || (length - TRACE_FRAME_OVERHEAD_LEN_BYTES) / 2 > ASTRONODE_APP_MSG_MAX_LEN_BYTES)
+    {
+        return RS_FAILURE;
+    }
+
+    for (uint16_t i = 1; i < length - 1; i++)
+    {
+        if (is_hex(p_frame[i]) == false)
+        {
+            return RS_FAILURE;
+        }
+    }
+
+    p_request->op_code = (hex_to_value(p_frame[1]) << 4) + hex_to_value(p_frame[2]);
+    p_request->payload_len = (length - TRACE_FRAME_OVERHEAD_LEN_BYTES) / 2;
+    for (uint16_t i = 0; i < p_request->payload_len; i++)
+    {
+        p_request->p_payload[i] = (hex_to_value(p_frame[3 + 2 * i]) << 4) + hex_to_value(p_frame[4 + 2 * i]);
+    }
+
+    return RS_SUCCESS;
+}
+
+static int replay(const trace_file_t *p_file, uint32_t pass_count)
+{
+    replay_link_t link = { 0 };
+    astronode_ctx_t ctx;
+    uint32_t replayed_count = 0;
+    uint32_t skipped_count = 0;
+    uint32_t mismatch_count = 0;
+    uint64_t rx_bytes = 0;
+
+    init_drivers();
+    set_debug_logs_enabled(false);
+    astronode_ctx_init(&ctx, &g_replay_uart_ops, &link);
+
+    // The retries are recorded in the trace as transactions of their own.
+    astronode_retry_set_enabled(&ctx, false);
+
+    uint64_t start_ns = get_time_ns();
+
+    for (uint32_t pass = 0; pass < pass_count; pass++)
+    {
+        for (uint32_t i = 0; i + 1 < p_file->count; i++)
+        {
+            astronode_trace_record_t tx;
+            astronode_trace_record_t rx;
+            astronode_app_msg_t request = { 0 };
+            astronode_app_msg_t answer = { 0 };
+
+            astronode_trace_parse(p_file->p_records[i].p_data, p_file->p_records[i].length, &tx);
+            astronode_trace_parse(p_file->p_records[i + 1].p_data, p_file->p_records[i + 1].length, &rx);
+
+            if (tx.direction != ASTRONODE_TRACE_DIRECTION_TX || rx.direction != ASTRONODE_TRACE_DIRECTION_RX)
+            {
+                continue;
+            }
+
+            // Without the ETX the transport waits for the answer timeout, there is nothing to decode.
+            if (rx.frame_length == 0 || rx.p_frame[rx.frame_length - 1] != ASTRONODE_TRANSPORT_ETX
+                || decode_request_frame(&tx, &request) != RS_SUCCESS)
+            {
+                skipped_count += pass == 0 ? 1 : 0;
+                continue;
+            }
+
+            link.p_answer = rx.p_frame;
+            link.answer_length = rx.frame_length;
+
+            return_status_t status = astronode_transport_send_receive(&ctx, &request, &answer);
+            astronode_trace_status_t replayed_status = astronode_trace_get_answer_status(status, answer.op_code, rx.frame_length);
+            uint16_t error_code = astronode_get_last_error_code(&ctx);
+
+            rx_bytes += rx.frame_length;
+            if (pass > 0)
+            {
+                continue;
+            }
+
+            replayed_count++;
+            if (replayed_status != rx.status || error_code != rx.error_code)
+            {
+                mismatch_count++;
+                printf("Record %u (op code 0x%02X, %u ms): recorded %s 0x%04X, replayed %s 0x%04X\n",
+                       i + 1, tx.op_code, rx.timestamp_ms,
+                       rx.status <= ASTRONODE_TRACE_STATUS_TIMEOUT ? g_p_status_names[rx.status] : "?", rx.error_code,
+                       g_p_status_names[replayed_status], error_code);
+            }
+        }
+    }
+
+    double duration_s = (get_time_ns() - start_ns) / 1e9;
+
+    printf("%u records, %u transactions replayed, %u skipped, %u mismatches.\n",
+           p_file->count, replayed_count, skipped_count, mismatch_count);
+    if (duration_s > 0 && replayed_count > 0)
+    {
+        printf("%u passes in %.3f s: %.0f transactions/s, %.3f MB/s of answers decoded.\n",
+               pass_count, duration_s, replayed_count * pass_count / duration_s, rx_bytes / duration_s / 1e6);
+    }
+
+    return mismatch_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void send_request_to_replay(void *p_port, uint8_t *p_data, uint32_t length)
+{
+    replay_link_t *p_link = p_port;
+
+    (void) p_data;
+    (void) length;
+    p_link->answer_index = 0;
+}
+
+static bool is_character_received_from_replay(void *p_port, uint8_t *p_rx_char)
+{
+    replay_link_t *p_link = p_port;
+
+    if (p_link->answer_index < p_link->answer_length)
+    {
+        *p_rx_char = p_link->p_answer[p_link->answer_index++];
+        return true;
+    }
+    return false;
+}
+
+static bool is_replay_evt_pin_high(void *p_port)
+{
+    (void) p_port;
+    return false;
+}
+
+static void reset_replay(void *p_port)
+{
+    (void) p_port;
+}
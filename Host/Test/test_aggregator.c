@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_aggregator.h"
+#include "astronode_definitions.h"
+#include "astronode_packer.h"
+#include "dataset.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Window of the SENSOR channel in the ASTRONODE_AGGREGATOR_CHANNELS of the Makefile.
+#define TEST_WINDOW_SIZE        60
+#define TEST_MAX_RECORD_COUNT   64
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+typedef struct test_record_t
+{
+    uint16_t    length;
+    uint8_t     p_data[ASTRONODE_AGGREGATOR_RECORD_MAX_LEN_BYTES];
+} test_record_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void store_record(const uint8_t *p_record, uint16_t record_length);
+static bool decode_record(const test_record_t *p_record, uint8_t *p_channel_id, astronode_aggregator_summary_t *p_summary);
+static void check_channel(const dataset_t *p_dataset, uint8_t channel);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const char *g_p_dataset_paths[] =
+{
+    "Data/sensor_environment_day.csv",
+    "Data/sensor_tank_level.csv"
+};
+
+static test_record_t g_p_records[TEST_MAX_RECORD_COUNT];
+static uint16_t g_record_count = 0;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    astronode_aggregator_summary_t summary = { 0 };
+
+    for (uint8_t i = 0; i < sizeof(g_p_dataset_paths) / sizeof(g_p_dataset_paths[0]); i++)
+    {
+        dataset_t dataset;
+
+        TEST_CHECK(dataset_load(&dataset, g_p_dataset_paths[i]) == RS_SUCCESS);
+        for (uint8_t channel = 0; channel < dataset.channel_count; channel++)
+        {
+            check_channel(&dataset, channel);
+        }
+        dataset_free(&dataset);
+    }
+
+    // Extremes of the int32 range: the mean and the variance saturate instead of wrapping.
+    g_record_count = 0;
+    astronode_aggregator_init(store_record);
+    astronode_aggregator_add_sample(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, INT32_MIN);
+    astronode_aggregator_add_sample(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, INT32_MAX);
+    astronode_aggregator_get_summary(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, &summary);
+    TEST_CHECK(summary.count == 2 && summary.min == INT32_MIN && summary.max == INT32_MAX);
+    TEST_CHECK(summary.variance == UINT32_MAX);
+    astronode_aggregator_flush(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR);
+    TEST_CHECK(g_record_count == 1 && g_p_records[0].length <= ASTRONODE_AGGREGATOR_RECORD_MAX_LEN_BYTES);
+
+    // Nothing is emitted for an empty window.
+    astronode_aggregator_flush(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR);
+    TEST_CHECK(g_record_count == 1);
+
+    TEST_EXIT();
+}
+
+static void store_record(const uint8_t *p_record, uint16_t record_length)
+{
+    if (g_record_count < TEST_MAX_RECORD_COUNT && record_length <= ASTRONODE_AGGREGATOR_RECORD_MAX_LEN_BYTES)
+    {
+        g_p_records[g_record_count].length = record_length;
+        memcpy(g_p_records[g_record_count].p_data, p_record, record_length);
+    }
+    g_record_count++;
+}
+
+static bool decode_record(const test_record_t *p_record, uint8_t *p_channel_id, astronode_aggregator_summary_t *p_summary)
+{
+    uint32_t p_fields[5];
+    uint16_t offset = 2;
+
+    if (p_record->p_data[0] != ASTRONODE_AGGREGATOR_FORMAT_SUMMARY)
+    {
+        return false;
+    }
+    *p_channel_id = p_record->p_data[1];
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        uint8_t length = astronode_varint_decode(&p_record->p_data[offset], p_record->length - offset, &p_fields[i]);
+
+        if (length == 0)
+        {
+            return false;
+        }
+        offset += length;
+    }
+
+    p_summary->count = (uint16_t) p_fields[0];
+    p_summary->min = astronode_zigzag_decode(p_fields[1]);
+    p_summary->max = astronode_zigzag_decode(p_fields[2]);
+    p_summary->mean = astronode_zigzag_decode(p_fields[3]);
+    p_summary->variance = p_fields[4];
+
+    return offset == p_record->length;
+}
+
+static void check_channel(const dataset_t *p_dataset, uint8_t channel)
+{
+    uint16_t expected_count = (p_dataset->sample_count + TEST_WINDOW_SIZE - 1) / TEST_WINDOW_SIZE;
+
+    g_record_count = 0;
+    astronode_aggregator_init(store_record);
+    for (uint32_t i = 0; i < p_dataset->sample_count; i++)
+    {
+        astronode_aggregator_add_sample(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR, dataset_get_sample(p_dataset, i)[channel]);
+    }
+    astronode_aggregator_flush(ASTRONODE_AGGREGATOR_CHANNEL_SENSOR);
+
+    TEST_CHECK(g_record_count == expected_count);
+    for (uint16_t i = 0; i < g_record_count && i < TEST_MAX_RECORD_COUNT; i++)
+    {
+        astronode_aggregator_summary_t summary = { 0 };
+        uint8_t channel_id = 0;
+        uint32_t first = i * TEST_WINDOW_SIZE;
+        uint32_t count = p_dataset->sample_count - first < TEST_WINDOW_SIZE ? p_dataset->sample_count - first : TEST_WINDOW_SIZE;
+        int32_t min = INT32_MAX;
+        int32_t max = INT32_MIN;
+        double sum = 0.0;
+        double square_sum = 0.0;
+
+        // Reference statistics of the window, computed in double in two passes.
+        for (uint32_t j = first; j < first + count; j++)
+        {
+            int32_t value = dataset_get_sample(p_dataset, j)[channel];
+
+            min = value < min ? value : min;
+            max = value > max ? value : max;
+            sum += value;
+        }
+
+        double mean = sum / count;
+
+        for (uint32_t j = first; j < first + count; j++)
+        {
+            double delta = dataset_get_sample(p_dataset, j)[channel] - mean;
+
+            square_sum += delta * delta;
+        }
+
+        double variance = count > 1 ? square_sum / (count - 1) : 0.0;
+
+        TEST_CHECK(decode_record(&g_p_records[i], &channel_id, &summary));
+        TEST_CHECK(channel_id == ASTRONODE_AGGREGATOR_CHANNEL_SENSOR);
+        TEST_CHECK(summary.count == count);
+        TEST_CHECK(summary.min == min && summary.max == max);
+        // Single precision running statistics: the mean within one unit, the variance within 0.1 %.
+        TEST_CHECK(fabs(summary.mean - mean) <= 1.0);
+        TEST_CHECK(fabs(summary.variance - variance) <= 1.0 + variance * 1e-3);
+    }
+}
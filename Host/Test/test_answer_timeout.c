@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_metrics.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TEST_BAUD_RATE          9600
+#define TEST_REQUEST_PAIRS      4
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void test_alternate_lengths(bool is_tx_buffered);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static emulator_link_t g_link;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    set_debug_logs_enabled(false);
+
+    test_alternate_lengths(false);
+    test_alternate_lengths(true);
+
+    TEST_EXIT();
+}
+
+static void test_alternate_lengths(bool is_tx_buffered)
+{
+    astronode_emulator_config_t config = { .baud_rate = TEST_BAUD_RATE, .ack_delay_ms = UINT32_MAX };
+    astronode_metrics_snapshot_t snapshot;
+    astronode_ctx_t ctx;
+    char p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint16_t payload_id = 0;
+
+    memset(p_payload, 'a', sizeof(p_payload));
+    emulator_link_init(&g_link, &config);
+    g_link.is_tx_buffered = is_tx_buffered;
+    astronode_ctx_init(&ctx, get_emulator_link_uart_ops(), &g_link);
+
+    // The latency learned on a short request must leave room for the transfer of a long
+    // one at the baud rate of the Astronode, whether the driver returns before or after it.
+    for (uint8_t i = 0; i < TEST_REQUEST_PAIRS; i++)
+    {
+        TEST_CHECK(astronode_send_pld_er(&ctx, astronode_ctx_allocate_payload_id(&ctx), p_payload, 1) == RS_SUCCESS);
+        TEST_CHECK(astronode_send_pld_er(&ctx, astronode_ctx_allocate_payload_id(&ctx), p_payload, sizeof(p_payload)) == RS_SUCCESS);
+        TEST_CHECK(astronode_send_pld_dr(&ctx, &payload_id) == RS_SUCCESS);
+        TEST_CHECK(astronode_send_pld_dr(&ctx, &payload_id) == RS_SUCCESS);
+    }
+
+    astronode_metrics_snapshot(&ctx, &snapshot, false);
+    TEST_CHECK(snapshot.p_failures[ASTRONODE_METRICS_FAILURE_TIMEOUT] == 0);
+    TEST_CHECK(snapshot.p_counters[ASTRONODE_METRICS_COUNTER_RETRIES] == 0);
+}
@@ -0,0 +1,42 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Checks of the host tests: a failed check is reported and counted, the test goes on and
+// TEST_EXIT() returns the status of the program.
+#define TEST_CHECK(condition)                                                   \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            g_test_failure_count++;                                             \
+        }                                                                       \
+    } while (0)
+
+#define TEST_EXIT()                                                             \
+    do                                                                          \
+    {                                                                           \
+        fprintf(stderr, "%s: %s\n", __FILE__, g_test_failure_count == 0 ? "passed" : "FAILED"); \
+        return g_test_failure_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;          \
+    } while (0)
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static unsigned int g_test_failure_count = 0;
+
+
+#endif /* TEST_CHECK_H */
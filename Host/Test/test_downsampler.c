@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Astrocast
+#include "astronode_definitions.h"
+#include "astronode_downsampler.h"
+#include "astronode_packer.h"
+#include "dataset.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TEST_MAX_POINT_COUNT    4096
+
+// Slack of the single precision slopes of the swinging door.
+#define TEST_SLOPE_TOLERANCE    0.01
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void check_channel(const dataset_t *p_dataset, uint8_t channel, astronode_downsampler_mode_t mode, uint32_t error_bound);
+static double rebuild(astronode_downsampler_mode_t mode, const astronode_downsampler_point_t *p_previous, const astronode_downsampler_point_t *p_next, uint32_t timestamp);
+static void check_encoding(uint16_t point_count);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static const char *g_p_dataset_paths[] =
+{
+    "Data/sensor_environment_day.csv",
+    "Data/sensor_tank_level.csv"
+};
+
+static const uint32_t g_p_error_bounds[] = { 0, 1, 5, 20 };
+
+static astronode_downsampler_point_t g_p_points[TEST_MAX_POINT_COUNT];
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    for (uint8_t i = 0; i < sizeof(g_p_dataset_paths) / sizeof(g_p_dataset_paths[0]); i++)
+    {
+        dataset_t dataset;
+
+        TEST_CHECK(dataset_load(&dataset, g_p_dataset_paths[i]) == RS_SUCCESS);
+        for (uint8_t channel = 0; channel < dataset.channel_count; channel++)
+        {
+            for (uint8_t j = 0; j < sizeof(g_p_error_bounds) / sizeof(g_p_error_bounds[0]); j++)
+            {
+                check_channel(&dataset, channel, ASTRONODE_DOWNSAMPLER_MODE_DEADBAND, g_p_error_bounds[j]);
+                check_channel(&dataset, channel, ASTRONODE_DOWNSAMPLER_MODE_SWINGING_DOOR, g_p_error_bounds[j]);
+            }
+        }
+        dataset_free(&dataset);
+    }
+
+    // A constant signal keeps a point at least every ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES samples.
+    astronode_downsampler_t downsampler;
+    astronode_downsampler_point_t point;
+    uint32_t kept_count = 0;
+
+    astronode_downsampler_init(&downsampler, ASTRONODE_DOWNSAMPLER_MODE_SWINGING_DOOR, 0);
+    for (uint32_t i = 0; i < 3 * ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES; i++)
+    {
+        kept_count += astronode_downsampler_add_sample(&downsampler, i, 42, &point);
+    }
+    TEST_CHECK(kept_count == 3);
+
+    // Samples out of order are ignored.
+    TEST_CHECK(astronode_downsampler_add_sample(&downsampler, 0, 0, &point) == false);
+    TEST_CHECK(downsampler.input_count == 3 * ASTRONODE_DOWNSAMPLER_MAX_SEGMENT_SAMPLES);
+
+    TEST_EXIT();
+}
+
+static void check_channel(const dataset_t *p_dataset, uint8_t channel, astronode_downsampler_mode_t mode, uint32_t error_bound)
+{
+    astronode_downsampler_t downsampler;
+    uint16_t point_count = 0;
+    uint32_t next_point = 0;
+    bool is_within_bound = true;
+
+    astronode_downsampler_init(&downsampler, mode, error_bound);
+    for (uint32_t i = 0; i <= p_dataset->sample_count && point_count < TEST_MAX_POINT_COUNT; i++)
+    {
+        bool is_kept = i < p_dataset->sample_count
+                       ? astronode_downsampler_add_sample(&downsampler, p_dataset->p_times[i], dataset_get_sample(p_dataset, i)[channel], &g_p_points[point_count])
+                       : astronode_downsampler_flush(&downsampler, &g_p_points[point_count]);
+
+        point_count += is_kept;
+    }
+
+    // The first and the last samples close the trace.
+    TEST_CHECK(point_count >= 2 && point_count <= p_dataset->sample_count);
+    TEST_CHECK(g_p_points[0].timestamp == p_dataset->p_times[0]);
+    TEST_CHECK(g_p_points[point_count - 1].timestamp == p_dataset->p_times[p_dataset->sample_count - 1]);
+    TEST_CHECK(downsampler.input_count == p_dataset->sample_count && downsampler.output_count == point_count);
+
+    // Every sample is within the error bound of the signal rebuilt from the kept points.
+    for (uint32_t i = 0; i < p_dataset->sample_count && is_within_bound; i++)
+    {
+        uint32_t timestamp = p_dataset->p_times[i];
+        int32_t value = dataset_get_sample(p_dataset, i)[channel];
+
+        while (next_point < point_count - 1u && g_p_points[next_point].timestamp < timestamp)
+        {
+            next_point++;
+        }
+
+        double error = (g_p_points[next_point].timestamp == timestamp ? g_p_points[next_point].value
+                        : rebuild(mode, &g_p_points[next_point - 1], &g_p_points[next_point], timestamp)) - value;
+
+        is_within_bound = error <= error_bound + TEST_SLOPE_TOLERANCE && -error <= error_bound + TEST_SLOPE_TOLERANCE;
+        if (is_within_bound == false)
+        {
+            fprintf(stderr, "%s, mode %d, bound %u: sample %u off by %.2f\n",
+                    p_dataset->p_names[channel], mode, error_bound, i, error);
+        }
+    }
+    TEST_CHECK(is_within_bound);
+
+    check_encoding(point_count);
+}
+
+static double rebuild(astronode_downsampler_mode_t mode, const astronode_downsampler_point_t *p_previous, const astronode_downsampler_point_t *p_next, uint32_t timestamp)
+{
+    if (mode == ASTRONODE_DOWNSAMPLER_MODE_DEADBAND)
+    {
+        return p_previous->value;
+    }
+
+    return p_previous->value + ((double) p_next->value - p_previous->value)
+                               * (timestamp - p_previous->timestamp) / (p_next->timestamp - p_previous->timestamp);
+}
+
+static void check_encoding(uint16_t point_count)
+{
+    uint8_t p_buffer[ASTRONODE_DOWNSAMPLER_POINT_MAX_LEN_BYTES];
+    astronode_downsampler_point_t decoded = { 0 };
+    bool is_decoded = true;
+
+    // Points encoded relative to the previous one decode back to the kept points.
+    for (uint16_t i = 0; i < point_count && is_decoded; i++)
+    {
+        uint8_t length = astronode_downsampler_encode_point(i > 0 ? &g_p_points[i - 1] : NULL, &g_p_points[i], p_buffer);
+        uint32_t timestamp = 0;
+        uint32_t value = 0;
+        uint8_t offset = astronode_varint_decode(p_buffer, length, &timestamp);
+
+        offset += astronode_varint_decode(&p_buffer[offset], length - offset, &value);
+        decoded.timestamp = i > 0 ? decoded.timestamp + timestamp : timestamp;
+        decoded.value = i > 0 ? (int32_t) ((uint32_t) decoded.value + (uint32_t) astronode_zigzag_decode(value)) : astronode_zigzag_decode(value);
+
+        is_decoded = offset == length && decoded.timestamp == g_p_points[i].timestamp && decoded.value == g_p_points[i].value;
+    }
+    TEST_CHECK(is_decoded);
+}
@@ -0,0 +1,205 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_downlink.h"
+#include "astronode_event.h"
+#include "astronode_fragment.h"
+#include "astronode_payload_policy.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TEST_RECORD_LEN_BYTES   1000
+#define TEST_ACK_DELAY_MS       5
+#define TEST_TIMEOUT_MS         5000
+#define TEST_ALARM_CLASS        0
+#define TEST_PERIODIC_CLASS     2
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void acknowledge_payload(uint16_t payload_id);
+static void receive_uplink(void *p_user, uint16_t payload_id, const uint8_t *p_data, uint8_t length);
+static uint16_t build_fragment(uint8_t message_id, const uint8_t *p_record, uint16_t record_length, uint8_t *p_payload);
+static void test_through_emulator(void);
+static void test_message_id_wrap(void);
+astronode_downlink_result_t handle_log_command(const uint8_t *p_data, uint8_t length);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static emulator_link_t g_link;
+static uint8_t g_p_record[TEST_RECORD_LEN_BYTES];
+static uint8_t g_p_reassembled[ASTRONODE_FRAGMENT_RECORD_MAX_LEN_BYTES];
+static astronode_reassembler_t g_reassembler;
+static bool g_is_reassembled = false;
+static uint32_t g_fragment_received_count = 0;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    set_debug_logs_enabled(false);
+
+    test_through_emulator();
+    test_message_id_wrap();
+
+    TEST_EXIT();
+}
+
+// Downlink handler of the Host build, the emulator sends no command here.
+astronode_downlink_result_t handle_log_command(const uint8_t *p_data, uint8_t length)
+{
+    (void) p_data;
+    (void) length;
+
+    return ASTRONODE_DOWNLINK_ACCEPTED;
+}
+
+static void acknowledge_payload(uint16_t payload_id)
+{
+    astronode_payload_policy_acknowledge(payload_id);
+    astronode_fragment_acknowledge(payload_id);
+}
+
+static void receive_uplink(void *p_user, uint16_t payload_id, const uint8_t *p_data, uint8_t length)
+{
+    bool is_complete = false;
+
+    (void) p_user;
+    (void) payload_id;
+
+    // The backend side: the fragments are told apart from the alarms by their format byte.
+    if (length > 0 && p_data[0] == ASTRONODE_FRAGMENT_FORMAT
+        && astronode_reassembler_add(&g_reassembler, p_data, length, &is_complete) == RS_SUCCESS)
+    {
+        g_fragment_received_count++;
+        g_is_reassembled |= is_complete;
+    }
+}
+
+static uint16_t build_fragment(uint8_t message_id, const uint8_t *p_record, uint16_t record_length, uint8_t *p_payload)
+{
+    uint16_t crc = astronode_transport_calculate_crc(p_record, record_length);
+
+    p_payload[0] = ASTRONODE_FRAGMENT_FORMAT;
+    p_payload[1] = message_id;
+    p_payload[2] = 0;
+    p_payload[3] = (uint8_t) crc;
+    p_payload[4] = (uint8_t) (crc >> 8);
+    memcpy(&p_payload[ASTRONODE_FRAGMENT_HEADER_LEN_BYTES], p_record, record_length);
+
+    return ASTRONODE_FRAGMENT_HEADER_LEN_BYTES + record_length;
+}
+
+static void test_through_emulator(void)
+{
+    astronode_emulator_config_t config = { .ack_delay_ms = TEST_ACK_DELAY_MS };
+    astronode_ctx_t ctx;
+    uint8_t fragment_count = (TEST_RECORD_LEN_BYTES + ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES - 1) / ASTRONODE_FRAGMENT_DATA_MAX_LEN_BYTES;
+    char p_filler[4] = "abc";
+
+    for (uint16_t i = 0; i < TEST_RECORD_LEN_BYTES; i++)
+    {
+        g_p_record[i] = (uint8_t) (i * 7 + (i >> 3));
+    }
+
+    emulator_link_init(&g_link, &config);
+    astronode_emulator_set_uplink(&g_link.emulator, receive_uplink, NULL);
+    astronode_ctx_init(&ctx, get_emulator_link_uart_ops(), &g_link);
+    astronode_payload_policy_init(&ctx);
+    astronode_event_init(&ctx, acknowledge_payload);
+    astronode_send_res_cr(&ctx);
+    astronode_reassembler_init(&g_reassembler, g_p_reassembled, sizeof(g_p_reassembled));
+
+    // The satellite is held back while the queue is filled: a periodic payload, the
+    // fragments, then two alarms preempting the periodic payload and the first fragment.
+    g_link.emulator.config.ack_delay_ms = UINT32_MAX;
+    TEST_CHECK(astronode_payload_policy_enqueue(TEST_PERIODIC_CLASS, p_filler, sizeof(p_filler)) == RS_SUCCESS);
+    TEST_CHECK(astronode_fragment_send(g_p_record, TEST_RECORD_LEN_BYTES) == RS_SUCCESS);
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == 1 + fragment_count);
+    TEST_CHECK(astronode_fragment_send(g_p_record, TEST_RECORD_LEN_BYTES) == RS_FAILURE);
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH);
+    TEST_CHECK(astronode_payload_policy_enqueue(TEST_ALARM_CLASS, p_filler, sizeof(p_filler)) == RS_FAILURE);
+    TEST_CHECK(astronode_payload_policy_preempt(TEST_ALARM_CLASS) == RS_SUCCESS);
+    TEST_CHECK(astronode_payload_policy_enqueue(TEST_ALARM_CLASS, p_filler, sizeof(p_filler)) == RS_SUCCESS);
+    TEST_CHECK(astronode_payload_policy_preempt(TEST_ALARM_CLASS) == RS_SUCCESS);
+    TEST_CHECK(astronode_payload_policy_enqueue(TEST_ALARM_CLASS, p_filler, sizeof(p_filler)) == RS_SUCCESS);
+
+    // Pass: acknowledgments are processed as the example does and the fragments are
+    // serviced before each pass, which sends the dropped one again.
+    uint32_t start_ms = get_systick();
+
+    g_link.emulator.config.ack_delay_ms = TEST_ACK_DELAY_MS;
+    while (astronode_fragment_is_complete() == false && get_systick() - start_ms < TEST_TIMEOUT_MS)
+    {
+        astronode_emulator_run(&g_link.emulator, get_systick());
+        astronode_event_process();
+        astronode_fragment_service();
+        usleep(1000);
+    }
+
+    TEST_CHECK(astronode_fragment_is_complete());
+    TEST_CHECK(g_is_reassembled);
+    TEST_CHECK(g_fragment_received_count == fragment_count);
+    TEST_CHECK(g_reassembler.length == TEST_RECORD_LEN_BYTES);
+    TEST_CHECK(memcmp(g_p_reassembled, g_p_record, TEST_RECORD_LEN_BYTES) == 0);
+}
+
+static void test_message_id_wrap(void)
+{
+    uint8_t p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint8_t p_late[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint16_t late_length = 0;
+    bool is_complete = false;
+    uint8_t message_id = 200;
+
+    astronode_reassembler_init(&g_reassembler, g_p_reassembled, sizeof(g_p_reassembled));
+
+    // Payloads of another format are not fragments, whatever their first bytes.
+    build_fragment(message_id, g_p_record, 2, p_payload);
+    p_payload[0] = ASTRONODE_UPLINK_FORMAT_TIME_SERIES;
+    TEST_CHECK(astronode_reassembler_add(&g_reassembler, p_payload, ASTRONODE_FRAGMENT_HEADER_LEN_BYTES + 2, &is_complete) == RS_FAILURE);
+
+    // Single fragment records from ID 200 up to 44, across the wrap from 255 to 0.
+    for (uint16_t i = 0; i < 100; i++, message_id++)
+    {
+        uint8_t p_record[2] = { message_id, (uint8_t) i };
+        uint16_t length = build_fragment(message_id, p_record, sizeof(p_record), p_payload);
+
+        TEST_CHECK(astronode_reassembler_add(&g_reassembler, p_payload, length, &is_complete) == RS_SUCCESS);
+        TEST_CHECK(is_complete && g_reassembler.length == sizeof(p_record) && g_p_reassembled[1] == (uint8_t) i);
+
+        if (message_id == 250)
+        {
+            memcpy(p_late, p_payload, length);
+            late_length = length;
+        }
+    }
+
+    // A repeated fragment of the last record and a late one from before the wrap are ignored.
+    TEST_CHECK(astronode_reassembler_add(&g_reassembler, p_payload, build_fragment(message_id - 1, g_p_reassembled, 2, p_payload), &is_complete) == RS_SUCCESS);
+    TEST_CHECK(is_complete == false);
+    TEST_CHECK(astronode_reassembler_add(&g_reassembler, p_late, late_length, &is_complete) == RS_SUCCESS);
+    TEST_CHECK(is_complete == false);
+}
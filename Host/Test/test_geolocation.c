@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_geolocation.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// 1e-7 degree units: a meter of latitude is about 90 units.
+#define TEST_UNITS_PER_M        90
+#define TEST_LATITUDE           465193000
+#define TEST_LONGITUDE          66322000
+#define TEST_MIN_DISTANCE_M     100
+#define TEST_MAX_AGE_MS         50
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void count_geo_wr(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static emulator_link_t g_link;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    astronode_emulator_config_t config = { 0 };
+    astronode_ctx_t ctx;
+    uint32_t geo_wr_count = 0;
+
+    set_debug_logs_enabled(false);
+    emulator_link_init(&g_link, &config);
+    astronode_ctx_init(&ctx, get_emulator_link_uart_ops(), &g_link);
+    astronode_ctx_set_phase_hook(&ctx, count_geo_wr, &geo_wr_count);
+
+    // Positions out of the GEO_WR ranges are rejected without any request.
+    astronode_geolocation_init(&ctx, TEST_MIN_DISTANCE_M, ASTRONODE_GEOLOCATION_NO_MAX_AGE);
+    TEST_CHECK(astronode_geolocation_update(ASTRONODE_GEOLOCATION_LATITUDE_MAX + 1, TEST_LONGITUDE) == RS_FAILURE);
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE, -ASTRONODE_GEOLOCATION_LONGITUDE_MAX - 1) == RS_FAILURE);
+    TEST_CHECK(astronode_geolocation_is_valid(-ASTRONODE_GEOLOCATION_LATITUDE_MAX, ASTRONODE_GEOLOCATION_LONGITUDE_MAX));
+    TEST_CHECK(geo_wr_count == 0);
+
+    // The first position is always written, then only once the asset moved by the threshold.
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 1);
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE + 80 * TEST_UNITS_PER_M, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 1);
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE + 120 * TEST_UNITS_PER_M, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 2);
+
+    // The distance is measured from the last written position, not the last update.
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE + 200 * TEST_UNITS_PER_M, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 2);
+
+    // East-west moves shrink with the latitude: 150 m worth of equator longitude is 75 m at 60 degrees.
+    TEST_CHECK(astronode_geolocation_update(600000000, 0) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 3);
+    TEST_CHECK(astronode_geolocation_is_update_needed(600000000, 150 * TEST_UNITS_PER_M, 0) == false);
+    TEST_CHECK(astronode_geolocation_is_update_needed(600000000, 250 * TEST_UNITS_PER_M, 0));
+
+    // Across the antimeridian the short way around is taken.
+    TEST_CHECK(astronode_geolocation_update(0, ASTRONODE_GEOLOCATION_LONGITUDE_MAX - 20 * TEST_UNITS_PER_M) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 4);
+    TEST_CHECK(astronode_geolocation_is_update_needed(0, -ASTRONODE_GEOLOCATION_LONGITUDE_MAX + 20 * TEST_UNITS_PER_M, 0) == false);
+
+    // A position older than the maximum age is written again even if the asset did not move.
+    astronode_geolocation_init(&ctx, TEST_MIN_DISTANCE_M, TEST_MAX_AGE_MS);
+    geo_wr_count = 0;
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 1);
+    usleep(2 * TEST_MAX_AGE_MS * 1000);
+    TEST_CHECK(astronode_geolocation_update(TEST_LATITUDE, TEST_LONGITUDE) == RS_SUCCESS);
+    TEST_CHECK(geo_wr_count == 2);
+
+    TEST_EXIT();
+}
+
+static void count_geo_wr(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status)
+{
+    uint32_t *p_count = p_user;
+
+    (void) status;
+
+    // Every GEO_WR sent is counted, answered or not.
+    if (op_code == ASTRONODE_OP_CODE_GEO_WR && phase == ASTRONODE_TRANSPORT_PHASE_END)
+    {
+        (*p_count)++;
+    }
+}
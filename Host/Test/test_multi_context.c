@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Astrocast
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_metrics.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TEST_ACK_DELAY_MS       20
+#define TEST_PAYLOAD_COUNT      3
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+// Two Astronodes driven by the same asset, each one behind its own emulator.
+static emulator_link_t g_link_a;
+static emulator_link_t g_link_b;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    astronode_emulator_config_t config_a = { .ack_delay_ms = TEST_ACK_DELAY_MS };
+    astronode_emulator_config_t config_b = { .ack_delay_ms = UINT32_MAX };
+    astronode_ctx_t ctx_a;
+    astronode_ctx_t ctx_b;
+    astronode_module_state_t module_state = { 0 };
+    char p_payload[4] = "abc";
+    uint8_t events = 0;
+    uint16_t payload_id = 0;
+    uint16_t first_payload_id_a = 0;
+
+    set_debug_logs_enabled(false);
+    emulator_link_init(&g_link_a, &config_a);
+    emulator_link_init(&g_link_b, &config_b);
+    astronode_ctx_init(&ctx_a, get_emulator_link_uart_ops(), &g_link_a);
+    astronode_ctx_init(&ctx_b, get_emulator_link_uart_ops(), &g_link_b);
+
+    // Payloads go to the Astronode of their context, with IDs counted per context.
+    first_payload_id_a = ctx_a.payload_id_counter + 1;
+    for (uint8_t i = 0; i < TEST_PAYLOAD_COUNT; i++)
+    {
+        TEST_CHECK(astronode_send_pld_er(&ctx_a, astronode_ctx_allocate_payload_id(&ctx_a), p_payload, sizeof(p_payload)) == RS_SUCCESS);
+    }
+    TEST_CHECK(astronode_send_pld_er(&ctx_b, astronode_ctx_allocate_payload_id(&ctx_b), p_payload, sizeof(p_payload)) == RS_SUCCESS);
+    TEST_CHECK(g_link_a.emulator.queue_count == TEST_PAYLOAD_COUNT);
+    TEST_CHECK(g_link_b.emulator.queue_count == 1);
+    TEST_CHECK(g_link_b.emulator.p_queue[0].id == g_link_a.emulator.p_queue[0].id);
+
+    // The latency is learned per context: only the Astronode that answered gets a shorter timeout.
+    TEST_CHECK(astronode_transport_get_answer_timeout(&ctx_a, ASTRONODE_OP_CODE_MST_RR) == ASTRONODE_ANSWER_TIMEOUT_MS);
+    TEST_CHECK(astronode_send_mst_rr(&ctx_a, &module_state) == RS_SUCCESS);
+    TEST_CHECK(module_state.msg_in_queue == TEST_PAYLOAD_COUNT);
+    TEST_CHECK(astronode_transport_get_answer_timeout(&ctx_a, ASTRONODE_OP_CODE_MST_RR) < ASTRONODE_ANSWER_TIMEOUT_MS);
+    TEST_CHECK(astronode_transport_get_answer_timeout(&ctx_b, ASTRONODE_OP_CODE_MST_RR) == ASTRONODE_ANSWER_TIMEOUT_MS);
+
+    // Only the first Astronode transmits: its acknowledgment is read on its context alone.
+    usleep(2 * TEST_ACK_DELAY_MS * 1000);
+    TEST_CHECK(astronode_send_evt_rr(&ctx_a, &events) == RS_SUCCESS);
+    TEST_CHECK(astronode_send_evt_rr(&ctx_b, &events) == RS_SUCCESS);
+    TEST_CHECK(is_sak_available(&ctx_a));
+    TEST_CHECK(is_sak_available(&ctx_b) == false);
+    TEST_CHECK(astronode_send_sak_rr(&ctx_a, &payload_id) == RS_SUCCESS);
+    TEST_CHECK(payload_id == first_payload_id_a);
+    astronode_send_sak_cr(&ctx_a);
+
+    // Errors stay on their context: a corrupted link fails without touching the other one.
+    g_link_b.emulator.config.crc_error_per_mille = 1000;
+    TEST_CHECK(astronode_send_mst_rr(&ctx_b, &module_state) == RS_FAILURE);
+    TEST_CHECK(astronode_send_mst_rr(&ctx_a, &module_state) == RS_SUCCESS);
+    g_link_b.emulator.config.crc_error_per_mille = 0;
+    TEST_CHECK(astronode_send_mst_rr(&ctx_b, &module_state) == RS_SUCCESS);
+    TEST_CHECK(module_state.msg_in_queue == 1);
+
+    // And so do their metrics.
+    astronode_metrics_snapshot_t snapshot_a;
+    astronode_metrics_snapshot_t snapshot_b;
+
+    astronode_metrics_snapshot(&ctx_a, &snapshot_a, false);
+    astronode_metrics_snapshot(&ctx_b, &snapshot_b, false);
+    TEST_CHECK(snapshot_a.p_failures[ASTRONODE_METRICS_FAILURE_CRC_MISMATCH] == 0);
+    TEST_CHECK(snapshot_b.p_failures[ASTRONODE_METRICS_FAILURE_CRC_MISMATCH] > 0);
+    TEST_CHECK(snapshot_a.p_counters[ASTRONODE_METRICS_COUNTER_TX_BYTES] != snapshot_b.p_counters[ASTRONODE_METRICS_COUNTER_TX_BYTES]);
+
+    TEST_EXIT();
+}
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Astrocast
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_downlink.h"
+#include "astronode_event.h"
+#include "astronode_payload_policy.h"
+#include "astronode_retry.h"
+#include "drivers.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TEST_ALARM_CLASS        0
+#define TEST_LEARNING_COUNT     10
+#define TEST_MAX_REQUESTS       20
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static void fill_queue(astronode_ctx_t *p_ctx);
+static void test_reset_event(void);
+static void test_circuit_reset(void);
+astronode_downlink_result_t handle_log_command(const uint8_t *p_data, uint8_t length);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static emulator_link_t g_link;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    set_debug_logs_enabled(false);
+
+    test_reset_event();
+    test_circuit_reset();
+
+    TEST_EXIT();
+}
+
+// Downlink handler of the Host build, the emulator sends no command here.
+astronode_downlink_result_t handle_log_command(const uint8_t *p_data, uint8_t length)
+{
+    (void) p_data;
+    (void) length;
+
+    return ASTRONODE_DOWNLINK_ACCEPTED;
+}
+
+static void fill_queue(astronode_ctx_t *p_ctx)
+{
+    // The satellite is held back, the queue of the Astronode fills up.
+    astronode_emulator_config_t config = { .ack_delay_ms = UINT32_MAX };
+    char p_payload[4] = "abc";
+
+    emulator_link_init(&g_link, &config);
+    astronode_ctx_init(p_ctx, get_emulator_link_uart_ops(), &g_link);
+    astronode_payload_policy_init(p_ctx);
+    astronode_event_init(p_ctx, astronode_payload_policy_acknowledge);
+    astronode_send_res_cr(p_ctx);
+
+    for (uint8_t i = 0; i < ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH; i++)
+    {
+        TEST_CHECK(astronode_payload_policy_enqueue(TEST_ALARM_CLASS, p_payload, sizeof(p_payload)) == RS_SUCCESS);
+    }
+    TEST_CHECK(astronode_payload_policy_enqueue(TEST_ALARM_CLASS, p_payload, sizeof(p_payload)) == RS_FAILURE);
+    TEST_CHECK(g_link.emulator.queue_count == ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH);
+}
+
+static void test_reset_event(void)
+{
+    astronode_ctx_t ctx;
+    char p_payload[4] = "abc";
+
+    fill_queue(&ctx);
+
+    // The Astronode resets on its own: the reset event empties the image along with the queue.
+    astronode_emulator_reset(&g_link.emulator, get_systick());
+    astronode_event_process();
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == 0);
+    TEST_CHECK(astronode_payload_policy_is_queued(astronode_payload_policy_get_last_payload_id()) == false);
+    TEST_CHECK(astronode_payload_policy_enqueue(TEST_ALARM_CLASS, p_payload, sizeof(p_payload)) == RS_SUCCESS);
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == 1);
+    TEST_CHECK(g_link.emulator.queue_count == 1);
+}
+
+static void test_circuit_reset(void)
+{
+    astronode_ctx_t ctx;
+    astronode_module_state_t module_state = { 0 };
+
+    fill_queue(&ctx);
+
+    // Short timeouts are learned first, then the link goes silent until the circuit
+    // breaker resets the Astronode.
+    for (uint8_t i = 0; i < TEST_LEARNING_COUNT; i++)
+    {
+        TEST_CHECK(astronode_send_mst_rr(&ctx, &module_state) == RS_SUCCESS);
+    }
+    g_link.emulator.config.drop_per_mille = 1000;
+    for (uint8_t i = 0; i < TEST_MAX_REQUESTS && astronode_retry_get_circuit_state(&ctx) != ASTRONODE_CIRCUIT_OPEN; i++)
+    {
+        astronode_send_mst_rr(&ctx, &module_state);
+    }
+
+    TEST_CHECK(astronode_retry_get_circuit_state(&ctx) == ASTRONODE_CIRCUIT_OPEN);
+    TEST_CHECK(g_link.emulator.queue_count == 0);
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == 0);
+}
@@ -0,0 +1,139 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_search_tuner.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+#define TEST_DEFAULT_TRACE_PATH     "Data/search_tuner_trace.csv"
+#define TEST_MAX_TRACE_LENGTH       256
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static uint16_t load_trace(const char *p_path,
+                           astronode_search_tuner_input_t *p_inputs,
+                           astronode_search_tuner_config_t *p_expected_configs);
+static void count_ssc_wr(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static astronode_search_tuner_input_t g_p_inputs[TEST_MAX_TRACE_LENGTH];
+static astronode_search_tuner_config_t g_p_expected_configs[TEST_MAX_TRACE_LENGTH];
+static astronode_search_tuner_config_t g_p_configs[TEST_MAX_TRACE_LENGTH];
+static emulator_link_t g_link;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    const char *p_path = argc > 1 ? argv[1] : TEST_DEFAULT_TRACE_PATH;
+    uint16_t trace_length = load_trace(p_path, g_p_inputs, g_p_expected_configs);
+
+    set_debug_logs_enabled(false);
+    TEST_CHECK(trace_length > 0);
+
+    // The checked-in trace gives the configuration expected after each input.
+    astronode_search_tuner_replay(g_p_inputs, trace_length, g_p_configs);
+    for (uint16_t i = 0; i < trace_length; i++)
+    {
+        if (g_p_configs[i].search_period_enum != g_p_expected_configs[i].search_period_enum
+            || g_p_configs[i].enable_search_without_msg_queued != g_p_expected_configs[i].enable_search_without_msg_queued)
+        {
+            fprintf(stderr, "%s: input %u gives %u,%u instead of %u,%u\n",
+                    p_path, i + 1,
+                    g_p_configs[i].search_period_enum, g_p_configs[i].enable_search_without_msg_queued,
+                    g_p_expected_configs[i].search_period_enum, g_p_expected_configs[i].enable_search_without_msg_queued);
+            g_test_failure_count++;
+        }
+    }
+
+    // A replay leaves the tuner of the running Astronode alone: its context and the
+    // configuration it applied are kept, the same inputs are not written again.
+    astronode_emulator_config_t config = { 0 };
+    astronode_ctx_t ctx;
+    uint32_t ssc_wr_count = 0;
+
+    emulator_link_init(&g_link, &config);
+    astronode_ctx_init(&ctx, get_emulator_link_uart_ops(), &g_link);
+    astronode_ctx_set_phase_hook(&ctx, count_ssc_wr, &ssc_wr_count);
+    astronode_search_tuner_init(&ctx);
+
+    astronode_search_tuner_run(1);
+    TEST_CHECK(ssc_wr_count == 1);
+    astronode_search_tuner_replay(g_p_inputs, trace_length, g_p_configs);
+    astronode_search_tuner_run(1);
+    TEST_CHECK(ssc_wr_count == 1);
+
+    TEST_EXIT();
+}
+
+static uint16_t load_trace(const char *p_path,
+                           astronode_search_tuner_input_t *p_inputs,
+                           astronode_search_tuner_config_t *p_expected_configs)
+{
+    FILE *p_input = fopen(p_path, "r");
+    char p_line[128];
+    uint16_t count = 0;
+
+    if (p_input == NULL)
+    {
+        perror(p_path);
+        return 0;
+    }
+
+    while (count < TEST_MAX_TRACE_LENGTH && fgets(p_line, sizeof(p_line), p_input) != NULL)
+    {
+        unsigned int backlog = 0;
+        unsigned int queue_depth = 0;
+        unsigned int rssi = 0;
+        unsigned long time_to_next_pass_s = 0;
+        unsigned int period = 0;
+        unsigned int is_enabled = 0;
+
+        if (p_line[0] == '#'
+            || sscanf(p_line, "%u,%u,%u,%lu,%u,%u", &backlog, &queue_depth, &rssi, &time_to_next_pass_s, &period, &is_enabled) != 6)
+        {
+            continue;
+        }
+        p_inputs[count].asset_backlog = backlog;
+        p_inputs[count].module_queue_depth = queue_depth;
+        p_inputs[count].last_search_rssi = rssi;
+        p_inputs[count].time_to_next_pass_s = time_to_next_pass_s;
+        p_expected_configs[count].search_period_enum = period;
+        p_expected_configs[count].enable_search_without_msg_queued = is_enabled != 0;
+        count++;
+    }
+
+    fclose(p_input);
+    return count;
+}
+
+static void count_ssc_wr(void *p_user, uint8_t op_code, astronode_transport_phase_t phase, return_status_t status)
+{
+    uint32_t *p_count = p_user;
+
+    if (op_code == ASTRONODE_OP_CODE_SSC_WR && phase == ASTRONODE_TRANSPORT_PHASE_END && status == RS_SUCCESS)
+    {
+        (*p_count)++;
+    }
+}
@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Astrocast
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_payload_policy.h"
+#include "astronode_uplink_queue.h"
+#include "drivers_posix.h"
+#include "emulator_link.h"
+#include "test_check.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// No payload leaves the emulated Astronode queue during the test.
+#define TEST_ACK_DELAY_MS   3600000
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+static return_status_t push(astronode_uplink_priority_t priority, char tag, uint8_t index);
+static bool is_popped(astronode_uplink_priority_t priority, char tag, uint8_t index);
+static void test_priority_order(void);
+static void test_fifo_within_priority(void);
+static void test_full_pool(void);
+static void test_preemption(void);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static emulator_link_t g_link;
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+int main(void)
+{
+    set_debug_logs_enabled(false);
+
+    test_priority_order();
+    test_fifo_within_priority();
+    test_full_pool();
+    test_preemption();
+
+    TEST_EXIT();
+}
+
+static return_status_t push(astronode_uplink_priority_t priority, char tag, uint8_t index)
+{
+    char p_payload[2] = { tag, '0' + index };
+
+    return astronode_uplink_queue_push(priority, p_payload, sizeof(p_payload));
+}
+
+static bool is_popped(astronode_uplink_priority_t priority, char tag, uint8_t index)
+{
+    astronode_uplink_priority_t popped_priority = ASTRONODE_UPLINK_PRIORITY_COUNT;
+    char p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+    uint16_t length = 0;
+
+    return astronode_uplink_queue_pop(&popped_priority, p_payload, &length) == RS_SUCCESS
+           && popped_priority == priority
+           && length == 2
+           && p_payload[0] == tag
+           && p_payload[1] == '0' + index;
+}
+
+static void test_priority_order(void)
+{
+    astronode_uplink_queue_init();
+
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', 0) == RS_SUCCESS);
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_EVENT, 'E', 0) == RS_SUCCESS);
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_ALARM, 'A', 0) == RS_SUCCESS);
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_EVENT, 'E', 1) == RS_SUCCESS);
+    TEST_CHECK(astronode_uplink_queue_get_count() == 4);
+
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_ALARM, 'A', 0));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_EVENT, 'E', 0));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_EVENT, 'E', 1));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', 0));
+    TEST_CHECK(astronode_uplink_queue_get_count() == 0);
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', 0) == false);
+}
+
+static void test_fifo_within_priority(void)
+{
+    astronode_uplink_queue_init();
+
+    // Interleaved pops make the entries go through the free list out of order.
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', i) == RS_SUCCESS);
+    }
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', 0));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', 1));
+    for (uint8_t i = 4; i < 8; i++)
+    {
+        TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', i) == RS_SUCCESS);
+    }
+    for (uint8_t i = 2; i < 8; i++)
+    {
+        TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', i));
+    }
+}
+
+static void test_full_pool(void)
+{
+    astronode_uplink_queue_init();
+
+    for (uint8_t i = 0; i < ASTRONODE_UPLINK_QUEUE_POOL_SIZE; i++)
+    {
+        TEST_CHECK(push(i < 2 ? ASTRONODE_UPLINK_PRIORITY_EVENT : ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'F', i) == RS_SUCCESS);
+    }
+
+    // A periodic payload has no lower priority to discard, an alarm discards the oldest
+    // periodic one.
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'X', 0) == RS_FAILURE);
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_ALARM, 'A', 0) == RS_SUCCESS);
+    TEST_CHECK(astronode_uplink_queue_get_count() == ASTRONODE_UPLINK_QUEUE_POOL_SIZE);
+
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_ALARM, 'A', 0));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_EVENT, 'F', 0));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_EVENT, 'F', 1));
+    TEST_CHECK(is_popped(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'F', 3));
+}
+
+static void test_preemption(void)
+{
+    astronode_emulator_config_t config = { .ack_delay_ms = TEST_ACK_DELAY_MS };
+    astronode_ctx_t ctx;
+
+    emulator_link_init(&g_link, &config);
+    astronode_ctx_init(&ctx, get_emulator_link_uart_ops(), &g_link);
+    astronode_payload_policy_init(&ctx);
+    astronode_uplink_queue_init();
+
+    // The Astronode queue is filled with periodic payloads.
+    for (uint8_t i = 0; i < ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH; i++)
+    {
+        TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', i) == RS_SUCCESS);
+    }
+    astronode_uplink_queue_service();
+    TEST_CHECK(astronode_uplink_queue_get_count() == 0);
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH);
+
+    uint16_t oldest_periodic_id = g_link.emulator.p_queue[0].id;
+
+    // Mixed load: the alarm and the event take the place of the two oldest periodic
+    // payloads, the new periodic payload waits on the asset side.
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_PERIODIC, 'P', 8) == RS_SUCCESS);
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_EVENT, 'E', 0) == RS_SUCCESS);
+    TEST_CHECK(push(ASTRONODE_UPLINK_PRIORITY_ALARM, 'A', 0) == RS_SUCCESS);
+    astronode_uplink_queue_service();
+
+    uint16_t event_id = astronode_payload_policy_get_last_payload_id();
+
+    TEST_CHECK(astronode_uplink_queue_get_count() == 1);
+    TEST_CHECK(astronode_payload_policy_get_queue_count() == ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH);
+    TEST_CHECK(g_link.emulator.queue_count == ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH);
+    TEST_CHECK(astronode_payload_policy_is_queued(oldest_periodic_id) == false);
+    TEST_CHECK(astronode_payload_policy_is_queued(event_id));
+    TEST_CHECK(g_link.emulator.p_queue[g_link.emulator.queue_count - 1].id == event_id);
+
+    // Once the satellite takes a payload, the periodic one follows.
+    astronode_payload_policy_acknowledge(g_link.emulator.p_queue[0].id);
+    g_link.emulator.queue_count--;
+    memmove(&g_link.emulator.p_queue[0], &g_link.emulator.p_queue[1], g_link.emulator.queue_count * sizeof(astronode_emulator_payload_t));
+    astronode_uplink_queue_service();
+    TEST_CHECK(astronode_uplink_queue_get_count() == 0);
+    TEST_CHECK(g_link.emulator.queue_count == ASTRONODE_PAYLOAD_POLICY_MODULE_QUEUE_DEPTH);
+}
@@ -0,0 +1,324 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Astrocast
+#include "stm32l4xx.h"
+#include "astronode_application.h"
+#include "astronode_context.h"
+#include "astronode_definitions.h"
+#include "astronode_emulator.h"
+#include "astronode_transport.h"
+#include "drivers.h"
+
+
+//------------------------------------------------------------------------------
+// Definitions
+//------------------------------------------------------------------------------
+// Clock of the mps2-an386 CPU, also driving SysTick with CLKSOURCE set.
+#ifndef QEMU_SYSCLK_HZ
+#define QEMU_SYSCLK_HZ              25000000
+#endif
+
+// Set to 1 on a board: QEMU does not model the DWT, its cycle counter is not read.
+#ifndef QEMU_BENCHMARK_DWT
+#define QEMU_BENCHMARK_DWT          0
+#endif
+
+#define QEMU_DEFAULT_ITERATIONS     1000
+#define QEMU_SYSTICK_RELOAD         0x00FFFFFF
+#define QEMU_SYSTICK_PERIOD_TICKS   (QEMU_SYSTICK_RELOAD + 1ULL)
+#define QEMU_BENCHMARK_PAYLOAD_ID   1
+
+
+//------------------------------------------------------------------------------
+// Type definitions
+//------------------------------------------------------------------------------
+// Link answering every request with the same answer frame, captured from the emulator,
+// so that only the encoding and the decoding of the library are measured.
+typedef struct qemu_replay_link_t
+{
+    astronode_emulator_t    emulator;
+    uint8_t                 p_answer[ASTRONODE_MAX_LENGTH_RESPONSE];
+    uint16_t                answer_length;
+    uint16_t                answer_index;
+    bool                    is_capturing;
+} qemu_replay_link_t;
+
+typedef struct qemu_kernel_t
+{
+    const char     *p_name;
+    void          (*run)(astronode_ctx_t *p_ctx);
+    bool            is_answer_captured;
+} qemu_kernel_t;
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+void SysTick_Handler(void);
+static uint64_t get_ticks(void);
+static void send_request_to_link(void *p_port, uint8_t *p_data, uint32_t length);
+static bool is_character_received_from_link(void *p_port, uint8_t *p_rx_char);
+static bool is_link_evt_pin_high(void *p_port);
+static void reset_link(void *p_port);
+static void run_crc(astronode_ctx_t *p_ctx);
+static void run_pld_er(astronode_ctx_t *p_ctx);
+static void run_cmd_rr(astronode_ctx_t *p_ctx);
+static void run_per_rr(astronode_ctx_t *p_ctx);
+static void run_end_rr(astronode_ctx_t *p_ctx);
+static void run_evt_rr(astronode_ctx_t *p_ctx);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+static volatile uint32_t g_systick_wrap_count = 0;
+static volatile uint16_t g_crc_sink = 0;
+
+static uint8_t g_p_payload[ASTRONODE_APP_PAYLOAD_MAX_LEN_BYTES];
+static qemu_replay_link_t g_link;
+
+static const astronode_uart_ops_t g_link_uart_ops =
+{
+    .send_request = send_request_to_link,
+    .is_character_received = is_character_received_from_link,
+    .is_evt_pin_high = is_link_evt_pin_high,
+    .reset = reset_link
+};
+
+static const qemu_kernel_t g_p_kernels[] =
+{
+    { "crc_160", run_crc, false },
+    { "pld_er_160", run_pld_er, true },
+    { "cmd_rr_40", run_cmd_rr, true },
+    { "per_rr_tlv", run_per_rr, true },
+    { "end_rr_tlv", run_end_rr, true },
+    { "evt_rr", run_evt_rr, true }
+};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+// Arguments (semihosting command line): -icount shift given to QEMU, iterations.
+int main(int argc, char *argv[])
+{
+    uint32_t icount_shift = argc > 1 ? strtoul(argv[1], NULL, 0) : 0;
+    uint32_t iterations = argc > 2 ? strtoul(argv[2], NULL, 0) : QEMU_DEFAULT_ITERATIONS;
+    astronode_emulator_config_t config = { 0 };
+    astronode_ctx_t ctx;
+
+    SysTick->LOAD = QEMU_SYSTICK_RELOAD;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+#if QEMU_BENCHMARK_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    for (uint16_t i = 0; i < sizeof(g_p_payload); i++)
+    {
+        g_p_payload[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    astronode_emulator_init(&g_link.emulator, &config, get_systick());
+    astronode_emulator_add_command(&g_link.emulator, g_p_payload, ASTRONODE_APP_COMMAND_MAX_LEN_BYTES);
+    astronode_ctx_init(&ctx, &g_link_uart_ops, &g_link);
+
+    // With -icount, each instruction advances the virtual clock by 2^shift ns.
+    printf("Astronode library on Cortex-M4, %" PRIu32 " iterations, -icount shift=%" PRIu32 "\n", iterations, icount_shift);
+    printf("%-12s %12s %12s %12s", "kernel", "ticks", "ns", "instructions");
+#if QEMU_BENCHMARK_DWT
+    printf(" %12s", "cycles");
+#endif
+    printf("\n");
+
+    for (uint8_t i = 0; i < sizeof(g_p_kernels) / sizeof(g_p_kernels[0]); i++)
+    {
+        const qemu_kernel_t *p_kernel = &g_p_kernels[i];
+
+        if (p_kernel->is_answer_captured)
+        {
+            g_link.is_capturing = true;
+            p_kernel->run(&ctx);
+            g_link.is_capturing = false;
+        }
+
+        // One warm-up run, then the timed runs.
+        p_kernel->run(&ctx);
+
+#if QEMU_BENCHMARK_DWT
+        uint32_t start_cycles = DWT->CYCCNT;
+#endif
+        uint64_t start_ticks = get_ticks();
+
+        for (uint32_t j = 0; j < iterations; j++)
+        {
+            p_kernel->run(&ctx);
+        }
+
+        uint64_t ticks = get_ticks() - start_ticks;
+#if QEMU_BENCHMARK_DWT
+        uint32_t cycles = DWT->CYCCNT - start_cycles;
+#endif
+        double ticks_per_run = (double) ticks / iterations;
+        double ns_per_run = ticks_per_run * (1e9 / QEMU_SYSCLK_HZ);
+
+        printf("%-12s %12.1f %12.1f %12.1f", p_kernel->p_name, ticks_per_run, ns_per_run, ns_per_run / (1UL << icount_shift));
+#if QEMU_BENCHMARK_DWT
+        printf(" %12.1f", (double) cycles / iterations);
+#endif
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void SysTick_Handler(void)
+{
+    g_systick_wrap_count++;
+}
+
+void init_drivers(void)
+{
+}
+
+void send_debug_logs(char *p_data)
+{
+    (void) p_data;
+}
+
+uint32_t get_systick(void)
+{
+    return (uint32_t) (get_ticks() / (QEMU_SYSCLK_HZ / 1000));
+}
+
+bool is_systick_timeout_over(uint32_t starting_value, uint16_t duration)
+{
+    return get_systick() - starting_value > duration;
+}
+
+void wait_in_sleep_mode(uint32_t duration)
+{
+    uint32_t starting_value = get_systick();
+
+    // SysTick wraps every 2^24 cycles only, too rarely to wake the core up from WFI in time.
+    while (get_systick() - starting_value < duration)
+    {
+    }
+}
+
+uint32_t get_device_uid(void)
+{
+    // The same backoff on every run.
+    return 0;
+}
+
+static uint64_t get_ticks(void)
+{
+    uint32_t wrap_count = 0;
+    uint32_t value = 0;
+
+    // Read again if SysTick wrapped in between.
+    do
+    {
+        wrap_count = g_systick_wrap_count;
+        value = SysTick->VAL;
+    } while (wrap_count != g_systick_wrap_count);
+
+    return wrap_count * QEMU_SYSTICK_PERIOD_TICKS + (QEMU_SYSTICK_RELOAD - value);
+}
+
+static void send_request_to_link(void *p_port, uint8_t *p_data, uint32_t length)
+{
+    qemu_replay_link_t *p_link = p_port;
+
+    p_link->answer_index = 0;
+    if (p_link->is_capturing == false)
+    {
+        return;
+    }
+
+    astronode_emulator_run(&p_link->emulator, get_systick());
+    for (uint32_t i = 0; i < length; i++)
+    {
+        uint16_t answer_length = astronode_emulator_receive_byte(&p_link->emulator, p_data[i], p_link->p_answer);
+
+        if (answer_length > 0)
+        {
+            p_link->answer_length = answer_length;
+        }
+    }
+}
+
+static bool is_character_received_from_link(void *p_port, uint8_t *p_rx_char)
+{
+    qemu_replay_link_t *p_link = p_port;
+
+    if (p_link->answer_index < p_link->answer_length)
+    {
+        *p_rx_char = p_link->p_answer[p_link->answer_index++];
+        return true;
+    }
+    return false;
+}
+
+static bool is_link_evt_pin_high(void *p_port)
+{
+    qemu_replay_link_t *p_link = p_port;
+
+    return astronode_emulator_is_evt_pin_high(&p_link->emulator);
+}
+
+static void reset_link(void *p_port)
+{
+    qemu_replay_link_t *p_link = p_port;
+
+    astronode_emulator_reset(&p_link->emulator, get_systick());
+}
+
+static void run_crc(astronode_ctx_t *p_ctx)
+{
+    (void) p_ctx;
+    g_crc_sink ^= astronode_transport_calculate_crc(g_p_payload, sizeof(g_p_payload));
+}
+
+static void run_pld_er(astronode_ctx_t *p_ctx)
+{
+    astronode_send_pld_er(p_ctx, QEMU_BENCHMARK_PAYLOAD_ID, (const char *) g_p_payload, sizeof(g_p_payload));
+}
+
+static void run_cmd_rr(astronode_ctx_t *p_ctx)
+{
+    astronode_command_t command;
+
+    astronode_send_cmd_rr(p_ctx, &command);
+}
+
+static void run_per_rr(astronode_ctx_t *p_ctx)
+{
+    astronode_send_per_rr(p_ctx);
+}
+
+static void run_end_rr(astronode_ctx_t *p_ctx)
+{
+    astronode_environment_details_t environment_details;
+
+    astronode_send_end_rr(p_ctx, &environment_details);
+}
+
+static void run_evt_rr(astronode_ctx_t *p_ctx)
+{
+    uint8_t event_bitmask = 0;
+
+    astronode_send_evt_rr(p_ctx, &event_bitmask);
+}
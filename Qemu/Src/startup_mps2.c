@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// Includes
+//------------------------------------------------------------------------------
+// Standard
+#include <stdint.h>
+
+// Astrocast
+#include "stm32l4xx.h"
+
+
+//------------------------------------------------------------------------------
+// Function declarations
+//------------------------------------------------------------------------------
+void Reset_Handler(void);
+void Default_Handler(void);
+void SysTick_Handler(void);
+
+// C runtime of newlib (rdimon.specs): clears the bss, reads the semihosting command
+// line, calls main() and exits QEMU with its return value.
+extern void _start(void);
+
+
+//------------------------------------------------------------------------------
+// Global variable definitions
+//------------------------------------------------------------------------------
+extern uint32_t _estack;
+
+__attribute__((section(".isr_vector"), used))
+static void (* const g_p_vectors[16])(void) =
+{
+    (void (*)(void)) &_estack,
+    Reset_Handler,
+    Default_Handler,    // NMI
+    Default_Handler,    // HardFault
+    Default_Handler,    // MemManage
+    Default_Handler,    // BusFault
+    Default_Handler,    // UsageFault
+    0,
+    0,
+    0,
+    0,
+    Default_Handler,    // SVCall
+    Default_Handler,    // DebugMonitor
+    0,
+    Default_Handler,    // PendSV
+    SysTick_Handler
+};
+
+
+//------------------------------------------------------------------------------
+// Function definitions
+//------------------------------------------------------------------------------
+void Reset_Handler(void)
+{
+    // Full access to the FPU (CP10 and CP11) before any floating point instruction.
+    SCB->CPACR |= (3UL << 20) | (3UL << 22);
+    __DSB();
+    __ISB();
+
+    _start();
+
+    while (1)
+    {
+    }
+}
+
+void Default_Handler(void)
+{
+    while (1)
+    {
+    }
+}